@@ -42,6 +42,7 @@
 #include "db/tags/utils.hh"
 #include "replica/database.hh"
 #include "alternator/rmw_operation.hh"
+#include "alternator/ttl.hh"
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/sleep.hh>
 #include <seastar/coroutine/maybe_yield.hh>
@@ -134,6 +135,46 @@ json::json_return_type make_streamed(rjson::value&& value) {
     return func;
 }
 
+json::json_return_type make_streamed(rjson::chunked_content&& content) {
+    size_t size = 0;
+    for (const auto& chunk : content) {
+        size += chunk.size();
+    }
+    // Streaming has its own overheads, so for small responses it's cheaper
+    // to just concatenate the chunks.
+    if (size < 100'000) {
+        std::string str;
+        str.reserve(size);
+        for (const auto& chunk : content) {
+            str.append(chunk.get(), chunk.size());
+        }
+        return json_string(std::move(str));
+    }
+    auto rs = make_shared<rjson::chunked_content>(std::move(content));
+    std::function<future<>(output_stream<char>&&)> func = [rs](output_stream<char>&& os) mutable -> future<> {
+        // move objects to coroutine frame.
+        auto los = std::move(os);
+        auto lrs = std::move(rs);
+        std::exception_ptr ex;
+        try {
+            // Each chunk is handed over to the output stream, so it is freed
+            // as soon as it's sent.
+            for (auto& chunk : *lrs) {
+                co_await los.write(std::move(chunk));
+            }
+        } catch (...) {
+            ex = std::current_exception();
+            elogger.error("Exception during streaming HTTP response: {}", ex);
+        }
+        co_await los.close();
+        if (ex) {
+            co_await coroutine::return_exception_ptr(std::move(ex));
+        }
+        co_return;
+    };
+    return func;
+}
+
 json_string::json_string(std::string&& value)
     : _value(std::move(value))
 {}
@@ -146,6 +187,7 @@ executor::executor(gms::gossiper& gossiper,
          service::migration_manager& mm,
          db::system_distributed_keyspace& sdks,
          cdc::metadata& cdc_metadata,
+         sharded<expiration_service>& expiration_service,
          smp_service_group ssg,
          utils::updateable_value<uint32_t> default_timeout_in_ms)
     : _gossiper(gossiper),
@@ -153,6 +195,7 @@ executor::executor(gms::gossiper& gossiper,
       _mm(mm),
       _sdks(sdks),
       _cdc_metadata(cdc_metadata),
+      _expiration_service(expiration_service),
       _enforce_authorization(_proxy.data_dictionary().get_config().alternator_enforce_authorization()),
       _ssg(ssg)
 {
@@ -1540,11 +1583,14 @@ class put_or_delete_item {
     // that length can have different meaning depends on the operation but the
     // the calculation of length in bytes to WCU is the same.
     uint64_t _length_in_bytes = 0;
+    // PutItem: the expiration time the item is written with, if TTL is
+    // enabled on the table.
+    std::optional<gc_clock::time_point> _expiration_time;
 public:
     struct delete_item {};
     struct put_item {};
     put_or_delete_item(const rjson::value& key, schema_ptr schema, delete_item);
-    put_or_delete_item(const rjson::value& item, schema_ptr schema, put_item);
+    put_or_delete_item(const rjson::value& item, schema_ptr schema, put_item, attribute_encoding encoding);
     // put_or_delete_item doesn't keep a reference to schema (so it can be
     // moved between shards for LWT) so it needs to be given again to build():
     mutation build(schema_ptr schema, api::timestamp_type ts) const;
@@ -1553,8 +1599,20 @@ class put_or_delete_item {
     uint64_t length_in_bytes() const noexcept {
         return _length_in_bytes;
     }
+    std::optional<gc_clock::time_point> expiration_time() const noexcept {
+        return _expiration_time;
+    }
 };
 
+// Lets the expiration service expire an item on time, if the write gave it
+// an expiration time. The service may not be running, e.g., in tests.
+void executor::note_expiration(const schema& s, const partition_key& pk, std::optional<gc_clock::time_point> expiration) {
+    if (!expiration || !_expiration_service.local_is_initialized()) {
+        return;
+    }
+    _expiration_service.local().note_expiration(s, pk, *expiration);
+}
+
 put_or_delete_item::put_or_delete_item(const rjson::value& key, schema_ptr schema, delete_item)
         : _pk(pk_from_json(key, schema)), _ck(ck_from_json(key, schema)) {
     check_key(key, schema);
@@ -1576,22 +1634,29 @@ static inline const column_definition* find_attribute(const schema& schema, cons
     return cdef;
 }
 
-put_or_delete_item::put_or_delete_item(const rjson::value& item, schema_ptr schema, put_item)
+// Sets, lists, maps and NULL are written in the binary encoding only once
+// all nodes in the cluster can read it.
+static attribute_encoding get_attribute_encoding(const service::storage_proxy& proxy) {
+    return proxy.features().alternator_binary_attributes ? attribute_encoding::binary : attribute_encoding::json;
+}
+
+put_or_delete_item::put_or_delete_item(const rjson::value& item, schema_ptr schema, put_item, attribute_encoding encoding)
         : _pk(pk_from_json(item, schema)), _ck(ck_from_json(item, schema)) {
     _cells = std::vector<cell>();
     _cells->reserve(item.MemberCount());
+    std::optional<std::string> ttl_attribute = find_ttl_attribute(*schema);
     for (auto it = item.MemberBegin(); it != item.MemberEnd(); ++it) {
         bytes column_name = to_bytes(it->name.GetString());
         validate_value(it->value, "PutItem");
+        if (ttl_attribute && rjson::to_string_view(it->name) == *ttl_attribute) {
+            _expiration_time = to_expiration_time(it->value);
+        }
         const column_definition* cdef = find_attribute(*schema, column_name);
         _length_in_bytes += column_name.size();
         if (!cdef) {
-            bytes value = serialize_item(it->value);
-            if (value.size()) {
-                // ScyllaDB uses one extra byte compared to DynamoDB for the bytes length
-                _length_in_bytes += value.size() - 1;
-            }
-            _cells->push_back({std::move(column_name), serialize_item(it->value)});
+            bytes value = serialize_item(it->value, encoding);
+            _length_in_bytes += item_length_in_bytes(it->value, value);
+            _cells->push_back({std::move(column_name), std::move(value)});
         } else if (!cdef->is_primary_key()) {
             // Fixed-type regular column can be used for GSI key
             bytes value = get_key_from_typed_value(it->value, *cdef);
@@ -1952,9 +2017,10 @@ class put_item_operation : public rmw_operation {
     parsed::condition_expression _condition_expression;
     put_item_operation(service::storage_proxy& proxy, rjson::value&& request)
         : rmw_operation(proxy, std::move(request))
-        , _mutation_builder(rjson::get(_request, "Item"), schema(), put_or_delete_item::put_item{}) {
+        , _mutation_builder(rjson::get(_request, "Item"), schema(), put_or_delete_item::put_item{}, get_attribute_encoding(proxy)) {
         _pk = _mutation_builder.pk();
         _ck = _mutation_builder.ck();
+        _expiration_time = _mutation_builder.expiration_time();
         if (_returnvalues != returnvalues::NONE && _returnvalues != returnvalues::ALL_OLD) {
             throw api_error::validation(format("PutItem supports only NONE or ALL_OLD for ReturnValues"));
         }
@@ -2033,9 +2099,11 @@ future<executor::request_return_type> executor::put_item(client_state& client_st
             });
         });
     }
-    co_return co_await op->execute(_proxy, client_state, trace_state, std::move(permit), needs_read_before_write, _stats, _stats.wcu_total[stats::wcu_types::PUT_ITEM]).finally([op, start_time, this] {
+    auto ret = co_await op->execute(_proxy, client_state, trace_state, std::move(permit), needs_read_before_write, _stats, _stats.wcu_total[stats::wcu_types::PUT_ITEM]).finally([op, start_time, this] {
         _stats.api_operations.put_item_latency.mark(std::chrono::steady_clock::now() - start_time);
     });
+    note_expiration(*op->schema(), op->pk(), op->expiration_time());
+    co_return ret;
 }
 
 class delete_item_operation : public rmw_operation {
@@ -2313,7 +2381,7 @@ future<executor::request_return_type> executor::batch_write_item(client_state& c
                 const rjson::value& put_request = r->value;
                 const rjson::value& item = put_request["Item"];
                 mutation_builders.emplace_back(schema, put_or_delete_item(
-                        item, schema, put_or_delete_item::put_item{}));
+                        item, schema, put_or_delete_item::put_item{}, get_attribute_encoding(_proxy)));
                 auto mut_key = std::make_pair(mutation_builders.back().second.pk(), mutation_builders.back().second.ck());
                 if (used_keys.contains(mut_key)) {
                     co_return api_error::validation("Provided list of item keys contains duplicates");
@@ -2341,16 +2409,25 @@ future<executor::request_return_type> executor::batch_write_item(client_state& c
         co_await verify_permission(_enforce_authorization, client_state, b.first, auth::permission::MODIFY);
     }
 
+    std::vector<std::tuple<schema_ptr, partition_key, gc_clock::time_point>> expirations;
+    for (const auto& [schema, b] : mutation_builders) {
+        if (auto expiration = b.expiration_time()) {
+            expirations.emplace_back(schema, b.pk(), *expiration);
+        }
+    }
+
     _stats.api_operations.batch_write_item_batch_total += batch_size;
-    co_return co_await do_batch_write(_proxy, _ssg, std::move(mutation_builders), client_state, trace_state, std::move(permit), _stats).then([start_time, this] () {
-        // FIXME: Issue #5650: If we failed writing some of the updates,
-        // need to return a list of these failed updates in UnprocessedItems
-        // rather than fail the whole write (issue #5650).
-        rjson::value ret = rjson::empty_object();
-        rjson::add(ret, "UnprocessedItems", rjson::empty_object());
-        _stats.api_operations.batch_write_item_latency.mark(std::chrono::steady_clock::now() - start_time);
-        return make_ready_future<executor::request_return_type>(make_jsonable(std::move(ret)));
-    });
+    co_await do_batch_write(_proxy, _ssg, std::move(mutation_builders), client_state, trace_state, std::move(permit), _stats);
+    for (const auto& [schema, pk, expiration] : expirations) {
+        note_expiration(*schema, pk, expiration);
+    }
+    // FIXME: Issue #5650: If we failed writing some of the updates,
+    // need to return a list of these failed updates in UnprocessedItems
+    // rather than fail the whole write (issue #5650).
+    rjson::value ret = rjson::empty_object();
+    rjson::add(ret, "UnprocessedItems", rjson::empty_object());
+    _stats.api_operations.batch_write_item_latency.mark(std::chrono::steady_clock::now() - start_time);
+    co_return make_jsonable(std::move(ret));
 }
 
 static std::string get_item_type_string(const rjson::value& v) {
@@ -2687,11 +2764,11 @@ void executor::describe_single_item(const cql3::selection::selection& selection,
                 }
                 if (include_all_embedded_attributes || !attrs_to_get || attrs_to_get->contains(attr_name)) {
                     bytes value = value_cast<bytes>(entry.second);
-                    if (item_length_in_bytes && value.length()) {
-                        // ScyllaDB uses one extra byte compared to DynamoDB for the bytes length
-                        (*item_length_in_bytes) += value.length() - 1;
-                    }
                     rjson::value v = deserialize_item(value);
+                    if (item_length_in_bytes) {
+                        // Charged for the value, not for how it is stored.
+                        (*item_length_in_bytes) += alternator::item_length_in_bytes(v, value);
+                    }
                     if (attrs_to_get) {
                         auto it = attrs_to_get->find(attr_name);
                         if (it != attrs_to_get->end()) {
@@ -2707,7 +2784,7 @@ void executor::describe_single_item(const cql3::selection::selection& selection,
                     // names are unique so add() makes sense
                     rjson::add_with_string_name(item, attr_name, std::move(v));
                 } else if (item_length_in_bytes) {
-                    (*item_length_in_bytes) += value_cast<bytes>(entry.second).length() - 1;
+                    (*item_length_in_bytes) += alternator::item_length_in_bytes(value_cast<bytes>(entry.second));
                 }
             }
         }
@@ -2818,6 +2895,8 @@ class update_item_operation  : public rmw_operation {
 
     parsed::condition_expression _condition_expression;
 
+    attribute_encoding _attribute_encoding;
+
     update_item_operation(service::storage_proxy& proxy, rjson::value&& request);
     virtual ~update_item_operation() = default;
     virtual std::optional<mutation> apply(std::unique_ptr<rjson::value> previous_item, api::timestamp_type ts) const override;
@@ -2826,6 +2905,7 @@ class update_item_operation  : public rmw_operation {
 
 update_item_operation::update_item_operation(service::storage_proxy& proxy, rjson::value&& update_info)
     : rmw_operation(proxy, std::move(update_info))
+    , _attribute_encoding(get_attribute_encoding(proxy))
 {
     const rjson::value* key = rjson::find(_request, "Key");
     if (!key) {
@@ -3127,6 +3207,7 @@ static bool hierarchy_actions(
 
 std::optional<mutation>
 update_item_operation::apply(std::unique_ptr<rjson::value> previous_item, api::timestamp_type ts) const {
+    _expiration_time = std::nullopt;
     if (!verify_expected(_request, previous_item.get()) ||
         !verify_condition_expression(_condition_expression, previous_item.get())) {
         if (previous_item && _returnvalues_on_condition_check_failure ==
@@ -3143,9 +3224,13 @@ update_item_operation::apply(std::unique_ptr<rjson::value> previous_item, api::t
     auto& row = m.partition().clustered_row(*_schema, _ck);
     attribute_collector attrs_collector;
     bool any_updates = false;
+    std::optional<std::string> ttl_attribute = find_ttl_attribute(*_schema);
     auto do_update = [&] (bytes&& column_name, const rjson::value& json_value,
                           const attribute_path_map_node<parsed::update_expression::action>* h = nullptr) {
         any_updates = true;
+        if (ttl_attribute && to_string_view(column_name) == *ttl_attribute) {
+            _expiration_time = to_expiration_time(json_value);
+        }
         if (_returnvalues == returnvalues::ALL_NEW) {
             rjson::replace_with_string_name(_return_attributes,
                 to_string_view(column_name), rjson::copy(json_value));
@@ -3187,7 +3272,7 @@ update_item_operation::apply(std::unique_ptr<rjson::value> previous_item, api::t
             bytes column_value = get_key_from_typed_value(json_value, *cdef);
             row.cells().apply(*cdef, atomic_cell::make_live(*cdef->type, ts, column_value));
         } else {
-            attrs_collector.put(std::move(column_name), serialize_item(json_value), ts);
+            attrs_collector.put(std::move(column_name), serialize_item(json_value, _attribute_encoding), ts);
         }
     };
     bool any_deletes = false;
@@ -3426,9 +3511,11 @@ future<executor::request_return_type> executor::update_item(client_state& client
             });
         });
     }
-    co_return co_await op->execute(_proxy, client_state, trace_state, std::move(permit), needs_read_before_write, _stats, _stats.wcu_total[stats::wcu_types::UPDATE_ITEM]).finally([op, start_time, this] {
+    auto ret = co_await op->execute(_proxy, client_state, trace_state, std::move(permit), needs_read_before_write, _stats, _stats.wcu_total[stats::wcu_types::UPDATE_ITEM]).finally([op, start_time, this] {
         _stats.api_operations.update_item_latency.mark(std::chrono::steady_clock::now() - start_time);
     });
+    note_expiration(*op->schema(), op->pk(), op->expiration_time());
+    co_return ret;
 }
 
 // Check according to the request's "ConsistentRead" field, which consistency
@@ -3876,7 +3963,11 @@ class describe_items_visitor {
     const filter& _filter;
     typename columns_t::const_iterator _column_it;
     rjson::value _item;
-    rjson::value _items;
+    // Items which passed the filter are printed, comma-separated, into
+    // _items as soon as they are complete, so we never hold a JSON document
+    // of the entire page.
+    rjson::chunked_content_writer _items;
+    size_t _count;
     size_t _scanned_count;
 
 public:
@@ -3886,7 +3977,7 @@ class describe_items_visitor {
             , _filter(filter)
             , _column_it(columns.begin())
             , _item(rjson::empty_object())
-            , _items(rjson::empty_array())
+            , _count(0)
             , _scanned_count(0)
     {
         // _filter.check() may need additional attributes not listed in
@@ -3965,41 +4056,72 @@ class describe_items_visitor {
                 rjson::remove_member(_item, attr);
             }
 
-            rjson::push_back(_items, std::move(_item));
+            // If _attrs_to_get && _attrs_to_get->empty(), the user asked
+            // not to get any attributes (i.e., a Scan or Query with
+            // Select=COUNT), so there is no need to print the items.
+            if (!_attrs_to_get || !_attrs_to_get->empty()) {
+                if (_count) {
+                    _items.write_raw(",");
+                }
+                _items.write(_item);
+            }
+            ++_count;
         }
         _item = rjson::empty_object();
         ++_scanned_count;
     }
 
-    rjson::value get_items() && {
+    rjson::chunked_content_writer get_items() && {
         return std::move(_items);
     }
 
+    size_t get_count() {
+        return _count;
+    }
+
     size_t get_scanned_count() {
         return _scanned_count;
     }
 };
 
-static future<std::tuple<rjson::value, size_t>> describe_items(const cql3::selection::selection& selection, std::unique_ptr<cql3::result_set> result_set, std::optional<attrs_to_get>&& attrs_to_get, filter&& filter) {
+// describe_items() prints the response to a Query or Scan request. The
+// items are printed one by one as they are read from the result set, into
+// a chunked buffer, so neither a JSON document for the whole page nor one
+// contiguous string is ever built. The caller encodes last_evaluated_key
+// (if the result is not the last page) since it needs the paging state.
+static future<std::tuple<rjson::chunked_content, size_t>> describe_items(const cql3::selection::selection& selection, std::unique_ptr<cql3::result_set> result_set, std::optional<attrs_to_get>&& attrs_to_get, filter&& filter, const rjson::value* last_evaluated_key) {
     describe_items_visitor visitor(selection.get_columns(), attrs_to_get, filter);
     co_await result_set->visit_gently(visitor);
     auto scanned_count = visitor.get_scanned_count();
-    rjson::value items = std::move(visitor).get_items();
-    rjson::value items_descr = rjson::empty_object();
-    auto size = items.Size();
-    rjson::add(items_descr, "Count", rjson::value(size));
-    rjson::add(items_descr, "ScannedCount", rjson::value(scanned_count));
+    auto size = visitor.get_count();
+    rjson::chunked_content response;
+    auto add_chunk = [&response] (std::string_view str) {
+        response.emplace_back(str.data(), str.size());
+    };
+    add_chunk(fmt::format("{{\"Count\":{},\"ScannedCount\":{}", size, scanned_count));
     // If attrs_to_get && attrs_to_get->empty(), this means the user asked not
     // to get any attributes (i.e., a Scan or Query with Select=COUNT) and we
     // shouldn't return "Items" at all.
     // TODO: consider optimizing the case of Select=COUNT without a filter.
-    // In that case, we currently build a list of empty items and here drop
-    // it. We could just count the items and not bother with the empty items.
+    // In that case, we currently build empty items just to count them.
     // (However, remember that when we do have a filter, we need the items).
     if (!attrs_to_get || !attrs_to_get->empty()) {
-        rjson::add(items_descr, "Items", std::move(items));
+        add_chunk(",\"Items\":[");
+        for (auto& chunk : std::move(visitor).get_items().finish()) {
+            response.push_back(std::move(chunk));
+        }
+        add_chunk("]");
     }
-    co_return std::tuple<rjson::value, size_t>{std::move(items_descr), size};
+    if (last_evaluated_key) {
+        rjson::chunked_content_writer lek;
+        lek.write_raw(",\"LastEvaluatedKey\":");
+        lek.write(*last_evaluated_key);
+        for (auto& chunk : std::move(lek).finish()) {
+            response.push_back(std::move(chunk));
+        }
+    }
+    add_chunk("}");
+    co_return std::tuple<rjson::chunked_content, size_t>{std::move(response), size};
 }
 
 static rjson::value encode_paging_state(const schema& schema, const service::pager::paging_state& paging_state) {
@@ -4109,19 +4231,18 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
     }
     auto paging_state = rs->get_metadata().paging_state();
     bool has_filter = filter;
-    auto [items, size] = co_await describe_items(*selection, std::move(rs), std::move(attrs_to_get), std::move(filter));
+    std::optional<rjson::value> last_evaluated_key;
     if (paging_state) {
-        rjson::add(items, "LastEvaluatedKey", encode_paging_state(*table_schema, *paging_state));
+        last_evaluated_key = encode_paging_state(*table_schema, *paging_state);
     }
+    auto [response, size] = co_await describe_items(*selection, std::move(rs), std::move(attrs_to_get), std::move(filter),
+            last_evaluated_key ? &*last_evaluated_key : nullptr);
     if (has_filter){
         cql_stats.filtered_rows_read_total += p->stats().rows_read_total;
         // update our "filtered_row_matched_total" for all the rows matched, despited the filter
         cql_stats.filtered_rows_matched_total += size;
     }
-    if (is_big(items)) {
-        co_return executor::request_return_type(make_streamed(std::move(items)));
-    }
-    co_return executor::request_return_type(make_jsonable(std::move(items)));
+    co_return executor::request_return_type(make_streamed(std::move(response)));
 }
 
 static dht::token token_for_segment(int segment, int total_segments) {
@@ -17,6 +17,7 @@
 #include "service/client_state.hh"
 #include "service_permit.hh"
 #include "db/timeout_clock.hh"
+#include "gc_clock.hh"
 
 #include "alternator/error.hh"
 #include "stats.hh"
@@ -58,6 +59,7 @@ class schema_builder;
 namespace alternator {
 
 class rmw_operation;
+class expiration_service;
 
 struct make_jsonable : public json::jsonable {
     rjson::value _value;
@@ -75,6 +77,14 @@ struct make_jsonable : public json::jsonable {
  */
 json::json_return_type make_streamed(rjson::value&&);
 
+/**
+ * Same as above, for JSON text which was already printed into a
+ * chunked_content (see rjson::chunked_content_writer). The chunks are
+ * written to the HTTP output stream one by one. Small responses are
+ * returned as a single string instead.
+ */
+json::json_return_type make_streamed(rjson::chunked_content&&);
+
 struct json_string : public json::jsonable {
     std::string _value;
 public:
@@ -163,6 +173,7 @@ class executor : public peering_sharded_service<executor> {
     service::migration_manager& _mm;
     db::system_distributed_keyspace& _sdks;
     cdc::metadata& _cdc_metadata;
+    sharded<expiration_service>& _expiration_service;
     utils::updateable_value<bool> _enforce_authorization;
     // An smp_service_group to be used for limiting the concurrency when
     // forwarding Alternator request between shards - if necessary for LWT.
@@ -181,6 +192,7 @@ class executor : public peering_sharded_service<executor> {
              service::migration_manager& mm,
              db::system_distributed_keyspace& sdks,
              cdc::metadata& cdc_metadata,
+             sharded<expiration_service>& expiration_service,
              smp_service_group ssg,
              utils::updateable_value<uint32_t> default_timeout_in_ms);
 
@@ -227,6 +239,7 @@ class executor : public peering_sharded_service<executor> {
     friend class rmw_operation;
 
     static void describe_key_schema(rjson::value& parent, const schema&, std::unordered_map<std::string,std::string> * = nullptr);
+    void note_expiration(const schema& s, const partition_key& pk, std::optional<gc_clock::time_point> expiration);
 
 public:
     static void describe_key_schema(rjson::value& parent, const schema& schema, std::unordered_map<std::string,std::string>&);
@@ -14,6 +14,7 @@
 #include "executor.hh"
 #include "tracing/trace_state.hh"
 #include "keys.hh"
+#include "gc_clock.hh"
 
 namespace alternator {
 
@@ -88,6 +89,10 @@ class rmw_operation : public service::cas_request, public enable_shared_from_thi
     // Additionally when _returnvalues_on_condition_check_failure is ALL_OLD
     // then condition check failure will also result in storing values here.
     mutable rjson::value _return_attributes;
+    // The expiration time the operation writes for the item, when the item's
+    // table has TTL enabled. Like _return_attributes, apply() may set it, and
+    // then must set it every time.
+    mutable std::optional<gc_clock::time_point> _expiration_time;
 public:
     // The constructor of a rmw_operation subclass should parse the request
     // and try to discover as many input errors as it can before really
@@ -111,6 +116,8 @@ class rmw_operation : public service::cas_request, public enable_shared_from_thi
     virtual ~rmw_operation() = default;
     schema_ptr schema() const { return _schema; }
     const rjson::value& request() const { return _request; }
+    const partition_key& pk() const { return _pk; }
+    std::optional<gc_clock::time_point> expiration_time() const { return _expiration_time; }
     rjson::value&& move_request() && { return std::move(_request); }
     future<executor::request_return_type> execute(service::storage_proxy& proxy,
             service::client_state& client_state,
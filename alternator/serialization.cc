@@ -14,6 +14,7 @@
 #include "concrete_types.hh"
 #include "cql3/type_json.hh"
 #include "mutation/position_in_partition.hh"
+#include "vint-serialization.hh"
 
 static logging::logger slogger("alternator-serialization");
 
@@ -183,7 +184,124 @@ struct from_json_visitor {
     }
 };
 
-bytes serialize_item(const rjson::value& item) {
+// The binary encoding of attribute values which have no native Scylla type
+// (sets, lists, maps and NULL). Every value is written as a one-byte
+// alternator_type tag followed by a payload:
+//   S, N, B:    vint length, then the string as it appears in the JSON (so
+//               numbers keep their original text and bytes stay base64)
+//   BOOL, NULL: a single byte, 0 or 1
+//   SS, NS, BS: vint element count, then each element as a vint length and
+//               the string
+//   L:          vint element count, then each element as a tagged value
+//   M:          vint member count, then each member as a vint name length,
+//               the name and a tagged value
+// Unlike the JSON text encoding, reading this back does not need to parse
+// anything, and it is usually considerably smaller.
+static void write_vint(bytes_ostream& bo, uint64_t value) {
+    std::array<int8_t, max_vint_length> buf;
+    auto len = unsigned_vint::serialize(value, buf.data());
+    bo.write(bytes_view(buf.data(), len));
+}
+
+static void write_binary_string(bytes_ostream& bo, std::string_view str) {
+    write_vint(bo, str.size());
+    bo.write(bytes_view(reinterpret_cast<const int8_t*>(str.data()), str.size()));
+}
+
+static std::optional<alternator_type> binary_type_from_string(std::string_view type) {
+    static thread_local const std::unordered_map<std::string_view, alternator_type> types = {
+        {"S", alternator_type::S},
+        {"B", alternator_type::B},
+        {"BOOL", alternator_type::BOOL},
+        {"N", alternator_type::N},
+        {"SS", alternator_type::SS},
+        {"NS", alternator_type::NS},
+        {"BS", alternator_type::BS},
+        {"L", alternator_type::L},
+        {"M", alternator_type::M},
+        {"NULL", alternator_type::NULL_VALUE},
+    };
+    auto it = types.find(type);
+    if (it == types.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+// Writes the tagged binary encoding of a JSON-encoded value (e.g.,
+// {"L": [...]}) to bo. Returns false, leaving bo in an unspecified state,
+// if the value is not in a shape the binary encoding can represent. The
+// caller then falls back to storing the JSON text.
+static bool write_binary_value(bytes_ostream& bo, const rjson::value& v) {
+    if (!v.IsObject() || v.MemberCount() != 1) {
+        return false;
+    }
+    auto it = v.MemberBegin();
+    auto atype = binary_type_from_string(rjson::to_string_view(it->name));
+    if (!atype) {
+        return false;
+    }
+    const rjson::value& content = it->value;
+    bo.write(bytes{int8_t(*atype)});
+    switch (*atype) {
+    case alternator_type::S:
+    case alternator_type::B:
+    case alternator_type::N:
+        if (!content.IsString()) {
+            return false;
+        }
+        write_binary_string(bo, rjson::to_string_view(content));
+        return true;
+    case alternator_type::BOOL:
+    case alternator_type::NULL_VALUE:
+        if (!content.IsBool()) {
+            return false;
+        }
+        bo.write(bytes{int8_t(content.GetBool())});
+        return true;
+    case alternator_type::SS:
+    case alternator_type::NS:
+    case alternator_type::BS:
+        if (!content.IsArray()) {
+            return false;
+        }
+        write_vint(bo, content.Size());
+        for (const auto& element : content.GetArray()) {
+            if (!element.IsString()) {
+                return false;
+            }
+            write_binary_string(bo, rjson::to_string_view(element));
+        }
+        return true;
+    case alternator_type::L:
+        if (!content.IsArray()) {
+            return false;
+        }
+        write_vint(bo, content.Size());
+        for (const auto& element : content.GetArray()) {
+            if (!write_binary_value(bo, element)) {
+                return false;
+            }
+        }
+        return true;
+    case alternator_type::M:
+        if (!content.IsObject()) {
+            return false;
+        }
+        write_vint(bo, content.MemberCount());
+        for (auto member = content.MemberBegin(); member != content.MemberEnd(); ++member) {
+            write_binary_string(bo, rjson::to_string_view(member->name));
+            if (!write_binary_value(bo, member->value)) {
+                return false;
+            }
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+bytes serialize_item(const rjson::value& item, attribute_encoding encoding) {
     if (item.IsNull() || item.MemberCount() != 1) {
         throw api_error::validation(format("An item can contain only one attribute definition: {}", item));
     }
@@ -191,6 +309,12 @@ bytes serialize_item(const rjson::value& item) {
     type_info type_info = type_info_from_string(rjson::to_string_view(it->name)); // JSON keys are guaranteed to be strings
 
     if (type_info.atype == alternator_type::NOT_SUPPORTED_YET) {
+        if (encoding == attribute_encoding::binary) {
+            bytes_ostream bo;
+            if (write_binary_value(bo, item)) {
+                return bytes(bo.linearize());
+            }
+        }
         slogger.trace("Non-optimal serialization of type {}", it->name);
         return bytes{int8_t(type_info.atype)} + to_bytes(rjson::print(item));
     }
@@ -202,6 +326,87 @@ bytes serialize_item(const rjson::value& item) {
     return bytes(bo.linearize());
 }
 
+// The logical length of a JSON-encoded value (e.g., {"L": [...]}): strings
+// and numbers count their text, bytes their decoded length, BOOL and NULL
+// one byte. Like in DynamoDB, lists and maps add three bytes plus one byte
+// per element, and map members also count their name.
+static uint64_t value_length_in_bytes(const rjson::value& v) {
+    if (!v.IsObject() || v.MemberCount() != 1) {
+        return rjson::print(v).size();
+    }
+    auto it = v.MemberBegin();
+    auto atype = binary_type_from_string(rjson::to_string_view(it->name));
+    const rjson::value& content = it->value;
+    if (!atype) {
+        return rjson::print(v).size();
+    }
+    uint64_t length = 0;
+    switch (*atype) {
+    case alternator_type::S:
+    case alternator_type::N:
+        return content.IsString() ? content.GetStringLength() : 0;
+    case alternator_type::B:
+        return content.IsString() ? base64_decoded_len(rjson::to_string_view(content)) : 0;
+    case alternator_type::BOOL:
+    case alternator_type::NULL_VALUE:
+        return 1;
+    case alternator_type::SS:
+    case alternator_type::NS:
+    case alternator_type::BS:
+        if (content.IsArray()) {
+            for (const auto& element : content.GetArray()) {
+                if (element.IsString()) {
+                    length += *atype == alternator_type::BS
+                            ? base64_decoded_len(rjson::to_string_view(element))
+                            : element.GetStringLength();
+                }
+            }
+        }
+        return length;
+    case alternator_type::L:
+        length = 3;
+        if (content.IsArray()) {
+            for (const auto& element : content.GetArray()) {
+                length += 1 + value_length_in_bytes(element);
+            }
+        }
+        return length;
+    case alternator_type::M:
+        length = 3;
+        if (content.IsObject()) {
+            for (auto member = content.MemberBegin(); member != content.MemberEnd(); ++member) {
+                length += 1 + member->name.GetStringLength() + value_length_in_bytes(member->value);
+            }
+        }
+        return length;
+    default:
+        return 0;
+    }
+}
+
+uint64_t item_length_in_bytes(const rjson::value& item, bytes_view serialized) {
+    if (serialized.empty()) {
+        return 0;
+    }
+    if (alternator_type(serialized[0]) < alternator_type::NOT_SUPPORTED_YET) {
+        // ScyllaDB uses one extra byte compared to DynamoDB for the type
+        return serialized.size() - 1;
+    }
+    // Values without a native type are counted the same way whichever
+    // encoding they are stored in.
+    return value_length_in_bytes(item);
+}
+
+uint64_t item_length_in_bytes(bytes_view serialized) {
+    if (serialized.empty()) {
+        return 0;
+    }
+    if (alternator_type(serialized[0]) < alternator_type::NOT_SUPPORTED_YET) {
+        return serialized.size() - 1;
+    }
+    return value_length_in_bytes(deserialize_item(serialized));
+}
+
 struct to_json_visitor {
     rjson::value& deserialized;
     const std::string& type_ident;
@@ -226,6 +431,89 @@ struct to_json_visitor {
     }
 };
 
+static void check_binary_value_size(bytes_view bv, size_t size) {
+    if (bv.size() < size) {
+        throw std::runtime_error(format("Malformed serialized value: expected {} more bytes, only {} left", size, bv.size()));
+    }
+}
+
+static uint64_t read_vint(bytes_view& bv) {
+    check_binary_value_size(bv, 1);
+    auto len = unsigned_vint::serialized_size_from_first_byte(bv[0]);
+    check_binary_value_size(bv, len);
+    auto value = unsigned_vint::deserialize(bv);
+    bv.remove_prefix(len);
+    return value;
+}
+
+static std::string_view read_binary_string(bytes_view& bv) {
+    auto len = read_vint(bv);
+    check_binary_value_size(bv, len);
+    std::string_view ret(reinterpret_cast<const char*>(bv.data()), len);
+    bv.remove_prefix(len);
+    return ret;
+}
+
+// Reads one tagged value written by write_binary_value() from the front of
+// bv, and advances bv past it.
+static rjson::value read_binary_value(bytes_view& bv) {
+    check_binary_value_size(bv, 1);
+    alternator_type atype = alternator_type(bv[0]);
+    bv.remove_prefix(1);
+    rjson::value content;
+    std::string_view type_ident;
+    switch (atype) {
+    case alternator_type::S:
+    case alternator_type::B:
+    case alternator_type::N:
+        type_ident = atype == alternator_type::S ? "S" : atype == alternator_type::B ? "B" : "N";
+        content = rjson::from_string(read_binary_string(bv));
+        break;
+    case alternator_type::BOOL:
+    case alternator_type::NULL_VALUE:
+        type_ident = atype == alternator_type::BOOL ? "BOOL" : "NULL";
+        check_binary_value_size(bv, 1);
+        content = rjson::value(bool(bv[0]));
+        bv.remove_prefix(1);
+        break;
+    case alternator_type::SS:
+    case alternator_type::NS:
+    case alternator_type::BS: {
+        type_ident = atype == alternator_type::SS ? "SS" : atype == alternator_type::NS ? "NS" : "BS";
+        content = rjson::empty_array();
+        auto count = read_vint(bv);
+        for (uint64_t i = 0; i < count; ++i) {
+            rjson::push_back(content, rjson::from_string(read_binary_string(bv)));
+        }
+        break;
+    }
+    case alternator_type::L: {
+        type_ident = "L";
+        content = rjson::empty_array();
+        auto count = read_vint(bv);
+        for (uint64_t i = 0; i < count; ++i) {
+            rjson::push_back(content, read_binary_value(bv));
+        }
+        break;
+    }
+    case alternator_type::M: {
+        type_ident = "M";
+        content = rjson::empty_object();
+        auto count = read_vint(bv);
+        for (uint64_t i = 0; i < count; ++i) {
+            auto name = read_binary_string(bv);
+            rjson::add_with_string_name(content, name, read_binary_value(bv));
+        }
+        break;
+    }
+    default:
+        throw std::runtime_error(format("Unknown alternator type {} in serialized value", int8_t(atype)));
+    }
+    rjson::value ret = rjson::empty_object();
+    rjson::add_with_string_name(ret, type_ident, std::move(content));
+    return ret;
+}
+
 rjson::value deserialize_item(bytes_view bv) {
     rjson::value deserialized(rapidjson::kObjectType);
     if (bv.empty()) {
@@ -239,6 +527,15 @@ rjson::value deserialize_item(bytes_view bv) {
         slogger.trace("Non-optimal deserialization of alternator type {}", int8_t(atype));
         return rjson::parse(std::string_view(reinterpret_cast<const char *>(bv.data()), bv.size()));
     }
+    if (atype > alternator_type::NOT_SUPPORTED_YET) {
+        // Put the tag back, read_binary_value() expects a tagged value.
+        bytes_view tagged(bv.data() - 1, bv.size() + 1);
+        rjson::value ret = read_binary_value(tagged);
+        if (!tagged.empty()) {
+            throw std::runtime_error(format("Malformed serialized value of alternator type {}: {} trailing bytes", int8_t(atype), tagged.size()));
+        }
+        return ret;
+    }
     type_representation type_representation = represent_type(atype);
     visit(*type_representation.dtype, to_json_visitor{deserialized, type_representation.ident, bv});
 
@@ -22,7 +22,12 @@ class position_in_partition;
 namespace alternator {
 
 enum class alternator_type : int8_t {
-    S, B, BOOL, N, NOT_SUPPORTED_YET
+    S, B, BOOL, N, NOT_SUPPORTED_YET,
+    // Types which do not have a native Scylla representation. They are
+    // stored in a compact binary encoding (see serialize_item()), values
+    // written before this encoding existed use NOT_SUPPORTED_YET with
+    // the JSON text of the value.
+    SS, NS, BS, L, M, NULL_VALUE
 };
 
 struct type_info {
@@ -41,9 +46,25 @@ inline constexpr std::string_view scylla_paging_weight(":scylla:paging:weight");
 type_info type_info_from_string(std::string_view type);
 type_representation represent_type(alternator_type atype);
 
-bytes serialize_item(const rjson::value& item);
+// How serialize_item() stores sets, lists, maps and NULL: as JSON text, or
+// in the binary encoding. The binary encoding can only be used once all
+// nodes in the cluster can read it, that is once the ALTERNATOR_BINARY_ATTRIBUTES
+// cluster feature is enabled. deserialize_item() understands both.
+enum class attribute_encoding {
+    json,
+    binary,
+};
+
+bytes serialize_item(const rjson::value& item, attribute_encoding encoding);
 rjson::value deserialize_item(bytes_view bv);
 
+// The length of an attribute value, as counted for write capacity units,
+// given the value and what serialize_item() returned for it. It does not
+// depend on the attribute_encoding the value was serialized with.
+uint64_t item_length_in_bytes(const rjson::value& item, bytes_view serialized);
+// The same, given only what serialize_item() returned.
+uint64_t item_length_in_bytes(bytes_view serialized);
+
 std::string type_to_string(data_type type);
 
 bytes get_key_column_value(const rjson::value& item, const column_definition& column);
@@ -6,15 +6,18 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <exception>
 #include <optional>
+#include <unordered_set>
 #include <seastar/core/sstring.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/sleep.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/lowres_clock.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 #include <boost/multiprecision/cpp_int.hpp>
 
@@ -46,6 +49,7 @@
 #include "alternator/executor.hh"
 #include "alternator/controller.hh"
 #include "alternator/serialization.hh"
+#include "dht/i_partitioner.hh"
 #include "dht/sharder.hh"
 #include "db/config.hh"
 #include "db/tags/utils.hh"
@@ -174,11 +178,34 @@ future<executor::request_return_type> executor::describe_time_to_live(client_sta
 // like user deletions, will also appear on the CDC log and therefore
 // Alternator Streams if enabled - currently as ordinary deletes (the
 // userIdentity flag is currently missing this is issue #11523).
+static std::chrono::milliseconds scan_period(const db::config& cfg) {
+    return std::chrono::milliseconds(long(cfg.alternator_ttl_period_in_seconds() * 1000));
+}
+
+static std::chrono::milliseconds full_scan_period(const db::config& cfg) {
+    auto full_scan_period_in_seconds = cfg.alternator_ttl_full_scan_period_in_seconds();
+    if (full_scan_period_in_seconds <= 0) {
+        // By default, every seventh pass does a full scan.
+        return scan_period(cfg) * 7;
+    }
+    return std::chrono::milliseconds(long(full_scan_period_in_seconds * 1000));
+}
+
+// Items expiring before the next full scan of their table are indexed, so
+// that they can be expired within one period of their expiration time.
+// Items expiring later will be indexed by that full scan.
+static gc_clock::duration index_horizon(const db::config& cfg) {
+    auto period = scan_period(cfg);
+    return std::chrono::duration_cast<gc_clock::duration>(std::max(full_scan_period(cfg), period) + period);
+}
+
 expiration_service::expiration_service(data_dictionary::database db, service::storage_proxy& proxy, gms::gossiper& g)
         : _db(db)
         , _proxy(proxy)
         , _gossiper(g)
 {
+    // Items may be written before the first pass.
+    _index.set_horizon(index_horizon(_db.get_config()));
 }
 
 // Convert the big_decimal used to represent expiration time to an integer.
@@ -229,17 +256,93 @@ static bool is_expired(gc_clock::time_point expiration_time, gc_clock::time_poin
            expiration_time > now - std::chrono::years(5);
 }
 
-static bool is_expired(const big_decimal& expiration_time, gc_clock::time_point now) {
+static gc_clock::time_point to_expiration_time(const big_decimal& expiration_time) {
     unsigned long t = bigdecimal_to_ul(expiration_time);
     // We assume - and the assumption turns out to be correct - that the
     // epoch of gc_clock::time_point and the one used by the DynamoDB protocol
     // are the same (the UNIX epoch in UTC). The resolution (seconds) is also
     // the same.
-    return is_expired(gc_clock::time_point(gc_clock::duration(std::chrono::seconds(t))), now);
+    return gc_clock::time_point(gc_clock::duration(std::chrono::seconds(t)));
 }
-static bool is_expired(const rjson::value& expiration_time, gc_clock::time_point now) {
+std::optional<gc_clock::time_point> to_expiration_time(const rjson::value& expiration_time) {
     std::optional<big_decimal> n = try_unwrap_number(expiration_time);
-    return n && is_expired(*n, now);
+    if (!n) {
+        return std::nullopt;
+    }
+    return to_expiration_time(*n);
+}
+
+bool expiration_index::add(gc_clock::time_point expiration, table_id table, const partition_key& pk) {
+    auto now = gc_clock::now();
+    // Expiration times more than 5 years in the past are ignored (see
+    // is_expired()), so such items will never be due.
+    if (expiration > now + _horizon || expiration <= now - std::chrono::years(5)) {
+        return false;
+    }
+    if (_entries.size() >= _max_entries) {
+        // Keep the entries which are due first. The dropped ones will be
+        // found by the next full scan of their table.
+        auto last = std::prev(_entries.end());
+        if (!(expiration < last->expiration)) {
+            return false;
+        }
+        _entries.erase(last);
+    }
+    _entries.insert(entry{expiration, table, to_bytes(pk.representation())});
+    return true;
+}
+
+std::vector<expiration_index::entry> expiration_index::pop_due(gc_clock::time_point now) {
+    std::vector<entry> ret;
+    auto it = _entries.begin();
+    while (it != _entries.end() && it->expiration <= now) {
+        ret.push_back(std::move(_entries.extract(it++).value()));
+    }
+    return ret;
+}
+
+std::optional<std::string> find_ttl_attribute(const schema& s) {
+    return db::find_tag(s, TTL_TAG_KEY);
+}
+
+void expiration_service::note_expiration(const schema& s, const partition_key& pk, gc_clock::time_point expiration) {
+    if (!_end || shutting_down() || _notes_gate.is_closed()) {
+        return;
+    }
+    // Only the primary replica of an item expires it, on the shard owning
+    // its token (see scan_table()), so that is where it is indexed. Items
+    // of other nodes are left to their full scans.
+    auto erm = s.table().get_effective_replication_map();
+    auto token = dht::get_token(s, pk);
+    auto replicas = erm->get_natural_endpoints(token);
+    if (replicas.empty() || replicas.front() != erm->get_topology().my_address()) {
+        return;
+    }
+    // The write doesn't wait for the item to be indexed on another shard.
+    (void)with_gate(_notes_gate, [this, shard = erm->shard_for_reads(s, token), expiration, table = s.id(), pk] {
+        return container().invoke_on(shard, [expiration, table, pk] (expiration_service& es) {
+            if (!es.shutting_down() && es._index.add(expiration, table, pk)) {
+                es._expiration_stats.items_indexed++;
+            }
+        });
+    }).handle_exception([] (std::exception_ptr ep) {
+        tlogger.warn("Failed to index an expiring item: {}", ep);
+    });
+}
+
+// Get the partition key of a row read with selection::wildcard, in which
+// the partition key columns come first. Returns nothing if any of them is
+// missing, which shouldn't happen.
+static std::optional<partition_key> row_partition_key(const schema& schema, const std::vector<managed_bytes_opt>& row) {
+    std::vector<bytes> exploded_pk;
+    for (unsigned c = 0; c < schema.partition_key_size(); ++c) {
+        const auto& row_c = row[c];
+        if (!row_c) {
+            return std::nullopt;
+        }
+        exploded_pk.push_back(to_bytes(*row_c));
+    }
+    return partition_key::from_exploded(exploded_pk);
 }
 
 // expire_item() expires an item - i.e., deletes it as appropriate for
@@ -255,21 +358,16 @@ static future<> expire_item(service::storage_proxy& proxy,
     // is used, which indicates that columns appear in the order defined by
     // schema::all_columns_in_select_order() - partition key columns goes first,
     // immediately followed by clustering key columns
-    std::vector<bytes> exploded_pk;
     const unsigned pk_size = schema->partition_key_size();
     const unsigned ck_size = schema->clustering_key_size();
-    for (unsigned c = 0; c < pk_size; ++c) {
-        const auto& row_c = row[c];
-        if (!row_c) {
-            // This shouldn't happen - all key columns must have values.
-            // But if it ever happens, let's just *not* expire the item.
-            // FIXME: log or increment a metric if this happens.
-            return make_ready_future<>();
-        }
-        exploded_pk.push_back(to_bytes(*row_c));
+    auto pk = row_partition_key(*schema, row);
+    if (!pk) {
+        // This shouldn't happen - all key columns must have values.
+        // But if it ever happens, let's just *not* expire the item.
+        // FIXME: log or increment a metric if this happens.
+        return make_ready_future<>();
     }
-    auto pk = partition_key::from_exploded(exploded_pk);
-    mutation m(schema, pk);
+    mutation m(schema, std::move(*pk));
     // If there's no clustering key, a tombstone should be created directly
     // on a partition, not on a clustering row - otherwise it will look like
     // an open-ended range tombstone, which will crash on KA/LA sstable format.
@@ -545,7 +643,8 @@ struct scan_ranges_context {
 };
 
 // Scan data in a list of token ranges in one table, looking for expired
-// items and deleting them.
+// items and deleting them. Items which didn't expire yet are added to the
+// given index - which will only keep those expiring soon.
 // Because of issue #9167, partition_ranges must have a single partition
 // range for this code to work correctly.
 static future<> scan_table_ranges(
@@ -554,7 +653,8 @@ static future<> scan_table_ranges(
         dht::partition_range_vector&& partition_ranges,
         abort_source& abort_source,
         named_semaphore& page_sem,
-        expiration_service::stats& expiration_stats)
+        expiration_service::stats& expiration_stats,
+        expiration_index& index)
 {
     const schema_ptr& s = scan_ctx.s;
     SCYLLA_ASSERT (partition_ranges.size() == 1); // otherwise issue #9167 will cause incorrect results.
@@ -612,7 +712,7 @@ static future<> scan_table_ranges(
                 continue;
             }
             auto v = meta[*expiration_column]->type->deserialize(*cell);
-            bool expired = false;
+            std::optional<gc_clock::time_point> expiration;
             // FIXME: don't recalculate "now" all the time
             auto now = gc_clock::now();
             if (scan_ctx.member) {
@@ -628,7 +728,7 @@ static future<> scan_table_ranges(
                     if (value_cast<sstring>(entry.first) == *scan_ctx.member) {
                         bytes value = value_cast<bytes>(entry.second);
                         rjson::value json = deserialize_item(value);
-                        expired = is_expired(json, now);
+                        expiration = to_expiration_time(json);
                         break;
                     }
                 }
@@ -640,9 +740,17 @@ static future<> scan_table_ranges(
                 // supported as well to make this feature more useful in CQL.
                 // Note that kind::decimal is also checked above.
                 big_decimal n = value_cast<big_decimal>(v);
-                expired = is_expired(n, now);
+                expiration = to_expiration_time(n);
             }
-            if (expired) {
+            if (!expiration) {
+                continue;
+            }
+            if (!is_expired(*expiration, now)) {
+                auto pk = row_partition_key(*s, row);
+                if (pk && index.add(*expiration, s->id(), *pk)) {
+                    expiration_stats.items_indexed++;
+                }
+            } else {
                 expiration_stats.items_deleted++;
                 // FIXME: maybe don't recalculate new_timestamp() all the time
                 // FIXME: if expire_item() throws on timeout, we need to retry it.
@@ -655,40 +763,19 @@ static future<> scan_table_ranges(
     }
 }
 
-// scan_table() scans, in one table, data "owned" by this shard, looking for
-// expired items and deleting them.
-// We consider each node to "own" its primary token ranges, i.e., the tokens
-// that this node is their first replica in the ring. Inside the node, each
-// shard "owns" subranges of the node's token ranges - according to the node's
-// sharding algorithm.
-// When a node goes down, the token ranges owned by it will not be scanned
-// and items in those token ranges will not expire, so in the future (FIXME)
-// this function should additionally work on token ranges whose primary owner
-// is down and this node is the range's secondary owner.
-// If the TTL (expiration-time scanning) feature is not enabled for this
-// table, scan_table() returns false without doing anything. Remember that the
-// TTL feature may be enabled later so this function will need to be called
-// again when the feature is enabled.
-// Currently this function scans the entire table (or, rather the parts owned
-// by this shard) at full rate, once. In the future (FIXME) we should consider
-// how to pace this scan, how and when to repeat it, how to interleave or
-// parallelize scanning of multiple tables, and how to continue scans after a
-// reboot.
-static future<bool> scan_table(
-    service::storage_proxy& proxy,
-    data_dictionary::database db,
-    gms::gossiper& gossiper,
-    schema_ptr s,
-    abort_source& abort_source,
-    named_semaphore& page_sem,
-    expiration_service::stats& expiration_stats)
-{
-    // Check if an expiration-time attribute is enabled for this table.
-    // If not, just return false immediately.
-    // FIXME: the setting of the TTL may change in the middle of a long scan!
-    std::optional<std::string> attribute_name = db::find_tag(*s, TTL_TAG_KEY);
+struct expiration_column {
+    bytes column_name;
+    // If set, the expiration time is this member of the column, which is
+    // Alternator's attrs map.
+    std::optional<std::string> member;
+};
+
+// Find the column holding the table's expiration time. Returns nothing if
+// TTL isn't enabled for this table, or if nothing in it can expire.
+static std::optional<expiration_column> find_expiration_column(const schema& s) {
+    std::optional<std::string> attribute_name = find_ttl_attribute(s);
     if (!attribute_name) {
-        co_return false;
+        return std::nullopt;
     }
     // attribute_name may be one of the schema's columns (in Alternator, this
     // means it's a key column), or an element in Alternator's attrs map
@@ -702,19 +789,19 @@ static future<bool> scan_table(
     // numeric, it can be used directly. If it is a "bytes" type, it needs to
     // be deserialized using Alternator's deserializer.
     bytes column_name = to_bytes(*attribute_name);
-    const column_definition *cd = s->get_column_definition(column_name);
+    const column_definition *cd = s.get_column_definition(column_name);
     std::optional<std::string> member;
     if (!cd) {
         member = std::move(attribute_name);
         column_name = bytes(executor::ATTRS_COLUMN_NAME);
-        cd = s->get_column_definition(column_name);
-        tlogger.info("table {} TTL enabled with attribute {} in {}", s->cf_name(), *member, executor::ATTRS_COLUMN_NAME);
+        cd = s.get_column_definition(column_name);
+        tlogger.info("table {} TTL enabled with attribute {} in {}", s.cf_name(), *member, executor::ATTRS_COLUMN_NAME);
     } else {
-        tlogger.info("table {} TTL enabled with attribute {}", s->cf_name(), *attribute_name);
+        tlogger.info("table {} TTL enabled with attribute {}", s.cf_name(), *attribute_name);
     }
     if (!cd) {
-        tlogger.info("table {} TTL column is missing, not scanning", s->cf_name());
-        co_return false;
+        tlogger.info("table {} TTL column is missing, not scanning", s.cf_name());
+        return std::nullopt;
     }
     data_type column_type = cd->type;
     // Verify that the column has the right type: If "member" exists
@@ -724,12 +811,51 @@ static future<bool> scan_table(
     // scan it.
     if ((member && column_type->get_kind() != abstract_type::kind::map) ||
         (!member && column_type->get_kind() != abstract_type::kind::decimal)) {
-        tlogger.info("table {} TTL column has unsupported type, not scanning", s->cf_name());
+        tlogger.info("table {} TTL column has unsupported type, not scanning", s.cf_name());
+        return std::nullopt;
+    }
+    return expiration_column{std::move(column_name), std::move(member)};
+}
+
+// scan_table() scans, in one table, data "owned" by this shard, looking for
+// expired items and deleting them.
+// We consider each node to "own" its primary token ranges, i.e., the tokens
+// that this node is their first replica in the ring. Inside the node, each
+// shard "owns" subranges of the node's token ranges - according to the node's
+// sharding algorithm.
+// When a node goes down, the token ranges owned by it will not be scanned
+// and items in those token ranges will not expire, so in the future (FIXME)
+// this function should additionally work on token ranges whose primary owner
+// is down and this node is the range's secondary owner.
+// If the TTL (expiration-time scanning) feature is not enabled for this
+// table, scan_table() returns false without doing anything. Remember that the
+// TTL feature may be enabled later so this function will need to be called
+// again when the feature is enabled.
+// Currently this function scans the entire table (or, rather the parts owned
+// by this shard) at full rate, once. In the future (FIXME) we should consider
+// how to pace this scan, how and when to repeat it, how to interleave or
+// parallelize scanning of multiple tables, and how to continue scans after a
+// reboot.
+static future<bool> scan_table(
+    service::storage_proxy& proxy,
+    data_dictionary::database db,
+    gms::gossiper& gossiper,
+    schema_ptr s,
+    abort_source& abort_source,
+    named_semaphore& page_sem,
+    expiration_service::stats& expiration_stats,
+    expiration_index& index)
+{
+    // Check if an expiration-time attribute is enabled for this table.
+    // If not, just return false immediately.
+    // FIXME: the setting of the TTL may change in the middle of a long scan!
+    auto column = find_expiration_column(*s);
+    if (!column) {
         co_return false;
     }
     expiration_stats.scan_table++;
     // FIXME: need to pace the scan, not do it all at once.
-    scan_ranges_context scan_ctx{s, proxy, std::move(column_name), std::move(member)};
+    scan_ranges_context scan_ctx{s, proxy, std::move(column->column_name), std::move(column->member)};
     auto erm = db.real_database().find_keyspace(s->ks_name()).get_vnode_effective_replication_map();
     auto my_address = erm->get_topology().my_address();
     token_ranges_owned_by_this_shard my_ranges(s, co_await ranges_holder_primary::make(erm, my_address));
@@ -743,7 +869,7 @@ static future<bool> scan_table(
         // we fail the entire scan (and rescan from the beginning). Need to
         // reconsider this. Saving the scan position might be a good enough
         // solution for this problem.
-        co_await scan_table_ranges(proxy, scan_ctx, std::move(partition_ranges), abort_source, page_sem, expiration_stats);
+        co_await scan_table_ranges(proxy, scan_ctx, std::move(partition_ranges), abort_source, page_sem, expiration_stats, index);
     }
     // If each node only scans its own primary ranges, then when any node is
     // down part of the token range will not get scanned. This can be viewed
@@ -757,12 +883,67 @@ static future<bool> scan_table(
         expiration_stats.secondary_ranges_scanned++;
         dht::partition_range_vector partition_ranges;
         partition_ranges.push_back(std::move(*range));
-        co_await scan_table_ranges(proxy, scan_ctx, std::move(partition_ranges), abort_source, page_sem, expiration_stats);
+        co_await scan_table_ranges(proxy, scan_ctx, std::move(partition_ranges), abort_source, page_sem, expiration_stats, index);
     }
     co_return true;
 }
 
 
+// Visit the partitions which hold items that the index says are due, and
+// expire them. Each partition is read, and the expiration time of its items
+// checked, exactly as in a full scan, because the index may be stale - an
+// item's expiration time may have been changed since it was indexed, or it
+// may have been deleted. Up to max_concurrent_index_reads partitions are
+// read in parallel.
+future<> expiration_service::expire_indexed_items() {
+    auto due = _index.pop_due(gc_clock::now());
+    // A partition may hold several due items, it is read once for all of them.
+    auto same_partition = [] (const expiration_index::entry& a, const expiration_index::entry& b) {
+        return a.table == b.table && a.key == b.key;
+    };
+    std::ranges::sort(due, [] (const expiration_index::entry& a, const expiration_index::entry& b) {
+        return std::tie(a.table, a.key) < std::tie(b.table, b.key);
+    });
+    due.erase(std::unique(due.begin(), due.end(), same_partition), due.end());
+
+    // If the table was dropped or TTL was disabled on it, we just drop its
+    // entries.
+    std::unordered_map<table_id, std::optional<std::pair<schema_ptr, expiration_column>>> tables;
+    co_await max_concurrent_for_each(due, max_concurrent_index_reads, [&] (const expiration_index::entry& e) -> future<> {
+        if (shutting_down()) {
+            co_return;
+        }
+        auto table_it = tables.find(e.table);
+        if (table_it == tables.end()) {
+            std::optional<std::pair<schema_ptr, expiration_column>> table;
+            if (auto t = _db.try_find_table(e.table)) {
+                schema_ptr s = t->schema();
+                if (auto column = find_expiration_column(*s)) {
+                    table.emplace(std::move(s), std::move(*column));
+                }
+            }
+            table_it = tables.emplace(e.table, std::move(table)).first;
+        }
+        if (!table_it->second) {
+            co_return;
+        }
+        const auto& [s, column] = *table_it->second;
+        // Each read has its own context, as pagers can't share one.
+        scan_ranges_context ctx(s, _proxy, column.column_name, column.member);
+        auto pk = partition_key::from_bytes(e.key);
+        dht::partition_range_vector partition_ranges;
+        partition_ranges.push_back(dht::partition_range::make_singular(dht::decorate_key(*s, pk)));
+        _expiration_stats.index_partitions_scanned++;
+        try {
+            co_await scan_table_ranges(_proxy, ctx, std::move(partition_ranges), _abort_source, _index_page_sem, _expiration_stats, _index);
+        } catch (...) {
+            // Try this partition again in the next period.
+            tlogger.debug("expiration of partition of table {} failed: {}", s->cf_name(), std::current_exception());
+            _index.add(e.expiration, e.table, pk);
+        }
+    });
+}
+
 future<> expiration_service::run() {
     // FIXME: don't just tight-loop, think about timing, pace, and
     // store position in durable storage, etc.
@@ -771,20 +952,45 @@ future<> expiration_service::run() {
     // deleted or when ttl is enabled or disabled for a table!
     for (;;) {
         auto start = lowres_clock::now();
+        auto period = scan_period(_db.get_config());
+        auto full_scan_period = alternator::full_scan_period(_db.get_config());
+        _index.set_horizon(index_horizon(_db.get_config()));
         // _db.tables() may change under our feet during a
         // long-living loop, so we must keep our own copy of the list of
         // schemas.
         std::vector<schema_ptr> schemas;
+        std::unordered_set<table_id> table_ids;
         for (auto cf : _db.get_tables()) {
             schemas.push_back(cf.schema());
+            table_ids.insert(cf.schema()->id());
         }
+        std::erase_if(_last_full_scan, [&] (const auto& e) { return !table_ids.contains(e.first); });
         for (schema_ptr s : schemas) {
             co_await coroutine::maybe_yield();
             if (shutting_down()) {
                 co_return;
             }
+            // Tables scanned recently don't need another full scan: Their
+            // items which expire before the next full scan were indexed by
+            // that scan or when they were written, and are expired by
+            // expire_indexed_items() below. Passes start about a period
+            // apart, half a period of slack keeps the timing of a pass from
+            // postponing a full scan by a whole period.
+            auto attribute = find_ttl_attribute(*s);
+            if (!attribute) {
+                _last_full_scan.erase(s->id());
+                continue;
+            }
+            auto last = _last_full_scan.find(s->id());
+            if (last != _last_full_scan.end() && last->second.attribute == *attribute && start - last->second.time + period / 2 < full_scan_period) {
+                continue;
+            }
             try {
-                co_await scan_table(_proxy, _db, _gossiper, s, _abort_source, _page_sem, _expiration_stats);
+                if (co_await scan_table(_proxy, _db, _gossiper, s, _abort_source, _page_sem, _expiration_stats, _index)) {
+                    _last_full_scan[s->id()] = full_scan{start, std::move(*attribute)};
+                } else {
+                    _last_full_scan.erase(s->id());
+                }
             } catch (...) {
                 // The scan of a table may fail in the middle for many
                 // reasons, including network failure and even the table
@@ -803,6 +1009,14 @@ future<> expiration_service::run() {
                 }
             }
         }
+        try {
+            co_await expire_indexed_items();
+        } catch (...) {
+            tlogger.warn("expiration of indexed items failed: {}", std::current_exception());
+        }
+        if (shutting_down()) {
+            co_return;
+        }
         _expiration_stats.scan_passes++;
         // The TTL scanner runs above once over all tables, at full steam.
         // After completing such a scan, we sleep until it's time start
@@ -811,7 +1025,6 @@ future<> expiration_service::run() {
         // share (if using a separate scheduling group), or introduce
         // finer-grain sleeps into the scanning code.
         std::chrono::milliseconds scan_duration(std::chrono::duration_cast<std::chrono::milliseconds>(lowres_clock::now() - start));
-        std::chrono::milliseconds period(long(_db.get_config().alternator_ttl_period_in_seconds() * 1000));
         if (scan_duration < period) {
             try {
                 tlogger.info("sleeping {} seconds until next period", (period - scan_duration).count()/1000.0);
@@ -841,11 +1054,15 @@ future<> expiration_service::stop() {
         throw std::logic_error("expiration_service::stop() called a second time");
     }
     _abort_source.request_abort();
+    // Items being indexed on other shards must not outlive them.
+    auto notes_done = _notes_gate.close();
     if (!_end) {
         // if _end is was not set, start() was never called
-        return make_ready_future<>();
+        return notes_done;
     }
-    return std::move(*_end);
+    return notes_done.then([end = std::move(*_end)] () mutable {
+        return std::move(end);
+    });
 }
 
 expiration_service::stats::stats() {
@@ -858,6 +1075,10 @@ expiration_service::stats::stats() {
             seastar::metrics::description("number of items deleted after expiration")),
         seastar::metrics::make_total_operations("secondary_ranges_scanned", secondary_ranges_scanned,
             seastar::metrics::description("number of token ranges scanned by this node while their primary owner was down")),
+        seastar::metrics::make_total_operations("items_indexed", items_indexed,
+            seastar::metrics::description("number of items added to the index of items due to expire soon")),
+        seastar::metrics::make_total_operations("index_partitions_scanned", index_partitions_scanned,
+            seastar::metrics::description("number of partitions read because the index had an item in them due to expire")),
     });
 }
 
@@ -11,8 +11,16 @@
 #include "seastarx.hh"
 #include <seastar/core/sharded.hh>
 #include <seastar/core/abort_source.hh>
+#include <seastar/core/gate.hh>
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <set>
+#include <unordered_map>
 #include "data_dictionary/data_dictionary.hh"
+#include "gc_clock.hh"
+#include "keys.hh"
+#include "schema/schema_fwd.hh"
+#include "utils/rjson.hh"
 
 namespace gms {
 class gossiper;
@@ -28,6 +36,45 @@ namespace service {
 
 namespace alternator {
 
+// expiration_index is a per-shard, in-memory index of items which are due
+// to expire soon, ordered by their expiration time. It allows the
+// expiration service to visit just the partitions which hold due items,
+// instead of scanning entire tables to find them.
+// The index is best-effort: It is lost on restart, only holds items which
+// expire within the configured horizon, and when it grows beyond
+// max_entries the latest-expiring entries are dropped. The expiration
+// service's (rare) full scans of each table find whatever it misses.
+class expiration_index {
+public:
+    struct entry {
+        gc_clock::time_point expiration;
+        table_id table;
+        // The serialized partition_key of the item
+        bytes key;
+
+        bool operator<(const entry& o) const {
+            return std::tie(expiration, table, key) < std::tie(o.expiration, o.table, o.key);
+        }
+    };
+private:
+    std::set<entry> _entries;
+    size_t _max_entries;
+    gc_clock::duration _horizon = gc_clock::duration::zero();
+public:
+    explicit expiration_index(size_t max_entries) : _max_entries(max_entries) {}
+    // Items expiring later than the horizon from now are not indexed.
+    void set_horizon(gc_clock::duration horizon) {
+        _horizon = horizon;
+    }
+    // Returns true if the entry was added (or was already present)
+    bool add(gc_clock::time_point expiration, table_id table, const partition_key& pk);
+    // Removes from the index, and returns, all the entries due by now.
+    std::vector<entry> pop_due(gc_clock::time_point now);
+    size_t size() const {
+        return _entries.size();
+    }
+};
+
 // expiration_service is a sharded service responsible for cleaning up expired
 // items in all tables with per-item expiration enabled. Currently, this means
 // Alternator tables with TTL configured via a UpdateTimeToLeave request.
@@ -43,6 +90,8 @@ class expiration_service final : public seastar::peering_sharded_service<expirat
         uint64_t scan_table = 0;
         uint64_t items_deleted = 0;
         uint64_t secondary_ranges_scanned = 0;
+        uint64_t items_indexed = 0;
+        uint64_t index_partitions_scanned = 0;
     private:
         // The metric_groups object holds this stat object's metrics registered
         // as long as the stats object is alive.
@@ -61,6 +110,23 @@ class expiration_service final : public seastar::peering_sharded_service<expirat
     named_semaphore _page_sem{1, named_semaphore_exception_factory{"alternator_ttl"}};
     bool shutting_down() { return _abort_source.abort_requested(); }
     stats _expiration_stats;
+    static constexpr size_t max_index_entries = 100'000;
+    expiration_index _index{max_index_entries};
+    // Limits the number of partitions expire_indexed_items() reads in parallel
+    static constexpr size_t max_concurrent_index_reads = 16;
+    named_semaphore _index_page_sem{max_concurrent_index_reads, named_semaphore_exception_factory{"alternator_ttl_index"}};
+    // Holds the items being added to the index of another shard by note_expiration()
+    gate _notes_gate;
+    // When each table was last fully scanned, and with which expiration-time
+    // attribute. A table missing here (e.g., because TTL was just enabled on
+    // it, or after a restart, when the index is empty) is scanned on the
+    // next pass.
+    struct full_scan {
+        lowres_clock::time_point time;
+        std::string attribute;
+    };
+    std::unordered_map<table_id, full_scan> _last_full_scan;
+    future<> expire_indexed_items();
 public:
     // sharded_service<expiration_service>::start() creates this object on
     // all shards, so calls this constructor on each shard. Later, the
@@ -75,6 +141,21 @@ class expiration_service final : public seastar::peering_sharded_service<expirat
     // stop() may be called even before start(), but may only be called once -
     // calling it twice will result in an exception.
     future<> stop();
+
+    // Called after a write coordinated by this node set the expiration time
+    // of an item, so it can be expired on time without waiting for a full
+    // scan of its table. The item is indexed in the background by the shard
+    // which expires it, if that is on this node.
+    void note_expiration(const schema& s, const partition_key& pk, gc_clock::time_point expiration);
 };
 
+// Returns the name of the table's expiration-time attribute, if TTL is
+// enabled on the table.
+std::optional<std::string> find_ttl_attribute(const schema& s);
+
+// Returns the expiration time set by the value of an expiration-time
+// attribute. A value which isn't a number never expires, so doesn't have
+// an expiration time.
+std::optional<gc_clock::time_point> to_expiration_time(const rjson::value& expiration_time);
+
 } // namespace alternator
@@ -101,6 +101,10 @@ cdc::stats::stats() {
                         sm::description(format("number of {} preimage queries performed", kind)),
                         {}),
 
+                sm::make_total_operations("local_preimage_selects_" + kind, counters.local_preimage_selects,
+                        sm::description(format("number of {} preimage queries served directly by the local replica", kind)),
+                        {}),
+
                 sm::make_total_operations("operations_with_preimage_" + kind, counters.with_preimage_count,
                         sm::description(format("number of {} operations that included preimage", kind)),
                         {}),
@@ -1685,12 +1689,41 @@ class transformer final : public change_processor {
         auto command = ::make_lw_shared<query::read_command>(_schema->id(), _schema->version(), partition_slice, query::max_result_size(max_result_size), tombstone_limit, query::row_limit(row_limit));
 
         const auto select_cl = adjust_cl(write_cl);
+        auto to_result_set = [s = _schema, partition_slice = std::move(partition_slice), selection = std::move(selection)] (service::storage_proxy::coordinator_query_result qr) -> lw_shared_ptr<cql3::untyped_result_set> {
+            return make_lw_shared<cql3::untyped_result_set>(*s, std::move(qr.query_result), *selection, partition_slice);
+        };
 
+        // A single replica is enough to satisfy CL ONE and LOCAL_ONE. If this
+        // node is a replica of the partition (the common case with token-aware
+        // drivers), take the preimage straight from its memtables and cache
+        // instead of paying for a full coordinator read.
+        if (select_cl == db::consistency_level::ONE || select_cl == db::consistency_level::LOCAL_ONE) {
+            auto& proxy = _ctx._proxy;
+            auto s = _schema;
+            return proxy.query_singular_locally(s, command, m.decorated_key(), default_timeout()).then(
+                    [&proxy, s, command, partition_ranges = std::move(partition_ranges), select_cl, &client_state, to_result_set = std::move(to_result_set)]
+                    (std::optional<service::storage_proxy::coordinator_query_result> qr) mutable {
+                if (qr) {
+                    proxy.get_cdc_stats().counters_total.local_preimage_selects++;
+                    return make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>(to_result_set(std::move(*qr)));
+                }
+                return coordinator_select(proxy, std::move(s), std::move(command), std::move(partition_ranges), select_cl, client_state).then(std::move(to_result_set));
+            });
+        }
+
+        return coordinator_select(_ctx._proxy, _schema, std::move(command), std::move(partition_ranges), select_cl, client_state).then(std::move(to_result_set));
+    }
+
+    static future<service::storage_proxy::coordinator_query_result> coordinator_select(
+            service::storage_proxy& proxy,
+            schema_ptr s,
+            lw_shared_ptr<query::read_command> command,
+            dht::partition_range_vector partition_ranges,
+            db::consistency_level select_cl,
+            service::client_state& client_state)
+    {
       try {
-        return _ctx._proxy.query(_schema, std::move(command), std::move(partition_ranges), select_cl, service::storage_proxy::coordinator_query_options(default_timeout(), empty_service_permit(), client_state)).then(
-                [s = _schema, partition_slice = std::move(partition_slice), selection = std::move(selection)] (service::storage_proxy::coordinator_query_result qr) -> lw_shared_ptr<cql3::untyped_result_set> {
-            return make_lw_shared<cql3::untyped_result_set>(*s, std::move(qr.query_result), *selection, partition_slice);
-        });
+        return proxy.query(std::move(s), std::move(command), std::move(partition_ranges), select_cl, service::storage_proxy::coordinator_query_options(default_timeout(), empty_service_permit(), client_state));
       } catch (exceptions::unavailable_exception& e) {
         // `query` can throw `unavailable_exception`, which is seen by clients as ~ "NoHostAvailable". 
         // So, we'll translate it to a `read_failure_exception` with custom message.
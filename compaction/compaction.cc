@@ -520,6 +520,10 @@ class compaction {
     const owned_ranges_ptr _owned_ranges = {};
     // required for reshard compaction.
     const dht::sharder* _sharder = nullptr;
+    // shard on whose behalf the output sstables are written.
+    const shard_id _output_shard;
+    // token ranges whose data is written into sstables of their own.
+    const dht::token_range_vector _isolated_token_ranges;
     const std::optional<dht::incremental_owned_ranges_checker> _owned_ranges_checker;
     // Garbage collected sstables that are sealed but were not added to SSTable set yet.
     std::vector<shared_sstable> _unused_garbage_collected_sstables;
@@ -575,6 +579,8 @@ class compaction {
         , _compacting_for_max_purgeable_func(std::unordered_set<shared_sstable>(_sstables.begin(), _sstables.end()))
         , _owned_ranges(std::move(descriptor.owned_ranges))
         , _sharder(descriptor.sharder)
+        , _output_shard(descriptor.output_shard.value_or(this_shard_id()))
+        , _isolated_token_ranges(std::move(descriptor.isolated_token_ranges))
         , _owned_ranges_checker(_owned_ranges ? std::optional<dht::incremental_owned_ranges_checker>(*_owned_ranges) : std::nullopt)
         , _tombstone_gc_state_with_commitlog_check_disabled(descriptor.gc_check_only_compacting_sstables ? std::make_optional(_table_s.get_tombstone_gc_state().with_commitlog_check_disabled()) : std::nullopt)
         , _progress_monitor(progress_monitor)
@@ -655,14 +661,14 @@ class compaction {
     }
 
     compaction_writer create_gc_compaction_writer(run_id gc_run) const {
-        auto sst = _sstable_creator(this_shard_id());
+        auto sst = _sstable_creator(_output_shard);
 
         auto monitor = std::make_unique<compaction_write_monitor>(sst, _table_s, maximum_timestamp(), _sstable_level);
         sstable_writer_config cfg = _table_s.configure_writer("garbage_collection");
         cfg.run_identifier = gc_run;
         cfg.monitor = monitor.get();
         uint64_t estimated_partitions = std::max(1UL, uint64_t(ceil(partitions_per_sstable() * _estimated_droppable_tombstone_ratio)));
-        auto writer = sst->get_writer(*schema(), estimated_partitions, cfg, get_encoding_stats());
+        auto writer = sst->get_writer(*schema(), estimated_partitions, cfg, get_encoding_stats(), _output_shard);
         return compaction_writer(std::move(monitor), std::move(writer), std::move(sst));
     }
 
@@ -785,6 +791,8 @@ class compaction {
         min_max_tracker<api::timestamp_type> timestamp_tracker;
 
         double sum_of_estimated_droppable_tombstone_ratio = 0;
+        std::vector<shared_sstable> compacting_sstables;
+        compacting_sstables.reserve(_sstables.size());
         _input_sstable_generations.reserve(_sstables.size());
         for (auto& sst : _sstables) {
             co_await coroutine::maybe_yield();
@@ -808,14 +816,12 @@ class compaction {
             _cdata.compaction_size += sst->data_size();
             // We also capture the sstable, so we keep it alive while the read isn't done
             ssts->insert(sst);
-            // FIXME: If the sstables have cardinality estimation bitmaps, use that
-            // for a better estimate for the number of partitions in the merged
-            // sstable than just adding up the lengths of individual sstables.
+            compacting_sstables.push_back(sst);
             _estimated_partitions += sst->get_estimated_key_count();
             sum_of_estimated_droppable_tombstone_ratio += sst->estimate_droppable_tombstone_ratio(gc_clock::now(), get_tombstone_gc_state(), _schema);
             _compacting_data_file_size += sst->ondisk_data_size();
             _compacting_max_timestamp = std::max(_compacting_max_timestamp, sst->get_stats_metadata().max_timestamp);
-            if (sst->originated_on_this_node().value_or(false) && sst_stats.position.shard_id() == this_shard_id()) {
+            if (sst->originated_on_this_node().value_or(false) && sst_stats.position.shard_id() == _output_shard) {
                 _rp = std::max(_rp, sst_stats.position);
             }
         }
@@ -826,6 +832,16 @@ class compaction {
         }
         // _estimated_droppable_tombstone_ratio could exceed 1.0 in certain cases, so limit it to 1.0.
         _estimated_droppable_tombstone_ratio = std::min(1.0, sum_of_estimated_droppable_tombstone_ratio / ssts->size());
+        // Adding up the partitions of the input sstables overestimates the
+        // partitions of the output when the inputs overlap. Use the cardinality
+        // sketches of the inputs, if available, to account for that. The sketch
+        // estimate is padded by a few standard errors, as underestimating makes
+        // the bloom filter of the output too small.
+        if (auto overlap = estimate_partition_overlap(compacting_sstables)) {
+            auto estimated_partitions = std::min(_estimated_partitions, uint64_t(overlap->distinct_partitions * 1.1));
+            log_debug("Estimated {} distinct partitions out of {} partitions in input sstables", estimated_partitions, _estimated_partitions);
+            _estimated_partitions = estimated_partitions;
+        }
 
         _compacting = std::move(ssts);
 
@@ -1186,18 +1202,41 @@ class regular_compaction : public compaction {
         return "Compacting";
     }
 
+    reader_consumer_v2 make_interposer_consumer(reader_consumer_v2 end_consumer) override {
+        auto consumer = compaction::make_interposer_consumer(std::move(end_consumer));
+        if (_isolated_token_ranges.empty()) {
+            return consumer;
+        }
+        // Tokens preceding the i-th range belong to group 2*i, and tokens
+        // within it to group 2*i+1, so group ids never decrease.
+        auto classifier = [&ranges = _isolated_token_ranges] (dht::token t) {
+            auto it = std::ranges::partition_point(ranges, [t] (const dht::token_range& r) {
+                return r.end()->value() < t;
+            });
+            auto within = it != ranges.end() && it->start()->value() <= t;
+            return mutation_writer::token_group_id(2 * std::distance(ranges.begin(), it) + within);
+        };
+        return [classifier = std::move(classifier), consumer = std::move(consumer)] (mutation_reader reader) mutable -> future<> {
+            return mutation_writer::segregate_by_token_group(std::move(reader), std::move(classifier), std::move(consumer));
+        };
+    }
+
+    bool use_interposer_consumer() const override {
+        return !_isolated_token_ranges.empty() || compaction::use_interposer_consumer();
+    }
+
     std::string_view report_finish_desc() const override {
         return "Compacted";
     }
 
     virtual compaction_writer create_compaction_writer(const dht::decorated_key& dk) override {
-        auto sst = _sstable_creator(this_shard_id());
+        auto sst = _sstable_creator(_output_shard);
         setup_new_sstable(sst);
 
         auto monitor = std::make_unique<compaction_write_monitor>(sst, _table_s, maximum_timestamp(), _sstable_level);
         sstable_writer_config cfg = make_sstable_writer_config(_type);
         cfg.monitor = monitor.get();
-        return compaction_writer{std::move(monitor), sst->get_writer(*_schema, partitions_per_sstable(), cfg, get_encoding_stats()), sst};
+        return compaction_writer{std::move(monitor), sst->get_writer(*_schema, partitions_per_sstable(), cfg, get_encoding_stats(), _output_shard), sst};
     }
 
     virtual void stop_sstable_writer(compaction_writer* writer) override {
@@ -1947,6 +1986,30 @@ compact_sstables(sstables::compaction_descriptor descriptor, compaction_data& cd
     return compaction::run(make_compaction(table_s, std::move(descriptor), cdata, progress_monitor));
 }
 
+std::optional<partition_overlap_estimate> estimate_partition_overlap(const std::vector<sstables::shared_sstable>& sstables) {
+    std::optional<hll::HyperLogLog> merged;
+    double total_partitions = 0;
+    for (const auto& sst : sstables) {
+        auto sketch = sst->get_partition_cardinality_sketch();
+        if (!sketch || (merged && merged->registerSize() != sketch->registerSize())) {
+            return std::nullopt;
+        }
+        total_partitions += sketch->estimate();
+        if (merged) {
+            merged->merge(*sketch);
+        } else {
+            merged = std::move(sketch);
+        }
+    }
+    if (!merged) {
+        return std::nullopt;
+    }
+    return partition_overlap_estimate{
+        .total_partitions = uint64_t(std::llround(total_partitions)),
+        .distinct_partitions = uint64_t(std::llround(merged->estimate())),
+    };
+}
+
 std::unordered_set<sstables::shared_sstable>
 get_fully_expired_sstables(const table_state& table_s, const std::vector<sstables::shared_sstable>& compacting, gc_clock::time_point compaction_time) {
     clogger.debug("Checking droppable sstables in {}.{}", table_s.schema()->ks_name(), table_s.schema()->cf_name());
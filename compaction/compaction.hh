@@ -130,6 +130,25 @@ future<compaction_result> compact_sstables(sstables::compaction_descriptor descr
 std::unordered_set<sstables::shared_sstable>
 get_fully_expired_sstables(const table_state& table_s, const std::vector<sstables::shared_sstable>& compacting, gc_clock::time_point gc_before);
 
+// Estimate of how much the partitions of a set of sstables overlap,
+// based on the partition key cardinality sketches of the sstables.
+struct partition_overlap_estimate {
+    // Sum of the number of partitions of each sstable.
+    uint64_t total_partitions = 0;
+    // Number of distinct partitions across all the sstables.
+    uint64_t distinct_partitions = 0;
+
+    // The fraction of the partitions that compacting the sstables
+    // together would merge away.
+    double deduplication_ratio() const {
+        return total_partitions ? 1.0 - double(std::min(distinct_partitions, total_partitions)) / total_partitions : 0.0;
+    }
+};
+
+// Returns std::nullopt if any of the sstables lacks a usable sketch, or
+// the sketches were written with different precisions.
+std::optional<partition_overlap_estimate> estimate_partition_overlap(const std::vector<sstables::shared_sstable>& sstables);
+
 // For tests, can drop after we virtualize sstables.
 mutation_reader make_scrubbing_reader(mutation_reader rd, compaction_type_options::scrub::mode scrub_mode, uint64_t& validation_errors);
 
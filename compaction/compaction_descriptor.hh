@@ -164,6 +164,15 @@ struct compaction_descriptor {
     compaction::owned_ranges_ptr owned_ranges;
     // Required for reshard compaction.
     const dht::sharder* sharder;
+    // If engaged, output sstables are written on behalf of the given shard rather
+    // than the one running the compaction. Used when a shard offloads a regular
+    // compaction to another, so the outputs carry the owner's sharding metadata.
+    std::optional<shard_id> output_shard;
+    // If not empty, regular compaction splits its output at the boundaries of
+    // these sorted, disjoint token ranges, so data within them isn't written
+    // into the same sstables as data outside them. Used to isolate the parts
+    // of an sstable holding most of its droppable tombstones.
+    dht::token_range_vector isolated_token_ranges;
 
     compaction_sstable_creator_fn creator;
     compaction_sstable_replacer_fn replacer;
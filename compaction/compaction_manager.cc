@@ -20,6 +20,8 @@
 #include <seastar/coroutine/switch_to.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/coroutine/maybe_yield.hh>
+#include <seastar/coroutine/as_future.hh>
+#include <seastar/coroutine/exception.hh>
 #include "sstables/exceptions.hh"
 #include "sstables/sstable_directory.hh"
 #include "utils/assert.hh"
@@ -413,25 +415,8 @@ future<sstables::compaction_result> compaction_task_executor::compact_sstables(s
     descriptor.creator = [&t] (shard_id) {
         return t.make_sstable();
     };
-    descriptor.replacer = [this, &t, &on_replace, offstrategy] (sstables::compaction_completion_desc desc) {
-        t.get_compaction_strategy().notify_completion(t, desc.old_sstables, desc.new_sstables);
-        _cm.propagate_replacement(t, desc.old_sstables, desc.new_sstables);
-        // on_replace updates the compacting registration with the old and new
-        // sstables. while on_compaction_completion() removes the old sstables
-        // from the table's sstable set, and adds the new ones to the sstable
-        // set.
-        // since the regular compactions exclude the sstables in the sstable
-        // set which are currently being compacted, if we want to ensure the
-        // exclusive access of compactions to an sstable we should guard it
-        // with the registration when adding/removing it to/from the sstable
-        // set. otherwise, the regular compaction would pick it up in the time
-        // window, where the sstables:
-        // - are still in the main set
-        // - are not being compacted.
-        on_replace.on_addition(desc.new_sstables);
-        auto old_sstables = desc.old_sstables;
-        _cm.on_compaction_completion(t, std::move(desc), offstrategy).get();
-        on_replace.on_removal(old_sstables);
+    descriptor.replacer = [this, &on_replace, offstrategy] (sstables::compaction_completion_desc desc) {
+        replace_sstables(std::move(desc), on_replace, offstrategy).get();
     };
 
     // retrieve owned_ranges if_required
@@ -454,6 +439,29 @@ future<sstables::compaction_result> compaction_task_executor::compact_sstables(s
 
     co_return co_await sstables::compact_sstables(std::move(descriptor), cdata, t, _progress_monitor);
 }
+
+future<> compaction_task_executor::replace_sstables(sstables::compaction_completion_desc desc, on_replacement& on_replace, sstables::offstrategy offstrategy) {
+    table_state& t = *_compacting_table;
+    t.get_compaction_strategy().notify_completion(t, desc.old_sstables, desc.new_sstables);
+    _cm.propagate_replacement(t, desc.old_sstables, desc.new_sstables);
+    // on_replace updates the compacting registration with the old and new
+    // sstables. while on_compaction_completion() removes the old sstables
+    // from the table's sstable set, and adds the new ones to the sstable
+    // set.
+    // since the regular compactions exclude the sstables in the sstable
+    // set which are currently being compacted, if we want to ensure the
+    // exclusive access of compactions to an sstable we should guard it
+    // with the registration when adding/removing it to/from the sstable
+    // set. otherwise, the regular compaction would pick it up in the time
+    // window, where the sstables:
+    // - are still in the main set
+    // - are not being compacted.
+    on_replace.on_addition(desc.new_sstables);
+    auto old_sstables = desc.old_sstables;
+    co_await _cm.on_compaction_completion(t, std::move(desc), offstrategy);
+    on_replace.on_removal(old_sstables);
+}
+
 future<> compaction_task_executor::update_history(table_state& t, const sstables::compaction_result& res, const sstables::compaction_data& cdata) {
     auto ended_at = std::chrono::duration_cast<std::chrono::milliseconds>(res.stats.ended_at.time_since_epoch());
 
@@ -1003,6 +1011,8 @@ void compaction_manager::register_metrics() {
                        sm::description("Holds the number of completed compaction tasks.")),
         sm::make_counter("failed_compactions", [this] { return _stats.errors; },
                        sm::description("Holds the number of failed compaction tasks.")),
+        sm::make_counter("offloaded_compactions", [this] { return _stats.offloaded_tasks; },
+                       sm::description("Holds the number of regular compactions of this shard's sstables which ran on another, idle, shard.")),
         sm::make_gauge("postponed_compactions", [this] { return _postponed.size(); },
                        sm::description("Holds the number of tables with postponed compaction.")),
         sm::make_gauge("backlog", [this] { return _last_backlog; },
@@ -1112,6 +1122,13 @@ future<> compaction_manager::stop_ongoing_compactions(sstring reason, table_stat
             }
             cmlog.log(level, "Stopping {} tasks for {} ongoing compactions{} due to {}", tasks.size(), ongoing_compactions, scope, reason);
         }
+        if (!type_opt || *type_opt == sstables::compaction_type::Compaction) {
+            for (auto& [id, offloaded] : _offloaded_compactions) {
+                if (!t || offloaded.table == t) {
+                    offloaded.cdata->stop(reason);
+                }
+            }
+        }
         return stop_tasks(std::move(tasks), std::move(reason));
     } catch (...) {
         cmlog.error("Stopping ongoing compactions failed: {}.  Ignored", std::current_exception());
@@ -1189,6 +1206,192 @@ inline bool compaction_manager::can_proceed(table_state* t) const {
     return !found->second.compaction_disabled();
 }
 
+struct compaction_manager::offloaded_compaction_job {
+    table_id table;
+    std::string group_id;
+    tasks::task_id id;
+    shard_id owner;
+    std::vector<sstables::foreign_sstable_open_info> sstables;
+    int level;
+    uint64_t max_sstable_bytes;
+    bool can_split_large_partition;
+    sstables::run_id run_identifier;
+};
+
+struct compaction_manager::offloaded_compaction_result {
+    std::vector<sstables::foreign_sstable_open_info> new_sstables;
+    sstables::compaction_stats stats;
+    utils::UUID compaction_uuid;
+    uint64_t compaction_size;
+    uint64_t total_partitions;
+    uint64_t total_keys_written;
+};
+
+namespace compaction {
+
+// Table state used to run a compaction on behalf of the shard owning the input
+// sstables. Reading and writing sstables is delegated to the local state of the
+// same table, but tombstones are never purged, since neither the owner's memtables
+// nor its sstable set are visible from here, and the owner takes care of replacing
+// the input sstables once it loads the output.
+class offloaded_compaction_table_state : public table_state {
+    table_state& _t;
+    compaction_backlog_tracker _backlog_tracker;
+    std::vector<sstables::shared_sstable> _compacted_undeleted;
+public:
+    explicit offloaded_compaction_table_state(table_state& t)
+        : _t(t)
+        , _backlog_tracker(nullptr)
+    {}
+
+    virtual const schema_ptr& schema() const noexcept override { return _t.schema(); }
+    virtual unsigned min_compaction_threshold() const noexcept override { return _t.min_compaction_threshold(); }
+    virtual bool compaction_enforce_min_threshold() const noexcept override { return _t.compaction_enforce_min_threshold(); }
+    virtual const sstables::sstable_set& main_sstable_set() const override { return _t.main_sstable_set(); }
+    virtual const sstables::sstable_set& maintenance_sstable_set() const override { return _t.maintenance_sstable_set(); }
+    virtual lw_shared_ptr<const sstables::sstable_set> sstable_set_for_tombstone_gc() const override { return _t.sstable_set_for_tombstone_gc(); }
+    virtual std::unordered_set<sstables::shared_sstable> fully_expired_sstables(const std::vector<sstables::shared_sstable>& sstables, gc_clock::time_point compaction_time) const override { return {}; }
+    virtual const std::vector<sstables::shared_sstable>& compacted_undeleted_sstables() const noexcept override { return _compacted_undeleted; }
+    virtual sstables::compaction_strategy& get_compaction_strategy() const noexcept override { return _t.get_compaction_strategy(); }
+    virtual compaction_strategy_state& get_compaction_strategy_state() noexcept override { return _t.get_compaction_strategy_state(); }
+    virtual reader_permit make_compaction_reader_permit() const override { return _t.make_compaction_reader_permit(); }
+    virtual sstables::sstables_manager& get_sstables_manager() noexcept override { return _t.get_sstables_manager(); }
+    virtual sstables::shared_sstable make_sstable() const override { return _t.make_sstable(); }
+    virtual future<sstables::shared_sstable> load_foreign_sstable(sstables::foreign_sstable_open_info info) const override { return _t.load_foreign_sstable(std::move(info)); }
+    virtual sstables::sstable_writer_config configure_writer(sstring origin) const override { return _t.configure_writer(std::move(origin)); }
+    virtual api::timestamp_type min_memtable_timestamp() const override { return api::min_timestamp; }
+    virtual api::timestamp_type min_memtable_live_timestamp() const override { return api::min_timestamp; }
+    virtual api::timestamp_type min_memtable_live_row_marker_timestamp() const override { return api::min_timestamp; }
+    virtual bool memtable_has_key(const dht::decorated_key& key) const override { return true; }
+    virtual future<> on_compaction_completion(sstables::compaction_completion_desc desc, sstables::offstrategy offstrategy) override {
+        on_internal_error(cmlog, format("Offloaded compaction of {} attempted to replace sstables on shard {}", *this, this_shard_id()));
+    }
+    virtual bool is_auto_compaction_disabled_by_user() const noexcept override { return _t.is_auto_compaction_disabled_by_user(); }
+    virtual bool tombstone_gc_enabled() const noexcept override { return false; }
+    virtual const tombstone_gc_state& get_tombstone_gc_state() const noexcept override { return _t.get_tombstone_gc_state(); }
+    virtual compaction_backlog_tracker& get_backlog_tracker() override { return _backlog_tracker; }
+    virtual const std::string get_group_id() const noexcept override { return _t.get_group_id(); }
+    virtual seastar::condition_variable& get_staging_done_condition() noexcept override { return _t.get_staging_done_condition(); }
+    virtual dht::token_range get_token_range_after_split(const dht::token& t) const noexcept override { return _t.get_token_range_after_split(t); }
+};
+
+}
+
+std::optional<double> compaction_manager::offload_candidate_backlog(table_id id, const std::string& group_id) {
+    if (_state != state::enabled || _stats.active_tasks || !_offloaded_compactions.empty()) {
+        return std::nullopt;
+    }
+    for (auto& [t, cs] : _compaction_state) {
+        if (t->schema()->id() == id && t->get_group_id() == group_id && !cs.compaction_disabled()) {
+            return backlog();
+        }
+    }
+    return std::nullopt;
+}
+
+future<std::optional<shard_id>> compaction_manager::pick_offload_shard(table_state& t) {
+    auto ratio = _cfg.work_stealing_backlog_ratio();
+    auto local_backlog = backlog();
+    if (ratio <= 0 || smp::count == 1 || !std::isfinite(local_backlog) || local_backlog <= 0) {
+        co_return std::nullopt;
+    }
+    struct candidate {
+        shard_id shard;
+        double backlog;
+    };
+    auto best = co_await container().map_reduce0([id = t.schema()->id(), group_id = t.get_group_id(), owner = this_shard_id()] (compaction_manager& cm) -> std::optional<candidate> {
+        if (this_shard_id() == owner) {
+            return std::nullopt;
+        }
+        auto backlog = cm.offload_candidate_backlog(id, group_id);
+        if (!backlog) {
+            return std::nullopt;
+        }
+        return candidate{this_shard_id(), *backlog};
+    }, std::optional<candidate>(), [] (std::optional<candidate> best, std::optional<candidate> c) {
+        return (c && (!best || c->backlog < best->backlog)) ? c : best;
+    });
+    if (!best || local_backlog <= ratio * best->backlog) {
+        co_return std::nullopt;
+    }
+    cmlog.debug("Offloading compaction of {} to shard {}: backlog={} remote backlog={}", t, best->shard, local_backlog, best->backlog);
+    co_return best->shard;
+}
+
+future<std::optional<compaction_manager::offloaded_compaction_result>> compaction_manager::run_offloaded_compaction(offloaded_compaction_job job) {
+    // Several shards may have picked this one concurrently. Checking that it is
+    // still idle and registering the job happen without a preemption point in
+    // between, so only one of them gets to run its job here.
+    if (!offload_candidate_backlog(job.table, job.group_id)) {
+        co_return std::nullopt;
+    }
+    auto it = std::ranges::find_if(_compaction_state, [this, &job] (auto& e) {
+        return e.first->schema()->id() == job.table && e.first->get_group_id() == job.group_id && can_proceed(e.first);
+    });
+    if (it == _compaction_state.end()) {
+        co_return std::nullopt;
+    }
+    table_state& t = *it->first;
+    auto holder = it->second.gate.hold();
+    // Register before the first preemption point, so a stop request forwarded by
+    // the owner right after submitting the job can find it.
+    auto cdata = create_compaction_data();
+    _offloaded_compactions.emplace(job.id, offloaded_compaction{&t, &cdata});
+    auto deregister = defer([this, id = job.id] () noexcept {
+        _offloaded_compactions.erase(id);
+    });
+
+    co_await coroutine::switch_to(compaction_sg());
+
+    std::vector<sstables::shared_sstable> sstables;
+    sstables.reserve(job.sstables.size());
+    for (auto& info : job.sstables) {
+        sstables.push_back(co_await t.load_foreign_sstable(std::move(info)));
+    }
+    sstables::compaction_descriptor descriptor(std::move(sstables), job.level, job.max_sstable_bytes, job.run_identifier);
+    descriptor.can_split_large_partition = job.can_split_large_partition;
+    descriptor.output_shard = job.owner;
+    descriptor.creator = [&t] (shard_id) {
+        return t.make_sstable();
+    };
+    // The owner replaces the input sstables once it loads the new ones.
+    descriptor.replacer = [] (sstables::compaction_completion_desc) {};
+
+    offloaded_compaction_table_state offloaded_t(t);
+    sstables::compaction_progress_monitor progress_monitor;
+    auto res = co_await sstables::compact_sstables(std::move(descriptor), cdata, offloaded_t, progress_monitor);
+
+    offloaded_compaction_result ret{
+        .stats = std::move(res.stats),
+        .compaction_uuid = cdata.compaction_uuid,
+        .compaction_size = cdata.compaction_size,
+        .total_partitions = cdata.total_partitions,
+        .total_keys_written = cdata.total_keys_written,
+    };
+    std::exception_ptr ex;
+    try {
+        ret.new_sstables.reserve(res.new_sstables.size());
+        for (auto& sst : res.new_sstables) {
+            ret.new_sstables.push_back(co_await sst->get_open_info());
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        for (auto& sst : res.new_sstables) {
+            sst->mark_for_deletion();
+        }
+        co_return coroutine::exception(std::move(ex));
+    }
+    co_return ret;
+}
+
+void compaction_manager::stop_offloaded_compaction(tasks::task_id id, sstring reason) noexcept {
+    if (auto it = _offloaded_compactions.find(id); it != _offloaded_compactions.end()) {
+        it->second.cdata->stop(std::move(reason));
+    }
+}
+
 future<> compaction_task_executor::perform() {
     _stats = co_await _cm.perform_task(shared_from_this(), _do_throw_if_stopping);
 }
@@ -1300,7 +1503,7 @@ class regular_compaction_task_executor : public compaction_task_executor, public
 
             try {
                 bool should_update_history = this->should_update_history(descriptor.options.type());
-                sstables::compaction_result res = co_await compact_sstables(std::move(descriptor), _compaction_data, on_replace);
+                sstables::compaction_result res = co_await compact_sstables_maybe_offloaded(std::move(descriptor), on_replace);
                 finish_compaction();
                 if (should_update_history) {
                     // update_history can take a long time compared to
@@ -1332,6 +1535,125 @@ class regular_compaction_task_executor : public compaction_task_executor, public
 
         co_return std::nullopt;
     }
+private:
+    // Runs the compaction on an idle shard if the local backlog is much higher than its
+    // backlog, falling back to compacting locally if that fails. Compactions doing cleanup
+    // or replacing exhausted sstables incrementally always run locally.
+    future<sstables::compaction_result> compact_sstables_maybe_offloaded(sstables::compaction_descriptor descriptor, on_replacement& on_replace) {
+        table_state& t = *_compacting_table;
+        const auto& cs = _cm.get_compaction_state(&t);
+        bool offloadable = !descriptor.owned_ranges
+                && !descriptor.has_only_fully_expired
+                && descriptor.fan_in() == descriptor.sstables.size()
+                && std::ranges::none_of(descriptor.sstables, [&cs] (const sstables::shared_sstable& sst) {
+                    return cs.sstables_requiring_cleanup.contains(sst);
+                });
+        std::optional<shard_id> shard;
+        if (offloadable) {
+            shard = co_await _cm.pick_offload_shard(t);
+        }
+        if (shard) {
+            auto res = co_await coroutine::as_future(compact_sstables_on_shard(*shard, descriptor));
+            if (!res.failed()) {
+                auto ret = res.get();
+                if (ret) {
+                    co_await replace_sstables(sstables::compaction_completion_desc{
+                        .old_sstables = descriptor.sstables,
+                        .new_sstables = ret->new_sstables,
+                    }, on_replace, sstables::offstrategy::no);
+                    _cm._stats.offloaded_tasks++;
+                    co_return std::move(*ret);
+                }
+                cmlog.debug("{}: shard {} declined the offloaded compaction. Compacting locally", *this, *shard);
+            } else {
+                auto ex = res.get_exception();
+                if (stopping()) {
+                    co_return coroutine::exception(std::move(ex));
+                }
+                cmlog.warn("{}: compaction offloaded to shard {} failed: {}. Compacting locally", *this, *shard, ex);
+            }
+        }
+        co_return co_await compact_sstables(std::move(descriptor), _compaction_data, on_replace);
+    }
+
+    // Compacts the sstables of the descriptor on the given shard and loads the new
+    // sstables written there. Replacing the input sstables is left to the caller.
+    // Returns std::nullopt if the shard declined the job.
+    future<std::optional<sstables::compaction_result>> compact_sstables_on_shard(shard_id shard, const sstables::compaction_descriptor& descriptor) {
+        table_state& t = *_compacting_table;
+        compaction_manager::offloaded_compaction_job job{
+            .table = t.schema()->id(),
+            .group_id = t.get_group_id(),
+            .id = _status.id,
+            .owner = this_shard_id(),
+            .level = descriptor.level,
+            .max_sstable_bytes = descriptor.max_sstable_bytes,
+            .can_split_large_partition = descriptor.can_split_large_partition,
+            .run_identifier = descriptor.run_identifier,
+        };
+        job.sstables.reserve(descriptor.sstables.size());
+        for (const auto& sst : descriptor.sstables) {
+            job.sstables.push_back(co_await sst->get_open_info());
+        }
+        if (stopping()) {
+            throw make_compaction_stopped_exception();
+        }
+
+        auto result_fut = _cm.container().invoke_on(shard, [job = std::move(job)] (compaction_manager& cm) mutable {
+            return cm.run_offloaded_compaction(std::move(job));
+        });
+        // Stop requests are forwarded to the shard running the compaction. Messages
+        // between two shards are delivered in order, so the job is registered there
+        // by the time the stop request arrives.
+        std::optional<future<>> stop_forwarded;
+        auto stop_subscription = _compaction_data.abort.subscribe([this, shard, &stop_forwarded] () noexcept {
+            stop_forwarded = futurize_invoke([this, shard] {
+                return _cm.container().invoke_on(shard, [id = _status.id, reason = _compaction_data.stop_requested] (compaction_manager& cm) {
+                    cm.stop_offloaded_compaction(id, reason);
+                });
+            });
+        });
+        auto result = co_await coroutine::as_future(std::move(result_fut));
+        stop_subscription = std::nullopt;
+        if (stop_forwarded) {
+            co_await std::move(*stop_forwarded).handle_exception([] (std::exception_ptr) {});
+        }
+        auto res_opt = result.get();
+        if (!res_opt) {
+            co_return std::nullopt;
+        }
+        auto& res = *res_opt;
+
+        std::vector<sstables::shared_sstable> new_sstables;
+        new_sstables.reserve(res.new_sstables.size());
+        std::exception_ptr ex;
+        try {
+            for (auto& info : res.new_sstables) {
+                new_sstables.push_back(co_await t.load_foreign_sstable(std::move(info)));
+            }
+            if (stopping()) {
+                throw make_compaction_stopped_exception();
+            }
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        if (ex) {
+            for (auto& sst : new_sstables) {
+                sst->mark_for_deletion();
+            }
+            co_return coroutine::exception(std::move(ex));
+        }
+
+        _compaction_data.compaction_uuid = res.compaction_uuid;
+        _compaction_data.compaction_size = res.compaction_size;
+        _compaction_data.total_partitions = res.total_partitions;
+        _compaction_data.total_keys_written = res.total_keys_written;
+        cmlog.info("{}: compacted {} sstable(s) into {} on shard {}", *this, descriptor.sstables.size(), new_sstables.size(), shard);
+        co_return sstables::compaction_result{
+            .new_sstables = std::move(new_sstables),
+            .stats = std::move(res.stats),
+        };
+    }
 };
 
 }
@@ -16,6 +16,7 @@
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/condition-variable.hh>
+#include <seastar/core/sharded.hh>
 #include "sstables/shared_sstable.hh"
 #include "utils/exponential_backoff_retry.hh"
 #include "utils/updateable_value.hh"
@@ -61,7 +62,7 @@ inline owned_ranges_ptr make_owned_ranges_ptr(dht::token_range_vector&& ranges)
 }
 // Compaction manager provides facilities to submit and track compaction jobs on
 // behalf of existing tables.
-class compaction_manager {
+class compaction_manager : public peering_sharded_service<compaction_manager> {
 public:
     using compaction_stats_opt = std::optional<sstables::compaction_stats>;
     struct stats {
@@ -69,6 +70,7 @@ class compaction_manager {
         int64_t completed_tasks = 0;
         uint64_t active_tasks = 0; // Number of compaction going on.
         int64_t errors = 0;
+        uint64_t offloaded_tasks = 0; // Number of regular compactions run on another shard.
     };
     using scheduling_group = backlog_controller::scheduling_group;
     struct config {
@@ -78,6 +80,9 @@ class compaction_manager {
         utils::updateable_value<float> static_shares = utils::updateable_value<float>(0);
         utils::updateable_value<uint32_t> throughput_mb_per_sec = utils::updateable_value<uint32_t>(0);
         std::chrono::seconds flush_all_tables_before_major = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::days(1));
+        // Regular compactions are offloaded to an idle shard whose backlog is this many times
+        // lower than the local one. 0 disables offloading.
+        utils::updateable_value<float> work_stealing_backlog_ratio = utils::updateable_value<float>(0);
     };
 
 public:
@@ -129,6 +134,14 @@ class compaction_manager {
 
     std::unordered_map<compaction::table_state*, compaction_state> _compaction_state;
 
+    // Regular compactions running on this shard on behalf of another shard, keyed by the
+    // id of the offloading task, so that stop requests can be forwarded to them.
+    struct offloaded_compaction {
+        compaction::table_state* table;
+        sstables::compaction_data* cdata;
+    };
+    std::unordered_map<tasks::task_id, offloaded_compaction> _offloaded_compactions;
+
     // Purpose is to serialize all maintenance (non regular) compaction activity to reduce aggressiveness and space requirement.
     // If the operation must be serialized with regular, then the per-table write lock must be taken.
     seastar::named_semaphore _maintenance_ops_sem = {1, named_semaphore_exception_factory{"maintenance operation"}};
@@ -248,6 +261,22 @@ class compaction_manager {
     // Propagate replacement of sstables to all ongoing compaction of a given table
     void propagate_replacement(compaction::table_state& t, const std::vector<sstables::shared_sstable>& removed, const std::vector<sstables::shared_sstable>& added);
 
+    struct offloaded_compaction_job;
+    struct offloaded_compaction_result;
+
+    // Returns the compaction backlog of this shard if it is idle and can run
+    // compactions of the given compaction group on behalf of another shard.
+    std::optional<double> offload_candidate_backlog(table_id id, const std::string& group_id);
+    // Picks an idle shard to run a regular compaction of t on, if the local backlog
+    // exceeds its backlog by more than the configured work stealing ratio.
+    future<std::optional<shard_id>> pick_offload_shard(compaction::table_state& t);
+    // Runs a regular compaction on behalf of another shard. The new sstables are
+    // written for the owner shard, which loads them and replaces the inputs.
+    // Returns std::nullopt if this shard is no longer idle, e.g. because another
+    // shard offloaded a compaction to it meanwhile.
+    future<std::optional<offloaded_compaction_result>> run_offloaded_compaction(offloaded_compaction_job job);
+    void stop_offloaded_compaction(tasks::task_id id, sstring reason) noexcept;
+
     // This constructor is supposed to only be used for testing so lets be more explicit
     // about invoking it. Ref #10146
     compaction_manager(tasks::task_manager& tm);
@@ -548,6 +577,8 @@ class compaction_task_executor
     future<sstables::compaction_result> compact_sstables(sstables::compaction_descriptor descriptor, sstables::compaction_data& cdata, on_replacement&,
                                 compaction_manager::can_purge_tombstones can_purge = compaction_manager::can_purge_tombstones::yes,
                                 sstables::offstrategy offstrategy = sstables::offstrategy::no);
+    // Replaces the compacted sstables with the new ones in the table.
+    future<> replace_sstables(sstables::compaction_completion_desc desc, on_replacement&, sstables::offstrategy offstrategy);
     future<> update_history(::compaction::table_state& t, const sstables::compaction_result& res, const sstables::compaction_data& cdata);
     bool should_update_history(sstables::compaction_type ct) {
         return ct == sstables::compaction_type::Compaction;
@@ -72,6 +72,20 @@ bool compaction_strategy_impl::worth_dropping_tombstones(const shared_sstable& s
     return droppable_ratio >= _tombstone_threshold;
 }
 
+compaction_descriptor compaction_strategy_impl::make_tombstone_compaction_job(const shared_sstable& sst, gc_clock::time_point compaction_time,
+        const table_state& t, int level) const {
+    // Isolating more than this fraction of the partitions isn't worth the
+    // additional sstables.
+    static constexpr double max_isolated_partitions_fraction = 0.5;
+
+    auto desc = compaction_descriptor({ sst }, level);
+    auto droppable = sst->estimate_droppable_tombstone_ranges(compaction_time, t.get_tombstone_gc_state(), t.schema(), _tombstone_threshold);
+    if (!droppable.ranges.empty() && droppable.partitions_fraction <= max_isolated_partitions_fraction) {
+        desc.isolated_token_ranges = std::move(droppable.ranges);
+    }
+    return desc;
+}
+
 uint64_t compaction_strategy_impl::adjust_partition_estimate(const mutation_source_metadata& ms_meta, uint64_t partition_estimate, schema_ptr schema) const {
     return partition_estimate;
 }
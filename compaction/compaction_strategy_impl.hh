@@ -66,6 +66,13 @@ class compaction_strategy_impl {
     // droppable tombstone histogram and gc_before.
     bool worth_dropping_tombstones(const shared_sstable& sst, gc_clock::time_point compaction_time, const table_state& t);
 
+    // Makes a job compacting a single sstable to drop its tombstones.
+    // If most of the droppable tombstones sit in a small part of the sstable's
+    // token range, that part is written into sstables of its own, so later
+    // tombstone compactions of it don't rewrite the rest of the data.
+    compaction_descriptor make_tombstone_compaction_job(const shared_sstable& sst, gc_clock::time_point compaction_time, const table_state& t,
+            int level = compaction_descriptor::default_level) const;
+
     virtual std::unique_ptr<compaction_backlog_tracker::impl> make_backlog_tracker() const = 0;
 
     virtual uint64_t adjust_partition_estimate(const mutation_source_metadata& ms_meta, uint64_t partition_estimate, schema_ptr schema) const;
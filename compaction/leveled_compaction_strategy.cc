@@ -62,7 +62,7 @@ compaction_descriptor leveled_compaction_strategy::get_sstables_for_compaction(t
             auto ratio_j = j->estimate_droppable_tombstone_ratio(compaction_time, table_s.get_tombstone_gc_state(), table_s.schema());
             return ratio_i < ratio_j;
         });
-        return sstables::compaction_descriptor({ sst }, sst->get_sstable_level());
+        return make_tombstone_compaction_job(sst, compaction_time, table_s, sst->get_sstable_level());
     }
     return {};
 }
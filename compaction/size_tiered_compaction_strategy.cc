@@ -9,6 +9,7 @@
 #include "utils/assert.hh"
 #include "sstables/sstables.hh"
 #include "size_tiered_compaction_strategy.hh"
+#include "compaction.hh"
 #include "cql3/statements/property_definitions.hh"
 
 #include <boost/range/adaptor/reversed.hpp>
@@ -203,11 +204,22 @@ size_tiered_compaction_strategy::most_interesting_bucket(std::vector<std::vector
     }
 
     // Pick the bucket with more elements, as efficiency of same-tier compactions increases with number of files.
-    auto& max = *std::max_element(pruned_buckets.begin(), pruned_buckets.end(), [] (const bucket_t& i, const bucket_t& j) {
-        // FIXME: ignoring hotness by the time being.
-        return i.size() < j.size();
-    });
-    return std::move(max);
+    auto max_size = std::ranges::max(pruned_buckets | std::views::transform([] (const bucket_t& b) { return b.size(); }));
+    std::erase_if(pruned_buckets, [max_size] (const bucket_t& b) { return b.size() < max_size; });
+    if (pruned_buckets.size() == 1) {
+        return std::move(pruned_buckets.front());
+    }
+    // Among buckets with as many elements, pick the one whose sstables overlap the most,
+    // as it reclaims the most space per byte written. Buckets whose overlap can't be
+    // estimated are assumed to have none.
+    // FIXME: ignoring hotness by the time being.
+    auto deduplication_ratio = [] (const bucket_t& b) {
+        auto overlap = estimate_partition_overlap(b);
+        return overlap ? overlap->deduplication_ratio() : 0.0;
+    };
+    auto ratios = pruned_buckets | std::views::transform(deduplication_ratio) | std::ranges::to<std::vector<double>>();
+    auto max = std::ranges::max_element(ratios);
+    return std::move(pruned_buckets[std::distance(ratios.begin(), max)]);
 }
 
 compaction_descriptor
@@ -254,7 +266,7 @@ size_tiered_compaction_strategy::get_sstables_for_compaction(table_state& table_
         auto it = std::min_element(sstables.begin(), sstables.end(), [] (auto& i, auto& j) {
             return i->get_stats_metadata().min_timestamp < j->get_stats_metadata().min_timestamp;
         });
-        return sstables::compaction_descriptor({ *it });
+        return make_tombstone_compaction_job(*it, compaction_time, table_s);
     }
     return sstables::compaction_descriptor();
 }
@@ -22,6 +22,7 @@ class sstable_set;
 class compaction_strategy;
 class sstables_manager;
 struct sstable_writer_config;
+struct foreign_sstable_open_info;
 }
 
 namespace compaction {
@@ -47,6 +48,8 @@ class table_state {
     virtual reader_permit make_compaction_reader_permit() const = 0;
     virtual sstables::sstables_manager& get_sstables_manager() noexcept = 0;
     virtual sstables::shared_sstable make_sstable() const = 0;
+    // Loads an sstable of this table that was opened on another shard.
+    virtual future<sstables::shared_sstable> load_foreign_sstable(sstables::foreign_sstable_open_info info) const = 0;
     virtual sstables::sstable_writer_config configure_writer(sstring origin) const = 0;
     virtual api::timestamp_type min_memtable_timestamp() const = 0;
     virtual api::timestamp_type min_memtable_live_timestamp() const = 0;
@@ -101,6 +101,14 @@ class compression_parameters {
     int32_t chunk_length() const { return _chunk_length.value_or(int(DEFAULT_CHUNK_LENGTH)); }
     double crc_check_chance() const { return _crc_check_chance.value_or(double(DEFAULT_CRC_CHECK_CHANCE)); }
 
+    // Returns a copy of these parameters with the given chunk length,
+    // which must satisfy the same constraints as the chunk_length_in_kb option.
+    compression_parameters with_chunk_length(int32_t chunk_length) const {
+        auto ret = *this;
+        ret._chunk_length = chunk_length;
+        return ret;
+    }
+
     void validate();
     std::map<sstring, sstring> get_options() const;
     bool operator==(const compression_parameters& other) const;
@@ -536,6 +536,7 @@ scylla_tests = set([
     'test/boost/mvcc_test',
     'test/boost/network_topology_strategy_test',
     'test/boost/nonwrapping_interval_test',
+    'test/boost/object_storage_cache_test',
     'test/boost/observable_test',
     'test/boost/partitioner_test',
     'test/boost/per_partition_rate_limit_test',
@@ -847,6 +848,7 @@ scylla_core = (['message/messaging_service.cc',
                 'sstables/sstables_manager.cc',
                 'sstables/sstable_set.cc',
                 'sstables/storage.cc',
+                'sstables/object_storage_cache.cc',
                 'sstables/mx/partition_reversing_data_source.cc',
                 'sstables/mx/reader.cc',
                 'sstables/mx/writer.cc',
@@ -868,6 +870,7 @@ scylla_core = (['message/messaging_service.cc',
                 'sstables/sstable_directory.cc',
                 'sstables/random_access_reader.cc',
                 'sstables/metadata_collector.cc',
+                'sstables/row_filter.cc',
                 'sstables/writer.cc',
                 'transport/cql_protocol_extension.cc',
                 'transport/event.cc',
@@ -111,6 +111,20 @@ class cql_statement {
     virtual bool is_conditional() const {
         return false;
     }
+
+    /**
+     * Returns the shard which has to execute the statement with the given options,
+     * if the statement is bound to one (e.g. a lightweight transaction must run on
+     * the shard owning its partition) and the shard can be computed without
+     * executing the statement. Returns std::nullopt otherwise, including when the
+     * options are invalid; execution will then report the error.
+     *
+     * Values of non-deterministic functions in the partition key evaluated while
+     * computing the shard are cached in the options.
+     */
+    virtual std::optional<unsigned> execution_shard(const query_options& options) const {
+        return std::nullopt;
+    }
 };
 
 class cql_statement_no_metadata : public cql_statement {
@@ -81,6 +81,33 @@ uint32_t batch_statement::get_bound_terms() const
     return _bound_terms;
 }
 
+std::optional<unsigned> batch_statement::execution_shard(const query_options& options) const
+{
+    if (!_has_conditions) {
+        return std::nullopt;
+    }
+    try {
+        // Like execute_with_conditions(), the shard is the one owning the first partition.
+        for (size_t i = 0; i < _statements.size(); ++i) {
+            const modification_statement& statement = *_statements[i].statement;
+            const query_options& statement_options = options.for_statement(i);
+            auto keys = statement.build_partition_keys(statement_options, statement.maybe_prepare_json_cache(statement_options));
+            if (keys.empty()) {
+                continue;
+            }
+            for (auto&& [id, value] : statement_options.cached_pk_function_calls()) {
+                options.cache_pk_function_call(id, value);
+            }
+            if (keys.size() != 1 || !query::is_single_partition(keys.front())) {
+                return std::nullopt;
+            }
+            return service::storage_proxy::cas_shard(*statement.s, keys.front().start()->value().as_decorated_key().token());
+        }
+    } catch (...) {
+    }
+    return std::nullopt;
+}
+
 future<> batch_statement::check_access(query_processor& qp, const service::client_state& state) const
 {
     return parallel_for_each(_statements.begin(), _statements.end(), [&qp, &state](auto&& s) {
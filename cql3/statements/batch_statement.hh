@@ -98,6 +98,8 @@ class batch_statement : public cql_statement_opt_metadata {
 
     bool has_conditions() const { return _has_conditions; }
 
+    virtual std::optional<unsigned> execution_shard(const query_options& options) const override;
+
     void build_cas_result_set_metadata();
 
     // The batch itself will be validated in either Parsed#prepare() - for regular CQL3 batches,
@@ -747,6 +747,21 @@ bool modification_statement::is_conditional() const {
     return has_conditions();
 }
 
+std::optional<unsigned> modification_statement::execution_shard(const query_options& options) const {
+    if (!has_conditions()) {
+        return std::nullopt;
+    }
+    try {
+        auto keys = build_partition_keys(options, maybe_prepare_json_cache(options));
+        if (keys.size() != 1 || !query::is_single_partition(keys.front())) {
+            return std::nullopt;
+        }
+        return service::storage_proxy::cas_shard(*s, keys.front().start()->value().as_decorated_key().token());
+    } catch (...) {
+        return std::nullopt;
+    }
+}
+
 void modification_statement::analyze_condition(expr::expression cond) {
   expr::for_each_expression<expr::column_value>(cond, [&] (const expr::column_value& col) {
     if (col.col->is_static()) {
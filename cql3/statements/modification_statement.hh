@@ -146,6 +146,8 @@ class modification_statement : public cql_statement_opt_metadata {
 
     bool is_conditional() const override;
 
+    virtual std::optional<unsigned> execution_shard(const query_options& options) const override;
+
 public:
     void analyze_condition(expr::expression cond);
 
@@ -252,6 +252,21 @@ bool select_statement::depends_on(std::string_view ks_name, std::optional<std::s
     return keyspace() == ks_name && (!cf_name || column_family() == *cf_name);
 }
 
+std::optional<unsigned> select_statement::execution_shard(const query_options& options) const {
+    if (!db::is_serial_consistency(options.get_consistency())) {
+        return std::nullopt;
+    }
+    try {
+        auto key_ranges = _restrictions->get_partition_key_ranges(options);
+        if (key_ranges.size() != 1 || !query::is_single_partition(key_ranges.front())) {
+            return std::nullopt;
+        }
+        return _schema->table().shard_for_reads(key_ranges.front().start()->value().as_decorated_key().token());
+    } catch (...) {
+        return std::nullopt;
+    }
+}
+
 const sstring& select_statement::keyspace() const {
     return _schema->ks_name();
 }
@@ -17,11 +17,14 @@
 
 #include <seastar/core/future.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/coroutine/parallel_for_each.hh>
+#include <seastar/core/loop.hh>
 
 #include "commitlog.hh"
 #include "commitlog_replayer.hh"
 #include "replica/database.hh"
 #include "db/system_keyspace.hh"
+#include "db/config.hh"
 #include "utils/log.hh"
 #include "converting_mutation_partition_applier.hh"
 #include "commitlog_entry.hh"
@@ -79,7 +82,46 @@ class db::commitlog_replayer::impl {
         return _column_mappings.stop();
     }
 
-    future<> process(stats*, commitlog::buffer_and_replay_position buf_rp) const;
+    // A mutation read from the log, to be applied on one of its shards.
+    struct pending_mutation {
+        frozen_mutation fm;
+        const column_mapping* cm; // owned by the reading shard's _column_mappings
+        replay_position rp;
+    };
+
+    // Collects the mutations read from a segment per owning shard and
+    // applies them in batches, so replay pays one cross-shard round trip per
+    // batch instead of one per mutation, and the mutations of a batch are
+    // applied concurrently. Replay order does not matter: mutations are
+    // merged by timestamp.
+    //
+    // The mutations held across all shards are bounded by size, so that
+    // replaying several segments at once with large mutations doesn't run
+    // the shard out of memory.
+    class apply_batcher {
+        const impl& _impl;
+        stats& _stats;
+        std::vector<std::vector<pending_mutation>> _pending;
+        size_t _pending_bytes = 0;
+    public:
+        static constexpr size_t max_batch_size = 128;
+        static constexpr size_t max_pending_bytes = 1 << 20;
+
+        apply_batcher(const impl& impl, stats& s)
+            : _impl(impl)
+            , _stats(s)
+            , _pending(smp::count)
+        {}
+        stats& get_stats() {
+            return _stats;
+        }
+        future<> add(shard_id, pending_mutation);
+        future<> flush(shard_id);
+        future<> flush_all();
+    };
+
+    future<> process(apply_batcher&, commitlog::buffer_and_replay_position buf_rp) const;
+    future<> apply(replica::database&, const pending_mutation&) const;
     future<stats> recover(const commitlog::descriptor&, const commitlog::replay_state&) const;
 
     typedef std::unordered_map<table_id, replay_position> rp_map;
@@ -182,25 +224,71 @@ db::commitlog_replayer::impl::recover(const commitlog::descriptor& d, const comm
     }
 
     auto s = make_lw_shared<stats>();
+    auto batcher = make_lw_shared<apply_batcher>(*this, *s);
     auto& exts = _db.local().extensions();
 
     return db::commitlog::read_log_file(rpstate, f, d.filename_prefix,
-            std::bind(&impl::process, this, s.get(), std::placeholders::_1),
-            p, &exts).then_wrapped([s](future<> f) {
-        try {
-            f.get();
-        } catch (commitlog::segment_data_corruption_error& e) {
-            s->corrupt_bytes += e.bytes();
-        } catch (commitlog::segment_truncation& e) {
-            s->truncated_at = e.position();
-        } catch (...) {
-            throw;
-        }
-        return make_ready_future<stats>(*s);
+            std::bind(&impl::process, this, std::ref(*batcher), std::placeholders::_1),
+            p, &exts).then_wrapped([s, batcher](future<> f) {
+        // Whatever was read before an error is still applied.
+        return batcher->flush_all().then([s, batcher, f = std::move(f)] () mutable {
+            try {
+                f.get();
+            } catch (commitlog::segment_data_corruption_error& e) {
+                s->corrupt_bytes += e.bytes();
+            } catch (commitlog::segment_truncation& e) {
+                s->truncated_at = e.position();
+            } catch (...) {
+                throw;
+            }
+            return make_ready_future<stats>(*s);
+        });
     });
 }
 
-future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_replay_position buf_rp) const {
+future<> db::commitlog_replayer::impl::apply_batcher::add(shard_id shard, pending_mutation pm) {
+    auto& batch = _pending[shard];
+    _pending_bytes += pm.fm.representation().size();
+    batch.push_back(std::move(pm));
+    if (_pending_bytes >= max_pending_bytes) {
+        co_await flush_all();
+    } else if (batch.size() >= max_batch_size) {
+        co_await flush(shard);
+    }
+}
+
+future<> db::commitlog_replayer::impl::apply_batcher::flush(shard_id shard) {
+    auto batch = std::exchange(_pending[shard], {});
+    if (batch.empty()) {
+        co_return;
+    }
+    for (auto& pm : batch) {
+        _pending_bytes -= pm.fm.representation().size();
+    }
+    _stats += co_await _impl._db.invoke_on(shard, [this, &batch] (replica::database& db) -> future<stats> {
+        stats s;
+        co_await coroutine::parallel_for_each(batch, [this, &db, &s] (const pending_mutation& pm) -> future<> {
+            try {
+                co_await _impl.apply(db, pm);
+                s.applied_mutations++;
+            } catch (...) {
+                s.invalid_mutations++;
+                // TODO: write mutation to file like origin.
+                rlogger.warn("error replaying: {}", std::current_exception());
+            }
+        });
+        co_return s;
+    });
+}
+
+future<> db::commitlog_replayer::impl::apply_batcher::flush_all() {
+    for (shard_id shard = 0; shard < _pending.size(); ++shard) {
+        co_await flush(shard);
+    }
+}
+
+future<> db::commitlog_replayer::impl::process(apply_batcher& batcher, commitlog::buffer_and_replay_position buf_rp) const {
+    auto* s = &batcher.get_stats();
     auto&& buf = buf_rp.buffer;
     auto&& rp = buf_rp.position;
     try {
@@ -247,57 +335,16 @@ future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_r
             co_return;
         }
 
-      auto apply = [&] (seastar::shard_id shard) {
-        return _db.invoke_on(shard, [this, &fm, &src_cm, rp] (replica::database& db) mutable -> future<> {
-            // TODO: might need better verification that the deserialized mutation
-            // is schema compatible. My guess is that just applying the mutation
-            // will not do this.
-            auto& cf = db.find_column_family(fm.column_family_id());
-
-            if (rlogger.is_enabled(logging::log_level::debug)) {
-                rlogger.debug("replaying at {} v={} {}:{} at {}", fm.column_family_id(), fm.schema_version(),
-                        cf.schema()->ks_name(), cf.schema()->cf_name(), rp);
-            }
-            if (const auto err = validation::is_cql_key_invalid(*cf.schema(), fm.key()); err) {
-                throw std::runtime_error(fmt::format("found entry with invalid key {} at {} v={} {}:{} at {}: {}.", fm.key(), fm.column_family_id(),
-                        fm.schema_version(), cf.schema()->ks_name(), cf.schema()->cf_name(), rp, *err));
-            }
-            // Removed forwarding "new" RP. Instead give none/empty.
-            // This is what origin does, and it should be fine.
-            // The end result should be that once sstables are flushed out
-            // their "replay_position" attribute will be empty, which is
-            // lower than anything the new session will produce.
-            if (cf.schema()->version() != fm.schema_version()) {
-                auto& local_cm = _column_mappings.local().map;
-                auto cm_it = local_cm.try_emplace(fm.schema_version(), src_cm).first;
-                const column_mapping& cm = cm_it->second;
-                mutation m(cf.schema(), fm.decorated_key(*cf.schema()));
-                converting_mutation_partition_applier v(cm, *cf.schema(), m.partition());
-                fm.partition().accept(cm, v);
-                return do_with(std::move(m), [&db, &cf] (const mutation& m) {
-                    return db.apply_in_memory(m, cf, db::rp_handle(), db::no_timeout);
-                });
-            } else {
-                return db.apply_in_memory(fm, cf.schema(), db::rp_handle(), db::no_timeout);
-            }
-        }).then_wrapped([s] (future<> f) {
-            try {
-                f.get();
-                s->applied_mutations++;
-            } catch (...) {
-                s->invalid_mutations++;
-                // TODO: write mutation to file like origin.
-                rlogger.warn("error replaying: {}", std::current_exception());
-            }
-        });
-      };
         auto shards = table.get_effective_replication_map()->shard_for_writes(schema, token);
         if (shards.empty()) {
             rlogger.debug("no shard for token {} in table {}", token, uuid);
             s->skipped_mutations++;
-        } else {
-            co_await seastar::parallel_for_each(shards, apply);
+            co_return;
+        }
+        for (auto shard : shards | std::views::drop(1)) {
+            co_await batcher.add(shard, pending_mutation{fm, &src_cm, rp});
         }
+        co_await batcher.add(shards.front(), pending_mutation{std::move(cer).mutation(), &src_cm, rp});
     } catch (replica::no_such_column_family&) {
         // No such CF now? Origin just ignores this.
     } catch (...) {
@@ -307,6 +354,39 @@ future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_r
     }
 }
 
+future<> db::commitlog_replayer::impl::apply(replica::database& db, const pending_mutation& pm) const {
+    // TODO: might need better verification that the deserialized mutation
+    // is schema compatible. My guess is that just applying the mutation
+    // will not do this.
+    auto& fm = pm.fm;
+    auto& cf = db.find_column_family(fm.column_family_id());
+
+    if (rlogger.is_enabled(logging::log_level::debug)) {
+        rlogger.debug("replaying at {} v={} {}:{} at {}", fm.column_family_id(), fm.schema_version(),
+                cf.schema()->ks_name(), cf.schema()->cf_name(), pm.rp);
+    }
+    if (const auto err = validation::is_cql_key_invalid(*cf.schema(), fm.key()); err) {
+        throw std::runtime_error(fmt::format("found entry with invalid key {} at {} v={} {}:{} at {}: {}.", fm.key(), fm.column_family_id(),
+                fm.schema_version(), cf.schema()->ks_name(), cf.schema()->cf_name(), pm.rp, *err));
+    }
+    // Removed forwarding "new" RP. Instead give none/empty.
+    // This is what origin does, and it should be fine.
+    // The end result should be that once sstables are flushed out
+    // their "replay_position" attribute will be empty, which is
+    // lower than anything the new session will produce.
+    if (cf.schema()->version() != fm.schema_version()) {
+        auto& local_cm = _column_mappings.local().map;
+        auto cm_it = local_cm.try_emplace(fm.schema_version(), *pm.cm).first;
+        const column_mapping& cm = cm_it->second;
+        mutation m(cf.schema(), fm.decorated_key(*cf.schema()));
+        converting_mutation_partition_applier v(cm, *cf.schema(), m.partition());
+        fm.partition().accept(cm, v);
+        co_await db.apply_in_memory(m, cf, db::rp_handle(), db::no_timeout);
+    } else {
+        co_await db.apply_in_memory(fm, cf.schema(), db::rp_handle(), db::no_timeout);
+    }
+}
+
 db::commitlog_replayer::commitlog_replayer(seastar::sharded<replica::database>& db, seastar::sharded<db::system_keyspace>& sys_ks)
     : _impl(std::make_unique<impl>(db, sys_ks))
 {}
@@ -350,6 +430,8 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
         }
     }
 
+    const size_t parallelism = std::max(_impl->_db.local().get_config().commitlog_replay_parallelism(), 1u);
+
     co_await _impl->start();
     std::exception_ptr e;
     try {
@@ -357,14 +439,23 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
             co_return co_await smp::submit_to(id, [&] () -> future<impl::stats> {
                 impl::stats total;
                 std::unordered_map<unsigned, commitlog::replay_state> states;
-                // TODO: or something. For now, we do this serialized per shard,
-                // to reduce mutation congestion. We could probably (says avi)
-                // do 2 segments in parallel or something, but lets use this first.
+                // Replay several segments at once, so that reading the log
+                // keeps the disk busy while mutations are being applied.
+                // Entries fragmented across segments are reassembled by the
+                // replay_state regardless of the order segments are read in.
                 auto range = map.equal_range(id);
-                for (auto& [id, d] : std::ranges::subrange(range.first, range.second)) {
+                auto segments = std::ranges::subrange(range.first, range.second)
+                        | std::views::transform([] (auto& p) { return &p.second; })
+                        | std::ranges::to<std::vector<const commitlog::descriptor*>>();
+                std::ranges::sort(segments, std::less(), [] (const commitlog::descriptor* d) { return d->id; });
+                for (auto* d : segments) {
+                    states.try_emplace(replay_position(*d).shard_id());
+                }
+                co_await max_concurrent_for_each(segments, parallelism, [&] (const commitlog::descriptor* dp) -> future<> {
+                    auto& d = *dp;
                     auto f = d.filename();
                     rlogger.debug("Replaying {}", f);
-                    auto stats = co_await _impl->recover(d, states[replay_position(d).shard_id()]);
+                    auto stats = co_await _impl->recover(d, states.at(replay_position(d).shard_id()));
                     if (stats.corrupt_bytes != 0) {
                         rlogger.warn("Corrupted file: {}. {} bytes skipped.", f, stats.corrupt_bytes);
                     }
@@ -378,7 +469,7 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
                                     , stats.skipped_mutations
                     );
                     total += stats;
-                }
+                });
                 co_return total;
             });
         }, impl::stats(), std::plus<impl::stats>());
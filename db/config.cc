@@ -380,14 +380,22 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "true: auto-adjust memtable shares for flush processes")
     , memtable_flush_static_shares(this, "memtable_flush_static_shares", liveness::LiveUpdate, value_status::Used, 0,
         "If set to higher than 0, ignore the controller's output and set the memtable shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity.")
+    , memtable_flush_parallelism(this, "memtable_flush_parallelism", liveness::LiveUpdate, value_status::Used, 1,
+        "Maximum number of sstables a single memtable flush writes concurrently. Large memtables are split by token range into this many sstables (at most one per 64MB of memtable memory), written in parallel to overlap their CPU work and I/O. Set to 1 to flush each memtable into a single sstable.")
     , compaction_static_shares(this, "compaction_static_shares", liveness::LiveUpdate, value_status::Used, 0,
         "If set to higher than 0, ignore the controller's output and set the compaction shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity.")
     , compaction_enforce_min_threshold(this, "compaction_enforce_min_threshold", liveness::LiveUpdate, value_status::Used, false,
         "If set to true, enforce the min_threshold option for compactions strictly. If false (default), Scylla may decide to compact even if below min_threshold.")
+    , compaction_adaptive_chunk_length(this, "compaction_adaptive_chunk_length", liveness::LiveUpdate, value_status::Used, false,
+        "If set to true, compaction picks the compression chunk length of the sstables it writes from the recent reads of the table, instead of using the chunk_length_in_kb compression option. "
+        "Tables read mostly by single-partition queries get small chunks, and tables mostly scanned, or not read at all, get large chunks, which compress better.")
     , compaction_flush_all_tables_before_major_seconds(this, "compaction_flush_all_tables_before_major_seconds", value_status::Used, 86400,
         "Set the minimum interval in seconds between flushing all tables before each major compaction (default is 86400)."
         "This option is useful for maximizing tombstone garbage collection by releasing all active commitlog segments."
         "Set to 0 to disable automatic flushing all tables before major compaction.")
+    , compaction_work_stealing_backlog_ratio(this, "compaction_work_stealing_backlog_ratio", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, a shard whose compaction backlog is larger than this many times the backlog of an idle shard hands its regular compaction jobs over to that shard. "
+        "The new sstables are written by the idle shard and swapped into the owning shard's sstable set. Offloaded compactions don't purge tombstones. Set to 0 (default) to disable.")
     /**
     * @Group Initialization properties
     * @GroupDescription The minimal properties needed for configuring a cluster.
@@ -578,6 +586,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Whether or not to use a hard size limit for commitlog disk usage. Default is true. Enabling this can cause latency spikes, whereas the default can lead to occasional disk usage peaks.\n")
     , commitlog_use_fragmented_entries(this, "commitlog_use_fragmented_entries", value_status::Used, true,
         "Whether or not to allow commitlog entries to fragment across segments, allowing for larger entry sizes.\n")
+    , commitlog_replay_parallelism(this, "commitlog_replay_parallelism", value_status::Used, 4,
+        "The number of commitlog segments each shard replays concurrently on startup. Higher values make replay use more of the disk bandwidth, at the cost of more memory for read buffers.\n")
     /**
     * @Group Compaction settings
     * @GroupDescription Related information: Configuring compaction
@@ -1005,6 +1015,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , unspooled_dirty_soft_limit(this, "unspooled_dirty_soft_limit", value_status::Used, 0.6, "Soft limit of unspooled dirty memory expressed as a portion of the hard limit.")
     , sstable_summary_ratio(this, "sstable_summary_ratio", value_status::Used, 0.0005, "Enforces that 1 byte of summary is written for every N (2000 by default)"
         "bytes written to data file. Value must be between 0 and 1.")
+    , sstable_row_filter_fp_chance(this, "sstable_row_filter_fp_chance", liveness::LiveUpdate, value_status::Used, 1.0,
+        "False-positive chance of the row filter written into newly written sstables of tables with a clustering key. "
+        "The row filter covers the full primary key of every row, and allows single-row reads to skip sstables which don't contain the requested row. "
+        "It costs roughly as much memory per row as the bloom filter costs per partition. Set to 1.0 to disable.")
     , components_memory_reclaim_threshold(this, "components_memory_reclaim_threshold", liveness::LiveUpdate, value_status::Used, .2, "Ratio of available memory for all in-memory components of SSTables in a shard beyond which the memory will be reclaimed from components until it falls back under the threshold. Currently, this limit is only enforced for bloom filters.")
     , large_memory_allocation_warning_threshold(this, "large_memory_allocation_warning_threshold", value_status::Used, size_t(1) << 20, "Warn about memory allocations above this size; set to zero to disable.")
     , enable_deprecated_partitioners(this, "enable_deprecated_partitioners", value_status::Used, false, "Enable the byteordered and random partitioners. These partitioners are deprecated and will be removed in a future version.")
@@ -1104,7 +1118,12 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The server-side timeout for completing Alternator API requests.")
     , alternator_ttl_period_in_seconds(this, "alternator_ttl_period_in_seconds", value_status::Used,
         60*60*24,
-        "The default period for Alternator's expiration scan. Alternator attempts to scan every table within that period.")
+        "The default period for Alternator's expiration scan. Alternator attempts to expire, within that period, the items which are due.")
+    , alternator_ttl_full_scan_period_in_seconds(this, "alternator_ttl_full_scan_period_in_seconds", value_status::Used,
+        0,
+        "The period for Alternator's full scans of tables with TTL enabled. Between full scans, Alternator only reads the items which it "
+        "knows are due to expire, because they were written with an expiration time or seen in a full scan. A full scan finds the items "
+        "this index misses - e.g., after a restart. 0 (the default) means seven times alternator_ttl_period_in_seconds.")
     , alternator_describe_endpoints(this, "alternator_describe_endpoints", liveness::LiveUpdate, value_status::Used,
         "",
         "Overrides the behavior of Alternator's DescribeEndpoints operation. "
@@ -1158,6 +1177,11 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , wasm_udf_memory_limit(this, "wasm_udf_memory_limit", value_status::Used, 2*1024*1024, "How much memory each WASM UDF can allocate at most.")
     , relabel_config_file(this, "relabel_config_file", value_status::Used, "", "Optionally, read relabel config from file.")
     , object_storage_config_file(this, "object_storage_config_file", value_status::Used, "", "Optionally, read object-storage endpoints config from file.")
+    , object_storage_cache_directory(this, "object_storage_cache_directory", value_status::Used, "",
+        "Optionally, keep local copies of the index and data files of sstables stored on object storage in this directory, "
+        "preferably on a fast local device. The copies are kept across restarts.")
+    , object_storage_cache_size_in_mb(this, "object_storage_cache_size_in_mb", value_status::Used, 10240,
+        "The maximum total size of the local copies in object_storage_cache_directory. Least recently read copies are removed to stay within it. Each shard uses an equal share of it.")
     , live_updatable_config_params_changeable_via_cql(this, "live_updatable_config_params_changeable_via_cql", liveness::MustRestart, value_status::Used, true, "If set to true, configuration parameters defined with LiveUpdate can be updated in runtime via CQL (by updating system.config virtual table), otherwise they can't.")
     , auth_superuser_name(this, "auth_superuser_name", value_status::Used, "",
         "Initial authentication super username. Ignored if authentication tables already contain a super user.")
@@ -169,9 +169,12 @@ class config final : public utils::config_file {
     named_value<double> background_writer_scheduling_quota;
     named_value<bool> auto_adjust_flush_quota;
     named_value<float> memtable_flush_static_shares;
+    named_value<uint32_t> memtable_flush_parallelism;
     named_value<float> compaction_static_shares;
     named_value<bool> compaction_enforce_min_threshold;
+    named_value<bool> compaction_adaptive_chunk_length;
     named_value<uint32_t> compaction_flush_all_tables_before_major_seconds;
+    named_value<float> compaction_work_stealing_backlog_ratio;
     named_value<sstring> cluster_name;
     named_value<sstring> listen_address;
     named_value<sstring> listen_interface;
@@ -217,6 +220,7 @@ class config final : public utils::config_file {
     named_value<bool> commitlog_use_o_dsync;
     named_value<bool> commitlog_use_hard_size_limit;
     named_value<bool> commitlog_use_fragmented_entries;
+    named_value<uint32_t> commitlog_replay_parallelism;
     named_value<bool> compaction_preheat_key_cache;
     named_value<uint32_t> concurrent_compactors;
     named_value<uint32_t> in_memory_compaction_limit_in_mb;
@@ -363,6 +367,7 @@ class config final : public utils::config_file {
     named_value<unsigned> murmur3_partitioner_ignore_msb_bits;
     named_value<double> unspooled_dirty_soft_limit;
     named_value<double> sstable_summary_ratio;
+    named_value<double> sstable_row_filter_fp_chance;
     named_value<double> components_memory_reclaim_threshold;
     named_value<size_t> large_memory_allocation_warning_threshold;
     named_value<bool> enable_deprecated_partitioners;
@@ -416,6 +421,7 @@ class config final : public utils::config_file {
     named_value<uint32_t> alternator_streams_time_window_s;
     named_value<uint32_t> alternator_timeout_in_ms;
     named_value<double> alternator_ttl_period_in_seconds;
+    named_value<double> alternator_ttl_full_scan_period_in_seconds;
     named_value<sstring> alternator_describe_endpoints;
 
     named_value<bool> abort_on_ebadf;
@@ -460,6 +466,8 @@ class config final : public utils::config_file {
     named_value<size_t> wasm_udf_memory_limit;
     named_value<sstring> relabel_config_file;
     named_value<sstring> object_storage_config_file;
+    named_value<sstring> object_storage_cache_directory;
+    named_value<uint64_t> object_storage_cache_size_in_mb;
     // wasm_udf_reserved_memory is static because the options in db::config
     // are parsed using seastar::app_template, while this option is used for
     // configuring the Seastar memory subsystem.
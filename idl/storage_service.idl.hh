@@ -26,6 +26,11 @@ struct load_stats final {
     std::unordered_map<::table_id, locator::table_load_stats> tables;
 };
 
+struct table_activity_stats final {
+    double reads_per_second;
+    double writes_per_second;
+};
+
 }
 
 namespace service {
@@ -65,4 +70,5 @@ verb [[cancellable]] tablet_stream_data (raft::server_id dst_id, locator::global
 verb [[cancellable]] tablet_cleanup (raft::server_id dst_id, locator::global_tablet_id);
 verb [[cancellable]] table_load_stats (raft::server_id dst_id) -> locator::load_stats;
 verb [[cancellable]] tablet_repair(raft::server_id dst_id, locator::global_tablet_id);
+verb [[cancellable]] table_activity_stats (raft::server_id dst_id) -> std::unordered_map<::table_id, locator::table_activity_stats>;
 }
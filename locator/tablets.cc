@@ -587,13 +587,72 @@ table_load_stats& table_load_stats::operator+=(const table_load_stats& s) noexce
     return *this;
 }
 
+table_activity_stats& table_activity_stats::operator+=(const table_activity_stats& s) noexcept {
+    reads_per_second += s.reads_per_second;
+    writes_per_second += s.writes_per_second;
+    return *this;
+}
+
 load_stats& load_stats::operator+=(const load_stats& s) {
     for (auto& [id, stats] : s.tables) {
         tables[id] += stats;
     }
+    for (auto& [id, stats] : s.activity) {
+        activity[id] += stats;
+    }
     return *this;
 }
 
+std::unordered_map<table_id, double> get_tablet_load_weights(const tablet_metadata& tm, const load_stats& stats) {
+    enum { size_dim, reads_dim, writes_dim, nr_dims };
+
+    struct table_load {
+        size_t tablet_count;
+        std::array<double, nr_dims> load = {};
+        std::array<bool, nr_dims> known = {};
+    };
+
+    std::unordered_map<table_id, table_load> tables;
+    std::array<double, nr_dims> total_load = {};
+    std::array<size_t, nr_dims> total_tablets = {};
+
+    for (auto&& [table, tmap] : tm.all_tables()) {
+        auto& t = tables[table];
+        t.tablet_count = std::max(tmap->tablet_count(), size_t(1));
+        if (auto i = stats.tables.find(table); i != stats.tables.end()) {
+            t.load[size_dim] = i->second.size_in_bytes;
+            t.known[size_dim] = true;
+        }
+        if (auto i = stats.activity.find(table); i != stats.activity.end()) {
+            t.load[reads_dim] = i->second.reads_per_second;
+            t.load[writes_dim] = i->second.writes_per_second;
+            t.known[reads_dim] = t.known[writes_dim] = true;
+        }
+        for (int d = 0; d < nr_dims; ++d) {
+            if (t.known[d]) {
+                total_load[d] += t.load[d];
+                total_tablets[d] += t.tablet_count;
+            }
+        }
+    }
+
+    std::unordered_map<table_id, double> weights;
+    for (auto&& [table, t] : tables) {
+        // The tablet count dimension, every tablet weighs the same in it.
+        double weight = 1;
+        for (int d = 0; d < nr_dims; ++d) {
+            auto avg_tablet_load = total_tablets[d] ? total_load[d] / total_tablets[d] : 0;
+            if (t.known[d] && avg_tablet_load > 0) {
+                weight += (t.load[d] / t.tablet_count) / avg_tablet_load;
+            } else {
+                weight += 1;
+            }
+        }
+        weights[table] = weight / (nr_dims + 1);
+    }
+    return weights;
+}
+
 tablet_range_splitter::tablet_range_splitter(schema_ptr schema, const tablet_map& tablets, host_id host, const dht::partition_range_vector& ranges)
     : _schema(std::move(schema))
     , _ranges(ranges)
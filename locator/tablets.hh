@@ -314,6 +314,17 @@ struct resize_decision {
     seq_number_t next_sequence_number() const;
 };
 
+// Rates of requests served by replicas of a table.
+struct table_activity_stats {
+    double reads_per_second = 0;
+    double writes_per_second = 0;
+
+    table_activity_stats& operator+=(const table_activity_stats& s) noexcept;
+    friend table_activity_stats operator+(table_activity_stats a, const table_activity_stats& b) {
+        return a += b;
+    }
+};
+
 struct table_load_stats {
     uint64_t size_in_bytes = 0;
     // Stores the minimum seq number among all replicas, as coordinator wants to know if
@@ -329,6 +340,9 @@ struct table_load_stats {
 
 struct load_stats {
     std::unordered_map<table_id, table_load_stats> tables;
+    // Only reported by nodes which support the TABLET_LOAD_STATS_ACTIVITY feature,
+    // so it can be missing for some or all tables.
+    std::unordered_map<table_id, table_activity_stats> activity;
 
     load_stats& operator+=(const load_stats& s);
     friend load_stats operator+(load_stats a, const load_stats& b) {
@@ -346,6 +360,18 @@ struct repair_scheduler_config {
 
 using load_stats_ptr = lw_shared_ptr<const load_stats>;
 
+class tablet_metadata;
+
+/// Computes the relative load which a single replica of a tablet of a given table puts on a shard.
+///
+/// Each dimension of load (disk space, reads/s, writes/s) is divided evenly among tablets of a table,
+/// and normalized against the average tablet replica in the cluster. The weight of a tablet is the mean of
+/// its normalized dimensions and of the tablet count dimension, so a tablet with average load
+/// in all dimensions weighs 1, and the weight is always positive.
+///
+/// Tables which have no statistics in the load_stats are given the weight of 1.
+std::unordered_map<table_id, double> get_tablet_load_weights(const tablet_metadata&, const load_stats&);
+
 /// Stores information about tablets of a single table.
 ///
 /// The map contains a constant number of tablets, tablet_count().
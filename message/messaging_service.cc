@@ -635,6 +635,7 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::TABLET_CLEANUP:
     case messaging_verb::TABLET_REPAIR:
     case messaging_verb::TABLE_LOAD_STATS:
+    case messaging_verb::TABLE_ACTIVITY_STATS:
         return 1;
     case messaging_verb::CLIENT_ID:
     case messaging_verb::MUTATION:
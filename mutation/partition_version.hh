@@ -617,6 +617,14 @@ class partition_entry {
                const schema& mp_schema,
                mutation_application_stats& app_stats);
 
+    // Like the above, but consumes mp instead of copying it.
+    void apply(logalloc::region&,
+               mutation_cleaner&,
+               const schema& s,
+               mutation_partition&& mp,
+               const schema& mp_schema,
+               mutation_application_stats& app_stats);
+
     // Adds mutation_partition represented by "pe" to the one represented
     // by this entry.
     // This entry must be evictable.
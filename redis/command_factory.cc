@@ -11,6 +11,8 @@
 #include "redis/commands.hh"
 #include "utils/log.hh"
 
+#include <unordered_set>
+
 namespace redis {
 
 static logging::logger logging("command_factory");
@@ -22,10 +24,12 @@ future<redis_message> command_factory::create_execute(service::storage_proxy& pr
         { "ping", commands::ping },
         { "select", commands::select },
         { "get", commands::get },
+        { "mget", commands::mget },
         { "exists", commands::exists },
         { "ttl", commands::ttl },
         { "strlen", commands::strlen },
         { "set", commands::set },
+        { "mset", commands::mset },
         { "setex", commands::setex },
         { "del", commands::del },
         { "echo", commands::echo },
@@ -35,6 +39,16 @@ future<redis_message> command_factory::create_execute(service::storage_proxy& pr
         { "hgetall", commands::hgetall },
         { "hdel", commands::hdel },
         { "hexists", commands::hexists },
+        { "lpush", commands::lpush },
+        { "rpush", commands::rpush },
+        { "lrange", commands::lrange },
+        { "llen", commands::llen },
+        { "sadd", commands::sadd },
+        { "srem", commands::srem },
+        { "smembers", commands::smembers },
+        { "sismember", commands::sismember },
+        { "zadd", commands::zadd },
+        { "zrangebyscore", commands::zrangebyscore },
     };
     auto&& command = _commands.find(req._command);
     if (command != _commands.end()) {
@@ -45,4 +59,15 @@ future<redis_message> command_factory::create_execute(service::storage_proxy& pr
     return commands::unknown(proxy, req, options, permit);
 }
 
+bool command_factory::is_read_only(const bytes& command)
+{
+    static thread_local std::unordered_set<bytes> _read_only_commands =
+    {
+        "ping", "echo", "get", "mget", "exists", "ttl", "strlen",
+        "hget", "hgetall", "hexists",
+        "lrange", "llen", "smembers", "sismember", "zrangebyscore",
+    };
+    return _read_only_commands.contains(command);
+}
+
 }
@@ -22,5 +22,8 @@ class command_factory {
     command_factory() {}
     ~command_factory() {}
     static seastar::future<redis_message> create_execute(service::storage_proxy&, request&, redis::redis_options&, service_permit);
+    // Whether the command neither modifies data nor connection state, so it
+    // can run concurrently with other such commands of the same pipeline.
+    static bool is_read_only(const bytes& command);
 };
 }
@@ -16,11 +16,129 @@
 #include "redis/mutation_utils.hh"
 #include "redis/lolwut.hh"
 #include "redis/keyspace_utils.hh"
+#include "partition_slice_builder.hh"
+#include "types/types.hh"
+#include "utils/UUID_gen.hh"
+#include <seastar/core/byteorder.hh>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <unordered_map>
 
 namespace redis {
 
 namespace commands {
 
+static int64_t parse_integer(const bytes& arg, const bytes& command) {
+    try {
+        return std::stoll(std::string(reinterpret_cast<const char*>(arg.data()), arg.size()));
+    } catch (...) {
+        throw invalid_arguments_exception(command);
+    }
+}
+
+static double parse_score(const bytes& arg, const bytes& command) {
+    double score;
+    try {
+        score = std::stod(std::string(reinterpret_cast<const char*>(arg.data()), arg.size()));
+    } catch (...) {
+        throw invalid_arguments_exception(command);
+    }
+    if (std::isnan(score)) {
+        throw invalid_arguments_exception(command);
+    }
+    return score;
+}
+
+static bool equals_ignore_case(const bytes& arg, std::string_view expected) {
+    return std::ranges::equal(arg, expected, [] (int8_t a, char b) {
+        return ::tolower(a) == b;
+    });
+}
+
+// LISTs rows are keyed by a position followed by a time UUID, so pushes
+// don't need to read the list. RPUSH puts an element at the timestamp of
+// a new UUID and LPUSH at its negation, so every push goes after (or
+// before) all earlier ones. The UUID keeps apart the elements pushed at
+// the same time by different clients. The position is stored big-endian
+// with the sign bit flipped, which makes the byte order of the key match
+// the numeric order.
+static bytes make_list_element_key(bool front) {
+    auto uuid = utils::UUID_gen::get_time_UUID();
+    auto position = front ? -uuid.timestamp() : uuid.timestamp();
+    bytes b(bytes::initialized_later(), sizeof(uint64_t));
+    write_be<uint64_t>(reinterpret_cast<char*>(b.data()), uint64_t(position) ^ (uint64_t(1) << 63));
+    return b + uuid.serialize();
+}
+
+// ZSETs partitions hold two rows per member, told apart by the first byte of
+// their key. Score rows are keyed by the score followed by the member, so
+// members with equal scores can coexist and ZRANGEBYSCORE is a clustering
+// range read. Member rows are keyed by the length of the member, the member
+// and the score, so the score of a member is found by reading the range of
+// its prefix, without reading the whole set. The score is stored so that the
+// byte order of the key matches the numeric order: big-endian, with all bits
+// flipped for negative numbers and only the sign bit flipped for the others.
+static constexpr int8_t zset_score_row = 0;
+static constexpr int8_t zset_member_row = 1;
+static constexpr size_t serialized_score_size = sizeof(uint64_t);
+
+static bytes serialize_score(double score) {
+    if (score == 0) {
+        // -0 and 0 are the same score
+        score = 0;
+    }
+    auto bits = std::bit_cast<uint64_t>(score);
+    bits = (bits & (uint64_t(1) << 63)) ? ~bits : bits | (uint64_t(1) << 63);
+    bytes b(bytes::initialized_later(), serialized_score_size);
+    write_be<uint64_t>(reinterpret_cast<char*>(b.data()), bits);
+    return b;
+}
+
+static double deserialize_score(bytes_view b) {
+    if (b.size() < serialized_score_size) {
+        throw redis_exception("malformed sorted set element");
+    }
+    auto bits = read_be<uint64_t>(reinterpret_cast<const char*>(b.data()));
+    bits = (bits & (uint64_t(1) << 63)) ? bits & ~(uint64_t(1) << 63) : ~bits;
+    return std::bit_cast<double>(bits);
+}
+
+static bytes make_zset_score_key(const bytes& score, bytes_view member) {
+    return bytes(1, zset_score_row) + score + bytes(member);
+}
+
+// The keys of the member rows of a member start with this prefix.
+static bytes make_zset_member_prefix(bytes_view member) {
+    bytes b(bytes::initialized_later(), 1 + sizeof(uint32_t));
+    b[0] = zset_member_row;
+    write_be<uint32_t>(reinterpret_cast<char*>(b.data() + 1), member.size());
+    return b + bytes(member);
+}
+
+static bytes_view zset_row_score(bytes_view key) {
+    if (key.size() < 1 + serialized_score_size || key[0] != zset_score_row) {
+        throw redis_exception("malformed sorted set element");
+    }
+    return key.substr(1, serialized_score_size);
+}
+
+static bytes_view zset_row_member(bytes_view key) {
+    zset_row_score(key);
+    return key.substr(1 + serialized_score_size);
+}
+
+// Tables created before sorted sets were implemented are keyed by the score
+// alone, and can't hold members with equal scores.
+static schema_ptr get_zsets_schema(service::storage_proxy& proxy, const redis::redis_options& options) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::ZSETs);
+    if (schema->clustering_key_columns().front().type != bytes_type) {
+        throw redis_exception(fmt::format("table {}.{} has an outdated schema, drop it to use sorted sets", schema->ks_name(), schema->cf_name()));
+    }
+    return schema;
+}
+
 future<redis_message> get(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
     if (req.arguments_size() != 1) {
         throw wrong_arguments_exception(1, req.arguments_size(), req._command);
@@ -34,6 +152,25 @@ future<redis_message> get(service::storage_proxy& proxy, request& req, redis::re
     });
 }
 
+future<redis_message> mget(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 1) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    return redis::read_multiple_strings(proxy, options, req._args, permit).then([&req] (auto result) {
+        std::vector<std::optional<bytes>> values;
+        values.reserve(req.arguments_size());
+        for (auto& key : req._args) {
+            auto it = result->find(key);
+            if (it != result->end()) {
+                values.emplace_back(it->second);
+            } else {
+                values.emplace_back(std::nullopt);
+            }
+        }
+        return redis_message::make_array_result(values);
+    });
+}
+
 future<redis_message> exists(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
     if (req.arguments_size() < 1) {
         throw wrong_arguments_exception(1, req.arguments_size(), req._command);
@@ -160,6 +297,22 @@ future<redis_message> set(service::storage_proxy& proxy, request& req, redis::re
     });
 }
 
+future<redis_message> mset(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 2 || req.arguments_size() % 2 != 0) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    // A key given several times gets the last value, as if the pairs were
+    // set one after another.
+    std::unordered_map<bytes, bytes> latest;
+    for (size_t i = 0; i < req.arguments_size(); i += 2) {
+        latest.insert_or_assign(std::move(req._args[i]), std::move(req._args[i + 1]));
+    }
+    std::vector<std::pair<bytes, bytes>> values(std::make_move_iterator(latest.begin()), std::make_move_iterator(latest.end()));
+    return redis::write_multiple_strings(proxy, options, std::move(values), permit).then([] {
+        return redis_message::ok();
+    });
+}
+
 future<redis_message> setex(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
     if (req.arguments_size() != 3) {
         throw wrong_arguments_exception(3, req.arguments_size(), req._command);
@@ -182,6 +335,267 @@ future<redis_message> del(service::storage_proxy& proxy, request& req, redis::re
     });
 }
 
+static future<redis_message> push(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit, bool front) {
+    if (req.arguments_size() < 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    std::vector<std::pair<bytes, bytes>> rows;
+    rows.reserve(req.arguments_size() - 1);
+    for (auto it = req._args.begin() + 1; it != req._args.end(); ++it) {
+        rows.emplace_back(make_list_element_key(front), std::move(*it));
+    }
+    return redis::write_rows(proxy, options, redis::LISTs, bytes(req._args[0]), std::move(rows), {}, permit).then([&proxy, &req, &options, permit] {
+        return redis::count_rows(proxy, options, redis::LISTs, req._args[0], permit).then([] (uint64_t length) {
+            return redis_message::number(length);
+        });
+    });
+}
+
+future<redis_message> lpush(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    return push(proxy, req, options, permit, true);
+}
+
+future<redis_message> rpush(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    return push(proxy, req, options, permit, false);
+}
+
+future<redis_message> lrange(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 3) {
+        throw wrong_arguments_exception(3, req.arguments_size(), req._command);
+    }
+    auto start = parse_integer(req._args[1], req._command);
+    auto stop = parse_integer(req._args[2], req._command);
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::LISTs);
+    auto ps = partition_slice_builder(*schema).build();
+    // Indexes counted from the end need the length of the list, otherwise
+    // there is no need to read past the last requested element.
+    auto row_limit = (start >= 0 && stop >= 0) ? query::row_limit(uint64_t(stop) + 1) : query::row_limit::max;
+    return redis::query_rows(proxy, options, req._args[0], permit, schema, std::move(ps), row_limit).then([start, stop] (lw_shared_ptr<rows_result> list) mutable {
+        auto size = int64_t(list->size());
+        if (start < 0) {
+            start = std::max(start + size, int64_t(0));
+        }
+        if (stop < 0) {
+            stop += size;
+        }
+        stop = std::min(stop, size - 1);
+        std::vector<bytes> values;
+        for (auto i = start; i <= stop; ++i) {
+            values.push_back(std::move((*list)[i].second));
+        }
+        return redis_message::make_array_result(values);
+    });
+}
+
+future<redis_message> llen(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 1) {
+        throw wrong_arguments_exception(1, req.arguments_size(), req._command);
+    }
+    return redis::count_rows(proxy, options, redis::LISTs, req._args[0], permit).then([] (uint64_t length) {
+        return redis_message::number(length);
+    });
+}
+
+// Reads which of the given members are present in a set.
+static future<lw_shared_ptr<rows_result>> read_set_members(service::storage_proxy& proxy, redis::redis_options& options, const bytes& key, const std::set<bytes>& members, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::SETs);
+    std::vector<query::clustering_range> ranges;
+    ranges.reserve(members.size());
+    for (auto& member : members) {
+        ranges.push_back(query::clustering_range::make_singular(clustering_key::from_single_value(*schema, member)));
+    }
+    auto ps = partition_slice_builder(*schema).with_ranges(std::move(ranges)).build();
+    return redis::query_rows(proxy, options, key, permit, schema, std::move(ps), query::row_limit::max);
+}
+
+future<redis_message> sadd(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    auto members = make_lw_shared<std::set<bytes>>(req._args.begin() + 1, req._args.end());
+    return read_set_members(proxy, options, req._args[0], *members, permit).then([&proxy, &req, &options, permit, members] (lw_shared_ptr<rows_result> existing) {
+        for (auto& row : *existing) {
+            members->erase(row.first);
+        }
+        std::vector<std::pair<bytes, bytes>> rows;
+        rows.reserve(members->size());
+        for (auto& member : *members) {
+            rows.emplace_back(member, bytes());
+        }
+        auto added = rows.size();
+        return redis::write_rows(proxy, options, redis::SETs, std::move(req._args[0]), std::move(rows), {}, permit).then([added] {
+            return redis_message::number(added);
+        });
+    });
+}
+
+future<redis_message> srem(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    std::set<bytes> members(req._args.begin() + 1, req._args.end());
+    return read_set_members(proxy, options, req._args[0], members, permit).then([&proxy, &req, &options, permit] (lw_shared_ptr<rows_result> existing) {
+        std::vector<bytes> deleted;
+        deleted.reserve(existing->size());
+        for (auto& row : *existing) {
+            deleted.push_back(std::move(row.first));
+        }
+        auto removed = deleted.size();
+        if (deleted.empty()) {
+            return redis_message::zero();
+        }
+        return redis::write_rows(proxy, options, redis::SETs, std::move(req._args[0]), {}, std::move(deleted), permit).then([removed] {
+            return redis_message::number(removed);
+        });
+    });
+}
+
+future<redis_message> smembers(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 1) {
+        throw wrong_arguments_exception(1, req.arguments_size(), req._command);
+    }
+    return redis::read_rows(proxy, options, redis::SETs, req._args[0], permit).then([] (lw_shared_ptr<rows_result> set) {
+        std::vector<bytes> members;
+        members.reserve(set->size());
+        for (auto& row : *set) {
+            members.push_back(std::move(row.first));
+        }
+        return redis_message::make_array_result(members);
+    });
+}
+
+future<redis_message> sismember(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 2) {
+        throw wrong_arguments_exception(2, req.arguments_size(), req._command);
+    }
+    std::set<bytes> members{req._args[1]};
+    return read_set_members(proxy, options, req._args[0], members, permit).then([] (lw_shared_ptr<rows_result> existing) {
+        return redis_message::number(existing->empty() ? 0 : 1);
+    });
+}
+
+future<redis_message> zadd(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 3 || req.arguments_size() % 2 != 1) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    auto schema = get_zsets_schema(proxy, options);
+    // Maps each member to its new serialized score.
+    auto updated = make_lw_shared<std::unordered_map<bytes, bytes>>();
+    for (size_t i = 1; i < req.arguments_size(); i += 2) {
+        auto score = parse_score(req._args[i], req._command);
+        updated->insert_or_assign(req._args[i + 1], serialize_score(score));
+    }
+    // A member which is already in the set has to be removed from its old
+    // score, which is read from its member row.
+    std::vector<query::clustering_range> ranges;
+    ranges.reserve(updated->size());
+    for (auto& [member, score] : *updated) {
+        auto prefix = make_zset_member_prefix(member);
+        auto last = prefix + bytes(serialized_score_size, int8_t(-1));
+        ranges.push_back(query::clustering_range::make(
+                {clustering_key::from_single_value(*schema, std::move(prefix)), true},
+                {clustering_key::from_single_value(*schema, std::move(last)), true}));
+    }
+    auto ps = partition_slice_builder(*schema).with_ranges(std::move(ranges)).build();
+    return redis::query_rows(proxy, options, req._args[0], permit, schema, std::move(ps), query::row_limit::max).then([&proxy, &req, &options, permit, updated] (lw_shared_ptr<rows_result> existing) {
+        // Maps each member already in the set to its current score.
+        std::unordered_map<bytes, bytes> current;
+        for (auto& row : *existing) {
+            bytes_view key = row.first;
+            auto length = read_be<uint32_t>(reinterpret_cast<const char*>(key.data() + 1));
+            key.remove_prefix(1 + sizeof(uint32_t));
+            current.emplace(bytes(key.substr(0, length)), bytes(key.substr(length)));
+        }
+        std::vector<std::pair<bytes, bytes>> rows;
+        std::vector<bytes> deleted;
+        size_t added = 0;
+        for (auto& [member, score] : *updated) {
+            auto it = current.find(member);
+            if (it == current.end()) {
+                ++added;
+            } else if (it->second == score) {
+                continue;
+            } else {
+                deleted.push_back(make_zset_score_key(it->second, member));
+                deleted.push_back(make_zset_member_prefix(member) + it->second);
+            }
+            rows.emplace_back(make_zset_score_key(score, member), bytes());
+            rows.emplace_back(make_zset_member_prefix(member) + score, bytes());
+        }
+        if (rows.empty()) {
+            return redis_message::zero();
+        }
+        return redis::write_rows(proxy, options, redis::ZSETs, std::move(req._args[0]), std::move(rows), std::move(deleted), permit).then([added] {
+            return redis_message::number(added);
+        });
+    });
+}
+
+struct score_bound {
+    double score;
+    bool inclusive;
+};
+
+// Parses a ZRANGEBYSCORE bound: a score, optionally prefixed by "(" to
+// exclude it, or an infinity.
+static score_bound parse_score_bound(const bytes& arg, const bytes& command) {
+    if (!arg.empty() && arg[0] == '(') {
+        return score_bound{parse_score(bytes(arg.begin() + 1, arg.end()), command), false};
+    }
+    return score_bound{parse_score(arg, command), true};
+}
+
+// Score row keys start with the score, so the rows with a given score are
+// those from its serialized form, up to the serialized form of the next
+// score. The member rows come after all of them.
+static query::clustering_range::bound to_lower_clustering_bound(const schema& schema, const score_bound& b) {
+    auto score = b.inclusive ? b.score : std::nextafter(b.score, std::numeric_limits<double>::infinity());
+    return query::clustering_range::bound(clustering_key::from_single_value(schema, make_zset_score_key(serialize_score(score), {})), true);
+}
+
+static query::clustering_range::bound to_upper_clustering_bound(const schema& schema, const score_bound& b) {
+    if (b.inclusive && b.score == std::numeric_limits<double>::infinity()) {
+        return query::clustering_range::bound(clustering_key::from_single_value(schema, bytes(1, zset_member_row)), false);
+    }
+    auto score = b.inclusive ? std::nextafter(b.score, std::numeric_limits<double>::infinity()) : b.score;
+    return query::clustering_range::bound(clustering_key::from_single_value(schema, make_zset_score_key(serialize_score(score), {})), false);
+}
+
+future<redis_message> zrangebyscore(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 3 && req.arguments_size() != 4) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    bool with_scores = false;
+    if (req.arguments_size() == 4) {
+        if (!equals_ignore_case(req._args[3], "withscores")) {
+            throw invalid_arguments_exception(req._command);
+        }
+        with_scores = true;
+    }
+    auto min = parse_score_bound(req._args[1], req._command);
+    auto max = parse_score_bound(req._args[2], req._command);
+    if (min.score > max.score || (min.score == max.score && !(min.inclusive && max.inclusive))) {
+        std::vector<bytes> none;
+        return redis_message::make_array_result(none);
+    }
+    auto schema = get_zsets_schema(proxy, options);
+    auto ps = partition_slice_builder(*schema)
+        .with_range(query::clustering_range(to_lower_clustering_bound(*schema, min), to_upper_clustering_bound(*schema, max)))
+        .build();
+    return redis::query_rows(proxy, options, req._args[0], permit, schema, std::move(ps), query::row_limit::max).then([with_scores] (lw_shared_ptr<rows_result> zset) {
+        std::vector<bytes> values;
+        values.reserve(zset->size() * (with_scores ? 2 : 1));
+        for (auto& row : *zset) {
+            values.emplace_back(zset_row_member(row.first));
+            if (with_scores) {
+                auto s = fmt::format("{}", deserialize_score(zset_row_score(row.first)));
+                values.emplace_back(reinterpret_cast<const int8_t*>(s.data()), s.size());
+            }
+        }
+        return redis_message::make_array_result(values);
+    });
+}
+
 future<redis_message> select(service::storage_proxy&, request& req, redis::redis_options& options, service_permit) {
     if (req.arguments_size() != 1) {
         throw wrong_arguments_exception(1, req.arguments_size(), req._command);
@@ -122,9 +122,9 @@ schema_ptr zsets_schema(sstring ks_name) {
      // partition key
      {{"pkey", utf8_type}},
      // clustering key
-     {{"ckey", double_type}},
+     {{"ckey", bytes_type}},
      // regular columns
-     {{"data", utf8_type}},
+     {},
      // static columns
      {},
      // regular column name type
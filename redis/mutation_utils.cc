@@ -71,6 +71,35 @@ future<> write_strings(service::storage_proxy& proxy, redis::redis_options& opti
     return proxy.mutate(std::vector<mutation> {std::move(m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
 }
 
+future<> write_multiple_strings(service::storage_proxy& proxy, redis::redis_options& options, std::vector<std::pair<bytes, bytes>>&& values, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+    std::vector<mutation> mutations;
+    mutations.reserve(values.size());
+    for (auto& [key, data] : values) {
+        mutations.push_back(make_mutation(proxy, options, std::move(key), std::move(data), 0));
+    }
+    auto write_consistency_level = options.get_write_consistency_level();
+    return proxy.mutate(std::move(mutations), write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+}
+
+future<> write_rows(service::storage_proxy& proxy, redis::redis_options& options, const sstring& cf_name, bytes&& key, std::vector<std::pair<bytes, bytes>>&& rows, std::vector<bytes>&& deleted_rows, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+    auto schema = get_schema(proxy, options.get_keyspace_name(), cf_name);
+    // SETs have no data column of their own, only the implicit empty
+    // compact value column.
+    const column_definition& column = schema->regular_column_at(0);
+    auto m = mutation(schema, partition_key::from_single_value(*schema, key));
+    auto ts = api::new_timestamp();
+    auto clk = gc_clock::now();
+    for (auto& ckey : deleted_rows) {
+        m.partition().apply_delete(*schema, clustering_key::from_single_value(*schema, ckey), tombstone { ts, clk });
+    }
+    for (auto& [ckey, data] : rows) {
+        m.set_clustered_cell(clustering_key::from_single_value(*schema, ckey), column, make_cell(schema, *column.type, data));
+    }
+    auto write_consistency_level = options.get_write_consistency_level();
+    return proxy.mutate(std::vector<mutation> {std::move(m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+}
 
 mutation make_tombstone(service::storage_proxy& proxy, const redis_options& options, const sstring& cf_name, const bytes& key) {
     auto schema = get_schema(proxy, options.get_keyspace_name(), cf_name);
@@ -11,6 +11,7 @@
 #include <seastar/core/future.hh>
 #include "bytes.hh"
 #include "seastarx.hh"
+#include <seastar/core/sstring.hh>
 
 class service_permit;
 
@@ -25,6 +26,11 @@ class redis_options;
 
 future<> write_hashes(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, bytes&& field, bytes&& data, long ttl, service_permit permit);
 future<> write_strings(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, bytes&& data, long ttl, service_permit permit);
+// Writes several STRINGs keys with a single storage_proxy call.
+future<> write_multiple_strings(service::storage_proxy& proxy, redis::redis_options& options, std::vector<std::pair<bytes, bytes>>&& values, service_permit permit);
+// Writes and deletes rows (identified by their serialized clustering key) of
+// a single LISTs, SETs or ZSETs object in one mutation.
+future<> write_rows(service::storage_proxy& proxy, redis::redis_options& options, const sstring& cf_name, bytes&& key, std::vector<std::pair<bytes, bytes>>&& rows, std::vector<bytes>&& deleted_rows, service_permit permit);
 future<> delete_objects(service::storage_proxy& proxy, redis::redis_options& options, std::vector<bytes>&& keys, service_permit permit);
 future<> delete_fields(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<bytes>&& fields, service_permit permit);
 
@@ -85,6 +85,71 @@ future<lw_shared_ptr<strings_result>> query_strings(service::storage_proxy& prox
     });
 }
 
+class multiple_strings_result_builder {
+    lw_shared_ptr<std::unordered_map<bytes, bytes>> _data;
+    const query::partition_slice& _partition_slice;
+    const schema_ptr _schema;
+    bytes _key;
+public:
+    multiple_strings_result_builder(lw_shared_ptr<std::unordered_map<bytes, bytes>> data, const schema_ptr schema, const query::partition_slice& ps)
+        : _data(data)
+        , _partition_slice(ps)
+        , _schema(schema)
+    {
+    }
+    void accept_new_partition(const partition_key& key, uint32_t row_count) {
+        _key = std::move(key.explode().front());
+    }
+    void accept_new_partition(uint32_t row_count) {}
+    void accept_new_row(const clustering_key& key, const query::result_row_view& static_row, const query::result_row_view& row)
+    {
+        auto row_iterator = row.iterator();
+        for (auto&& id : _partition_slice.regular_columns) {
+            auto cell = row_iterator.next_atomic_cell();
+            if (cell) {
+                const auto& col = _schema->regular_column_at(id);
+                cell->value().with_linearized([this, &col] (bytes_view cell_view) {
+                    _data->insert_or_assign(_key, col.type->deserialize_value(cell_view).serialize_nonnull());
+                });
+            }
+        }
+    }
+    void accept_new_row(const query::result_row_view& static_row, const query::result_row_view& row) {}
+    void accept_partition_end(const query::result_row_view& static_row) {}
+};
+
+future<lw_shared_ptr<std::unordered_map<bytes, bytes>>> read_multiple_strings(service::storage_proxy& proxy, const redis_options& options, const std::vector<bytes>& keys, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::STRINGs);
+    auto ps = partition_slice_builder(*schema).build();
+    std::vector<dht::decorated_key> dkeys;
+    dkeys.reserve(keys.size());
+    for (auto& key : keys) {
+        dkeys.push_back(dht::decorate_key(*schema, partition_key::from_single_value(*schema, key)));
+    }
+    // Partition ranges passed to a single query have to be sorted and
+    // non-overlapping, and MGET may name the same key several times.
+    std::ranges::sort(dkeys, dht::decorated_key::less_comparator(schema));
+    auto last = std::ranges::unique(dkeys, dht::decorated_key_equals_comparator(*schema));
+    dkeys.erase(last.begin(), last.end());
+    dht::partition_range_vector partition_ranges;
+    partition_ranges.reserve(dkeys.size());
+    for (auto& dkey : dkeys) {
+        partition_ranges.emplace_back(dht::partition_range::make_singular(std::move(dkey)));
+    }
+    const auto max_result_size = proxy.get_max_result_size(ps);
+    const auto max_tombstones = proxy.get_tombstone_limit();
+    const auto limit = partition_ranges.size();
+    query::read_command cmd(schema->id(), schema->version(), ps, max_result_size, max_tombstones, query::row_limit(limit), query::partition_limit(limit), gc_clock::now(), std::nullopt, query_id::create_null_id(), query::is_first_page::no);
+    auto read_consistency_level = options.get_read_consistency_level();
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
+    return proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()}).then([ps, schema] (auto qr) {
+        return query::result_view::do_with(*qr.query_result, [&] (query::result_view v) {
+            auto pd = make_lw_shared<std::unordered_map<bytes, bytes>>();
+            v.consume(ps, multiple_strings_result_builder(pd, schema, ps));
+            return pd;
+        });
+    });
+}
 
 class hashes_result_builder {
     lw_shared_ptr<std::map<bytes, bytes>> _data;
@@ -162,4 +227,73 @@ future<lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_prox
     });
 }
 
+
+class rows_result_builder {
+    lw_shared_ptr<rows_result> _data;
+    const query::partition_slice& _partition_slice;
+public:
+    rows_result_builder(lw_shared_ptr<rows_result> data, const query::partition_slice& ps)
+        : _data(data)
+        , _partition_slice(ps)
+    {
+    }
+    void accept_new_partition(const partition_key& key, uint32_t row_count) {}
+    void accept_new_partition(uint32_t row_count) {}
+    void accept_new_row(const clustering_key& key, const query::result_row_view& static_row, const query::result_row_view& row)
+    {
+        auto row_iterator = row.iterator();
+        for (auto&& id : _partition_slice.regular_columns) {
+            auto cell = row_iterator.next_atomic_cell();
+            if (cell) {
+                // All data columns are either utf8 or empty, so the cell
+                // holds the value as is.
+                cell->value().with_linearized([this, &key] (bytes_view cell_view) {
+                    _data->emplace_back(std::move(key.explode().front()), to_bytes(cell_view));
+                });
+            }
+        }
+    }
+    void accept_new_row(const query::result_row_view& static_row, const query::result_row_view& row) {}
+    void accept_partition_end(const query::result_row_view& static_row) {}
+};
+
+future<lw_shared_ptr<rows_result>> read_rows(service::storage_proxy& proxy, const redis_options& options, const sstring& cf_name, const bytes& key, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), cf_name);
+    auto ps = partition_slice_builder(*schema).build();
+    return query_rows(proxy, options, key, permit, schema, ps, query::row_limit::max);
+}
+
+static future<service::storage_proxy::coordinator_query_result> query_partition(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit, schema_ptr schema, const query::partition_slice& ps, query::row_limit row_limit) {
+    const auto max_result_size = proxy.get_max_result_size(ps);
+    const auto max_tombstones = proxy.get_tombstone_limit();
+    query::read_command cmd(schema->id(), schema->version(), ps, max_result_size, max_tombstones, row_limit, query::partition_limit(1), gc_clock::now(), std::nullopt, query_id::create_null_id(), query::is_first_page::no);
+    auto pkey = partition_key::from_single_value(*schema, key);
+    auto partition_range = dht::partition_range::make_singular(dht::decorate_key(*schema, std::move(pkey)));
+    dht::partition_range_vector partition_ranges;
+    partition_ranges.emplace_back(std::move(partition_range));
+    auto read_consistency_level = options.get_read_consistency_level();
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
+    return proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()});
+}
+
+future<lw_shared_ptr<rows_result>> query_rows(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit, schema_ptr schema, query::partition_slice ps, query::row_limit row_limit) {
+    return query_partition(proxy, options, key, permit, schema, ps, row_limit).then([ps] (auto qr) {
+        return query::result_view::do_with(*qr.query_result, [&] (query::result_view v) {
+            auto pd = make_lw_shared<rows_result>();
+            v.consume(ps, rows_result_builder(pd, ps));
+            return pd;
+        });
+    });
+}
+
+future<uint64_t> count_rows(service::storage_proxy& proxy, const redis_options& options, const sstring& cf_name, const bytes& key, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), cf_name);
+    // Like SELECT COUNT(*), the replicas don't send any cells, only the rows.
+    auto ps = partition_slice_builder(*schema).with_no_regular_columns().build();
+    return query_partition(proxy, options, key, permit, schema, ps, query::row_limit::max).then([] (auto qr) {
+        qr.query_result->ensure_counts();
+        return *qr.query_result->row_count();
+    });
+}
+
 }
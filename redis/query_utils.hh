@@ -14,6 +14,8 @@
 #include "gc_clock.hh"
 #include "query-request.hh"
 
+#include <unordered_map>
+
 namespace service {
 class storage_proxy;
 class client_state;
@@ -38,8 +40,22 @@ struct strings_result {
 seastar::future<seastar::lw_shared_ptr<strings_result>> read_strings(service::storage_proxy&, const redis_options&, const bytes&, service_permit);
 seastar::future<seastar::lw_shared_ptr<strings_result>> query_strings(service::storage_proxy&, const redis_options&, const bytes&, service_permit, schema_ptr, query::partition_slice);
 
+// Reads the values of several STRINGs keys with a single storage_proxy
+// query, instead of one round trip per key. Keys which do not exist are
+// missing from the result.
+seastar::future<seastar::lw_shared_ptr<std::unordered_map<bytes, bytes>>> read_multiple_strings(service::storage_proxy&, const redis_options&, const std::vector<bytes>&, service_permit);
+
 seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, service_permit);
 seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, const bytes&, service_permit);
 seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_proxy&, const redis_options&, const bytes&, service_permit, schema_ptr, query::partition_slice);
 
+// The rows of a LISTs, SETs or ZSETs object, in clustering order: each entry
+// holds the serialized clustering key and the data cell (empty for SETs).
+using rows_result = std::vector<std::pair<bytes, bytes>>;
+
+seastar::future<seastar::lw_shared_ptr<rows_result>> read_rows(service::storage_proxy&, const redis_options&, const sstring&, const bytes&, service_permit);
+seastar::future<seastar::lw_shared_ptr<rows_result>> query_rows(service::storage_proxy&, const redis_options&, const bytes&, service_permit, schema_ptr, query::partition_slice, query::row_limit);
+// Counts the rows of a LISTs, SETs or ZSETs object without reading them.
+seastar::future<uint64_t> count_rows(service::storage_proxy&, const redis_options&, const sstring&, const bytes&, service_permit);
+
 }
@@ -8,6 +8,7 @@
 
 #include "redis/server.hh"
 
+#include "redis/command_factory.hh"
 #include "redis/request.hh"
 #include "redis/reply.hh"
 
@@ -64,6 +65,7 @@ redis_server::connection::connection(redis_server& server, socket_address server
     , _server(server)
     , _server_addr(server_addr)
     , _options(server._config._read_consistency_level, server._config._write_consistency_level, server._config._timeout_config, server._auth_service, addr, server._total_redis_db_count)
+    , _pipeline_slots(max_pipelined_requests)
 {
 }
 
@@ -72,8 +74,8 @@ redis_server::connection::~connection() {
 
 thread_local redis_server::connection::execution_stage_type redis_server::connection::_process_request_stage {"redis_transport", &connection::process_request_one};
 
-future<redis_server::result> redis_server::connection::process_request_internal() {
-    return _process_request_stage(this, _parser.get_request(), seastar::ref(_options), empty_service_permit());
+future<redis_server::result> redis_server::connection::process_request_internal(redis::request&& request) {
+    return _process_request_stage(this, std::move(request), seastar::ref(_options), empty_service_permit());
 }
 
 void redis_server::connection::write_reply(const redis_exception& e)
@@ -88,43 +90,76 @@ void redis_server::connection::write_reply(const redis_exception& e)
     });
 }
 
-void redis_server::connection::write_reply(redis_server::result result)
-{
-    _ready_to_respond = _ready_to_respond.then([this, result = std::move(result)] () mutable {
-        auto m = result.make_message();
-        return _write_buf.write(std::move(*m)).then([this] {
-            return _write_buf.flush();
-        });
-    });
-}
-
 future<> redis_server::connection::process_request() {
     _parser.init();
     return _read_buf.consume(_parser).then([this] {
         if (_parser.eof()) {
             return make_ready_future<>();
         }
-        ++_server._stats._requests_serving;
-        _pending_requests_gate.enter();
-        utils::latency_counter lc;
-        lc.start();
-        auto leave = defer([this] () noexcept { _pending_requests_gate.leave(); });
-        return process_request_internal().then([this, leave = std::move(leave), lc = std::move(lc)] (auto&& result) mutable {
-            --_server._stats._requests_serving;
-            try {
-                if (_parser.failed()) {
-                    logging.error("request parse failed");
-                    const auto e = redis_exception("unknown command ''");
-                    write_reply(std::move(e));
-                }else{
-                    write_reply(std::move(result));
+        if (_parser.failed()) {
+            logging.error("request parse failed");
+            write_reply(redis_exception("unknown command ''"));
+            return make_ready_future<>();
+        }
+        // Don't wait for the request to complete before reading the next
+        // one: a pipelining client has already sent it. The reply slot is
+        // reserved now, so replies go out in the order requests came in.
+        return get_units(_pipeline_slots, 1).then([this, request = _parser.get_request()] (semaphore_units<> slot) mutable {
+            ++_server._stats._requests_serving;
+            _pending_requests_gate.enter();
+            utils::latency_counter lc;
+            lc.start();
+            auto leave = defer([this] () noexcept { _pending_requests_gate.leave(); });
+
+            promise<result> reply;
+            _ready_to_respond = _ready_to_respond.then([this, f = reply.get_future()] () mutable {
+                // A request which failed still gets a reply, so that the
+                // replies to the requests after it are sent as well.
+                return std::move(f).handle_exception([] (std::exception_ptr ep) {
+                    logging.error("request processing failed: {}", ep);
+                    return redis::redis_message::exception("request processing failed").then([] (auto&& m) {
+                        return result(std::move(m));
+                    });
+                }).then([this] (result result) {
+                    auto m = result.make_message();
+                    return _write_buf.write(std::move(*m)).then([this] {
+                        return _write_buf.flush();
+                    });
+                });
+            });
+
+            auto lock = redis::command_factory::is_read_only(request._command) ? _pipeline_lock.hold_read_lock() : _pipeline_lock.hold_write_lock();
+            (void)lock.then([this, request = std::move(request)] (auto holder) mutable {
+                return process_request_internal(std::move(request)).finally([holder = std::move(holder)] {});
+            }).then_wrapped([] (future<result> f) {
+                if (!f.failed()) {
+                    return f;
+                }
+                sstring message;
+                try {
+                    std::rethrow_exception(f.get_exception());
+                } catch (redis_exception& e) {
+                    message = e.what_message();
+                } catch (std::exception& e) {
+                    message = e.what();
+                } catch (...) {
+                    message = "Unknown exception";
                 }
+                return redis::redis_message::exception(message).then([] (auto&& m) {
+                    return result(std::move(m));
+                });
+            }).then_wrapped([this, reply = std::move(reply), slot = std::move(slot), leave = std::move(leave), lc = std::move(lc)] (future<result> f) mutable {
+                --_server._stats._requests_serving;
+                if (f.failed()) {
+                    reply.set_exception(f.get_exception());
+                    return;
+                }
+                reply.set_value(f.get());
                 ++_server._stats._requests_served;
                 _server._stats._requests.mark(lc.stop().latency());
                 _server._stats._estimated_requests_latency.add(lc.latency(), _server._stats._requests.hist.count);
-            } catch (...) {
-                logging.error("request processing failed: {}", std::current_exception());
-            }
+            });
+            return make_ready_future<>();
         });
     });
 }
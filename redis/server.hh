@@ -23,6 +23,7 @@
 #include "timeout_config.hh"
 #include "generic_server.hh"
 
+#include <seastar/core/rwlock.hh>
 #include <seastar/core/seastar.hh>
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/sharded.hh>
@@ -52,6 +53,8 @@ struct redis_server_config {
 };
 
 class redis_server : public generic_server::server {
+    // Bounds how many requests a single connection may have in flight.
+    static constexpr size_t max_pipelined_requests = 128;
     seastar::sharded<redis::query_processor>& _query_processor;
     redis_server_config _config;
     size_t _max_request_size;
@@ -78,6 +81,13 @@ class redis_server : public generic_server::server {
         socket_address _server_addr;
         redis_protocol_parser _parser;
         redis::redis_options _options;
+        // Pipelined requests are dispatched without waiting for the previous
+        // reply. Read-only commands share the lock and run concurrently, any
+        // other command waits for all requests received before it (and holds
+        // back the ones after it), so the client observes the same order of
+        // effects as with one request at a time.
+        seastar::rwlock _pipeline_lock;
+        semaphore _pipeline_slots;
 
         using execution_stage_type = inheriting_concrete_execution_stage<
                 future<redis_server::result>,
@@ -93,10 +103,9 @@ class redis_server : public generic_server::server {
         future<> process_request() override;
         void handle_error(future<>&& f) override;
         void write_reply(const redis_exception&);
-        void write_reply(redis_server::result result);
     private:
         future<result> process_request_one(redis::request&& request, redis::redis_options&, service_permit permit);
-        future<result> process_request_internal();
+        future<result> process_request_internal(redis::request&& request);
     };
 
     virtual shared_ptr<generic_server::connection> make_connection(socket_address server_addr, connected_socket&& fd, socket_address addr) override;
@@ -540,6 +540,13 @@ database::setup_metrics() {
                        sm::description("Counts sstables that survived the clustering key filtering. "
                                        "High value indicates that bloom filter is not very efficient and still have to access a lot of sstables to get data.")),
 
+        sm::make_counter("row_filter_sstables_checked", _cf_stats.sstables_checked_by_row_filter,
+                       sm::description("Counts sstables checked by the row filter on single-row reads.")),
+
+        sm::make_counter("row_filter_surviving_sstables", _cf_stats.surviving_sstables_after_row_filter,
+                       sm::description("Counts sstables that survived the row filter on single-row reads. "
+                                       "The difference from row_filter_sstables_checked is the number of sstables skipped by the row filter.")),
+
         sm::make_counter("dropped_view_updates", _cf_stats.dropped_view_updates,
                        sm::description("Counts the number of view updates that have been dropped due to cluster overload. ")),
 
@@ -1262,6 +1269,8 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.data_listeners = &db.data_listeners();
     cfg.enable_compacting_data_for_streaming_and_repair = db_config.enable_compacting_data_for_streaming_and_repair;
     cfg.enable_tombstone_gc_for_streaming_and_repair = db_config.enable_tombstone_gc_for_streaming_and_repair;
+    cfg.memtable_flush_parallelism = db_config.memtable_flush_parallelism;
+    cfg.compaction_adaptive_chunk_length = db_config.compaction_adaptive_chunk_length;
 
     return cfg;
 }
@@ -107,6 +107,7 @@ class sstable_set;
 class directory_semaphore;
 struct sstable_files_snapshot;
 struct entry_descriptor;
+struct foreign_sstable_open_info;
 
 }
 
@@ -312,6 +313,10 @@ struct cf_stats {
     int64_t clustering_filter_fast_path_count = 0;
     // how many sstables survived the clustering key checks
     int64_t surviving_sstables_after_clustering_filter = 0;
+    // sstables considered by the row filter, on single-row reads
+    int64_t sstables_checked_by_row_filter = 0;
+    // how many sstables survived the row filter checks
+    int64_t surviving_sstables_after_row_filter = 0;
 
     // How many view updates were dropped due to overload.
     int64_t dropped_view_updates = 0;
@@ -363,6 +368,11 @@ struct table_stats {
     utils::timed_rate_moving_average_and_histogram tombstone_scanned;
     utils::timed_rate_moving_average_and_histogram live_scanned;
     utils::estimated_histogram estimated_coordinator_read;
+    // Queries reading only single partitions, and the other ones.
+    utils::timed_rate_moving_average point_reads;
+    utils::timed_rate_moving_average range_reads;
+    // When point_reads and range_reads started counting.
+    lowres_clock::time_point read_rates_since = lowres_clock::now();
 };
 
 using storage_options = data_dictionary::storage_options;
@@ -421,6 +431,8 @@ class table : public enable_lw_shared_from_this<table>
         unsigned x_log2_compaction_groups{0};
         utils::updateable_value<bool> enable_compacting_data_for_streaming_and_repair;
         utils::updateable_value<bool> enable_tombstone_gc_for_streaming_and_repair;
+        utils::updateable_value<uint32_t> memtable_flush_parallelism{1};
+        utils::updateable_value<bool> compaction_adaptive_chunk_length{false};
     };
 
     using snapshot_details = db::snapshot_ctl::table_snapshot_details;
@@ -544,6 +556,18 @@ class table : public enable_lw_shared_from_this<table>
     future<> add_sstables_and_update_cache(const std::vector<sstables::shared_sstable>& ssts);
     future<> move_sstables_from_staging(std::vector<sstables::shared_sstable>);
     sstables::shared_sstable make_sstable();
+    // Loads an sstable of this table that was opened on another shard.
+    future<sstables::shared_sstable> load_foreign_sstable(sstables::foreign_sstable_open_info info);
+    // Compression chunk length of the sstables written by compaction, picked
+    // from the recent reads of the table if compaction_adaptive_chunk_length
+    // is set. std::nullopt means the chunk length of the compression options.
+    std::optional<uint32_t> compaction_chunk_length() const;
+    // Picks the chunk length for compaction_chunk_length() given the rates of
+    // point and range reads, tracked for the given duration. Returns
+    // std::nullopt while the rates are too young to classify the workload.
+    static std::optional<uint32_t> compaction_chunk_length_for_reads(uint32_t configured,
+            const utils::rate_moving_average& point_reads, const utils::rate_moving_average& range_reads,
+            lowres_clock::duration tracked_for);
     void set_truncation_time(db_clock::time_point truncated_at) noexcept {
         _truncated_at = truncated_at;
     }
@@ -1047,6 +1071,8 @@ class table : public enable_lw_shared_from_this<table>
     // The tablet filter is used to not double account migrating tablets, so it's important that
     // only one of pending or leaving replica is accounted based on current migration stage.
     locator::table_load_stats table_load_stats(std::function<bool(const locator::tablet_map&, locator::global_tablet_id)> tablet_filter) const noexcept;
+    // Request rates served by this shard, averaged over the last 5 minutes.
+    locator::table_activity_stats table_activity_stats() const noexcept;
 
     const db::view::stats& get_view_stats() const {
         return _view_stats;
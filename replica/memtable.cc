@@ -626,9 +626,9 @@ class flush_reader final : public mutation_reader::impl, private iterator_reader
     mutation_reader_opt _partition_reader;
     flush_memory_accounter _flushed_memory;
 public:
-    flush_reader(schema_ptr s, reader_permit permit, lw_shared_ptr<memtable> m)
+    flush_reader(schema_ptr s, reader_permit permit, lw_shared_ptr<memtable> m, const dht::partition_range& range)
         : impl(s, std::move(permit))
-        , iterator_reader(std::move(s), m, query::full_partition_range)
+        , iterator_reader(std::move(s), m, range)
         , _flushed_memory(*m)
     {}
     flush_reader(const flush_reader&) = delete;
@@ -745,16 +745,52 @@ memtable::make_flat_reader_opt(schema_ptr query_schema,
 }
 
 mutation_reader
-memtable::make_flush_reader(schema_ptr s, reader_permit permit) {
+memtable::make_flush_reader(schema_ptr s, reader_permit permit, const dht::partition_range& range) {
     if (!_merged_into_cache) {
-        return make_mutation_reader<flush_reader>(std::move(s), std::move(permit), shared_from_this());
+        return make_mutation_reader<flush_reader>(std::move(s), std::move(permit), shared_from_this(), range);
     } else {
         auto& full_slice = s->full_slice();
         return make_mutation_reader<scanning_reader>(std::move(s), shared_from_this(), std::move(permit),
-                      query::full_partition_range, full_slice, mutation_reader::forwarding::no);
+                      range, full_slice, mutation_reader::forwarding::no);
     }
 }
 
+dht::partition_range_vector
+memtable::split_token_span(size_t count) const {
+    if (count <= 1 || partitions.empty()) {
+        return {query::full_partition_range};
+    }
+
+    auto first = partitions.begin()->key().token().raw();
+    auto last = std::prev(partitions.end())->key().token().raw();
+    uint64_t step = (uint64_t(last) - uint64_t(first)) / count;
+    if (step == 0) {
+        return {query::full_partition_range};
+    }
+
+    auto cmp = dht::ring_position_comparator(*_schema);
+    dht::partition_range_vector ranges;
+    ranges.reserve(count);
+    std::optional<dht::token> start;
+    for (size_t i = 1; i <= count; ++i) {
+        std::optional<dht::token> end;
+        if (i < count) {
+            end = dht::token::from_int64(int64_t(uint64_t(first) + step * i));
+        }
+        // Extend ranges with no partitions into the next one, so that they
+        // don't produce empty sstables. The last range always has partitions.
+        auto it = start ? partitions.lower_bound(dht::ring_position::starting_at(*start), cmp) : partitions.begin();
+        if (end && (it == partitions.end() || !(it->key().token() < *end))) {
+            continue;
+        }
+        ranges.emplace_back(
+                start ? std::make_optional(dht::partition_range::bound(dht::ring_position::starting_at(*start), true)) : std::nullopt,
+                end ? std::make_optional(dht::partition_range::bound(dht::ring_position::starting_at(*end), false)) : std::nullopt);
+        start = end;
+    }
+    return ranges;
+}
+
 void
 memtable::update(db::rp_handle&& h) {
     db::replay_position rp = h;
@@ -298,7 +298,15 @@ class memtable final : public enable_lw_shared_from_this<memtable>, private dirt
         return make_flat_reader(s, std::move(permit), range, full_slice);
     }
 
-    mutation_reader make_flush_reader(schema_ptr, reader_permit permit);
+    // The 'range' parameter must be live as long as the reader is being used.
+    // Flush readers of non-overlapping ranges may be used concurrently.
+    mutation_reader make_flush_reader(schema_ptr, reader_permit permit, const dht::partition_range& range = query::full_partition_range);
+
+    // Splits the token span of this memtable's partitions into at most
+    // @count non-overlapping partition ranges of similar width. A range
+    // which would contain no partitions is merged into the next one, so
+    // every returned range is non-empty and together they cover the ring.
+    dht::partition_range_vector split_token_span(size_t count) const;
 
     mutation_source as_data_source();
 
@@ -488,6 +488,65 @@ sstables::shared_sstable table::make_sstable() {
     return make_sstable(sstables::sstable_state::normal);
 }
 
+future<sstables::shared_sstable> table::load_foreign_sstable(sstables::foreign_sstable_open_info info) {
+    auto& sstm = get_sstables_manager();
+    auto sst = sstm.make_sstable(_schema, *_storage_opts, info.generation, sstables::sstable_state::normal, info.version, info.format);
+    co_await sst->load(std::move(info));
+    co_return sst;
+}
+
+std::optional<uint32_t> table::compaction_chunk_length() const {
+    const auto& params = _schema->get_compressor_params();
+    if (!_config.compaction_adaptive_chunk_length() || !params.get_compressor()) {
+        return std::nullopt;
+    }
+    return compaction_chunk_length_for_reads(uint32_t(params.chunk_length()), _stats.point_reads.rate(), _stats.range_reads.rate(),
+            lowres_clock::now() - _stats.read_rates_since);
+}
+
+std::optional<uint32_t> table::compaction_chunk_length_for_reads(uint32_t configured,
+        const utils::rate_moving_average& point_read_rates, const utils::rate_moving_average& range_read_rates,
+        lowres_clock::duration tracked_for) {
+    static constexpr uint32_t point_read_chunk_length = 4 * 1024;
+    static constexpr uint32_t scan_chunk_length = 64 * 1024;
+    // Reads per second below which the table is considered cold.
+    static constexpr double cold_read_rate = 0.01;
+    // Share of point reads at or above which small chunks are used, and at or
+    // below which large chunks are used. Mixed workloads keep the configured
+    // chunk length.
+    static constexpr double point_read_dominated = 0.9;
+    static constexpr double scan_dominated = 0.1;
+    // The rates start from 0 when the node starts, or the table is created.
+    // Until they cover the averaging window, or enough reads were seen to
+    // tell the workload apart, every table would look cold.
+    static constexpr auto min_tracked_for = std::chrono::minutes(15);
+    static constexpr uint64_t min_classified_reads = 1000;
+
+    if (tracked_for < min_tracked_for && point_read_rates.count + range_read_rates.count < min_classified_reads) {
+        return std::nullopt;
+    }
+    // Use the 15 minute rates, to follow the workload without flapping
+    // between compactions.
+    auto point_reads = point_read_rates.rates[2];
+    auto range_reads = range_read_rates.rates[2];
+    if (point_reads + range_reads < cold_read_rate) {
+        // The rates are only updated periodically, so reads seen early on
+        // may not be reflected yet.
+        if (tracked_for < min_tracked_for) {
+            return std::nullopt;
+        }
+        return std::max(configured, scan_chunk_length);
+    }
+    auto point_read_share = point_reads / (point_reads + range_reads);
+    if (point_read_share >= point_read_dominated) {
+        return std::min(configured, point_read_chunk_length);
+    }
+    if (point_read_share <= scan_dominated) {
+        return std::max(configured, scan_chunk_length);
+    }
+    return std::nullopt;
+}
+
 db_clock::time_point table::get_truncation_time() const {
     if (!_truncated_at) [[unlikely]] {
         on_internal_error(dblog, ::format("truncation time is not set, table {}.{}",
@@ -1521,13 +1580,19 @@ table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtabl
         auto metadata = mutation_source_metadata{};
         metadata.min_timestamp = old->get_min_timestamp();
         metadata.max_timestamp = old->get_max_timestamp();
-        auto estimated_partitions = _compaction_strategy.adjust_partition_estimate(metadata, old->partition_count(), _schema);
+
+        // Large memtables are split by token range into several sstables
+        // which are written concurrently, overlapping their CPU work and I/O.
+        static constexpr size_t min_flush_split_size = 64 << 20;
+        auto split_count = std::min<size_t>(_config.memtable_flush_parallelism(), old->occupancy().used_space() / min_flush_split_size);
+        auto ranges = old->split_token_span(std::max<size_t>(split_count, 1));
+        auto estimated_partitions = _compaction_strategy.adjust_partition_estimate(metadata, old->partition_count(), _schema) / ranges.size();
 
         if (!cg.async_gate().is_closed()) {
             co_await _compaction_manager.maybe_wait_for_sstable_count_reduction(cg.as_table_state());
         }
 
-        auto consumer = _compaction_strategy.make_interposer_consumer(metadata, [this, old, permit, &newtabs, estimated_partitions, &cg] (mutation_reader reader) mutable -> future<> {
+        auto end_consumer = [this, old, permit, &newtabs, estimated_partitions, &cg] (mutation_reader reader) mutable -> future<> {
           std::exception_ptr ex;
           try {
             sstables::sstable_writer_config cfg = get_sstables_manager().configure_writer("memtable");
@@ -1546,11 +1611,19 @@ table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtabl
           }
           co_await reader.close();
           co_await coroutine::return_exception_ptr(std::move(ex));
-        });
+        };
 
-        auto f = consumer(old->make_flush_reader(
-            old->schema(),
-            compaction_concurrency_semaphore().make_tracking_only_permit(old->schema(), "try_flush_memtable_to_sstable()", db::no_timeout, {})));
+        if (ranges.size() > 1) {
+            tlogger.debug("Flushing memtable of {}.{} into {} token ranges", _schema->ks_name(), _schema->cf_name(), ranges.size());
+        }
+        auto f = parallel_for_each(ranges, [this, old, &metadata, &end_consumer] (const dht::partition_range& range) {
+            // Interposers may hold per-reader state, so each range gets its own.
+            auto consumer = _compaction_strategy.make_interposer_consumer(metadata, end_consumer);
+            return consumer(old->make_flush_reader(
+                old->schema(),
+                compaction_concurrency_semaphore().make_tracking_only_permit(old->schema(), "try_flush_memtable_to_sstable()", db::no_timeout, {}),
+                range));
+        });
 
         // Switch back to default scheduling group for post-flush actions, to avoid them being staved by the memtable flush
         // controller. Cache update does not affect the input of the memtable cpu controller, so it can be subject to
@@ -2214,8 +2287,12 @@ class compaction_group::table_state : public compaction::table_state {
     sstables::shared_sstable make_sstable() const override {
         return _t.make_sstable();
     }
+    future<sstables::shared_sstable> load_foreign_sstable(sstables::foreign_sstable_open_info info) const override {
+        return _t.load_foreign_sstable(std::move(info));
+    }
     sstables::sstable_writer_config configure_writer(sstring origin) const override {
         auto cfg = _t.get_sstables_manager().configure_writer(std::move(origin));
+        cfg.compression_chunk_length = _t.compaction_chunk_length();
         return cfg;
     }
     api::timestamp_type min_memtable_timestamp() const override {
@@ -2368,6 +2445,13 @@ locator::table_load_stats table::table_load_stats(std::function<bool(const locat
     return _sg_manager->table_load_stats(std::move(tablet_filter));
 }
 
+locator::table_activity_stats table::table_activity_stats() const noexcept {
+    return locator::table_activity_stats{
+        .reads_per_second = _stats.reads().rate().rates[1],
+        .writes_per_second = _stats.writes().rate().rates[1],
+    };
+}
+
 future<> tablet_storage_group_manager::handle_tablet_split_completion(const locator::tablet_map& old_tmap, const locator::tablet_map& new_tmap) {
     auto table_id = schema()->id();
     size_t old_tablet_count = old_tmap.tablet_count();
@@ -3294,6 +3378,10 @@ table::query(schema_ptr query_schema,
     const auto table_async_gate_holder = _async_gate.hold();
     utils::latency_counter lc;
     _stats.reads.set_latency(lc);
+    const bool point_read = std::ranges::all_of(partition_ranges, [] (const dht::partition_range& pr) {
+        return pr.is_singular();
+    });
+    (point_read ? _stats.point_reads : _stats.range_reads).mark();
 
     auto finally = defer([&] () noexcept {
         _stats.reads.mark(lc);
@@ -5719,6 +5719,27 @@ storage_proxy::query_result_local(locator::effective_replication_map_ptr erm, sc
     }
 }
 
+future<std::optional<storage_proxy::coordinator_query_result>>
+storage_proxy::query_singular_locally(schema_ptr s, lw_shared_ptr<query::read_command> cmd, const dht::decorated_key& key,
+                                      storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr trace_state) {
+    replica::table& table = _db.local().find_column_family(s->id());
+    auto erm = table.get_effective_replication_map();
+    const auto replicas = erm->get_replicas_for_reading(key.token());
+    const auto me = my_host_id(*erm);
+    if (std::ranges::find(replicas, me) == replicas.end()) {
+        co_return std::nullopt;
+    }
+
+    tracing::trace(trace_state, "Querying the local replica of {}", key);
+    auto pr = dht::partition_range::make_singular(key);
+    auto fence = get_fence(*erm);
+    auto [result, hit_rate] = co_await apply_fence(query_result_local(erm, std::move(s), std::move(cmd), pr, query::result_options::only_result(),
+            std::move(trace_state), timeout, db::per_partition_rate_limit::info{}), fence, my_address());
+    replicas_per_token_range used_replicas;
+    used_replicas.emplace(dht::token_range::make_singular(key.token()), std::vector<locator::host_id>{me});
+    co_return coordinator_query_result(std::move(result), std::move(used_replicas));
+}
+
 void storage_proxy::handle_read_error(std::variant<exceptions::coordinator_exception_container, std::exception_ptr> failure, bool range) {
     // All errors are handled, it's OK to discard the result.
     (void)utils::result_try([&] () -> result<> {
@@ -680,6 +680,22 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
         db::consistency_level cl,
         coordinator_query_options optional_params);
 
+    /*
+     * Executes a single-partition data query directly against this node's
+     * replica of the partition: the owning shard reads its memtables and row
+     * cache without going through the coordinator read path (replica
+     * selection, speculative retries, digest reconciliation).
+     *
+     * Only suitable for reads that a single replica may answer (CL ONE,
+     * LOCAL_ONE). Returns a disengaged optional if this node is not a replica
+     * the partition may be read from, in which case the caller is expected to
+     * fall back to query().
+     */
+    future<std::optional<coordinator_query_result>> query_singular_locally(schema_ptr,
+        lw_shared_ptr<query::read_command> cmd, const dht::decorated_key& key,
+        clock_type::time_point timeout,
+        tracing::trace_state_ptr trace_state = nullptr);
+
     future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>> query_mutations_locally(
         schema_ptr, lw_shared_ptr<query::read_command> cmd, const dht::partition_range&,
         clock_type::time_point timeout,
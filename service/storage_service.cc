@@ -6529,6 +6529,29 @@ future<locator::load_stats> storage_service::load_stats_for_tablet_based_tables(
     co_return std::move(load_stats);
 }
 
+future<std::unordered_map<table_id, locator::table_activity_stats>> storage_service::activity_stats_for_tablet_based_tables() {
+    auto holder = _async_gate.hold();
+
+    using activity_map = std::unordered_map<table_id, locator::table_activity_stats>;
+
+    // Rates are summed over shards, so the coordinator sees the load of the whole node.
+    co_return co_await _db.map_reduce0([] (replica::database& db) -> future<activity_map> {
+        activity_map activity;
+        co_await db.get_tables_metadata().for_each_table_gently([&] (table_id id, lw_shared_ptr<replica::table> table) {
+            if (table->uses_tablets()) {
+                activity.emplace(id, table->table_activity_stats());
+            }
+            return make_ready_future<>();
+        });
+        co_return std::move(activity);
+    }, activity_map{}, [] (activity_map a, const activity_map& b) {
+        for (auto& [id, stats] : b) {
+            a[id] += stats;
+        }
+        return a;
+    });
+}
+
 future<> storage_service::transit_tablet(table_id table, dht::token token, noncopyable_function<std::tuple<std::vector<canonical_mutation>, sstring>(const locator::tablet_map&, api::timestamp_type)> prepare_mutations) {
     while (true) {
         auto guard = co_await _group0->client().start_operation(_group0_as, raft_timeout{});
@@ -7067,6 +7090,11 @@ void storage_service::init_messaging_service() {
             return ss.load_stats_for_tablet_based_tables();
         });
     });
+    ser::storage_service_rpc_verbs::register_table_activity_stats(&_messaging.local(), [handle_raft_rpc] (raft::server_id dst_id) {
+        return handle_raft_rpc(dst_id, [] (auto& ss) mutable {
+            return ss.activity_stats_for_tablet_based_tables();
+        });
+    });
     ser::join_node_rpc_verbs::register_join_node_request(&_messaging.local(), [handle_raft_rpc] (raft::server_id dst_id, service::join_node_request_params params) {
         return handle_raft_rpc(dst_id, [params = std::move(params)] (auto& ss) mutable {
             return ss.join_node_request_handler(std::move(params));
@@ -207,6 +207,8 @@ class storage_service : public service::migration_listener, public gms::i_endpoi
     inet_address host2ip(locator::host_id) const;
     // Handler for table load stats RPC.
     future<locator::load_stats> load_stats_for_tablet_based_tables();
+    // Handler for table activity stats RPC.
+    future<std::unordered_map<table_id, locator::table_activity_stats>> activity_stats_for_tablet_based_tables();
     future<> process_tablet_split_candidate(table_id) noexcept;
     void register_tablet_split_candidate(table_id) noexcept;
     future<> run_tablet_split_monitor();
@@ -16,7 +16,6 @@
 #include "utils/error_injection.hh"
 #include "utils/stall_free.hh"
 #include "db/config.hh"
-#include "locator/load_sketch.hh"
 #include "replica/database.hh"
 #include "gms/feature_service.hh"
 #include <utility>
@@ -183,10 +182,13 @@ struct fmt::formatter<service::migration_candidate> : fmt::formatter<std::string
 
 namespace service {
 
-/// The algorithm aims to equalize tablet count on each shard.
-/// This goal is based on the assumption that every shard has similar processing power and space capacity,
-/// and that each tablet has equal consumption of those resources. So by equalizing tablet count per shard we
-/// equalize resource utilization.
+/// The algorithm aims to equalize tablet load on each shard.
+/// This goal is based on the assumption that every shard has similar processing power and space capacity.
+/// The load of a tablet replica is its weight, derived from per-table statistics collected from replicas
+/// (disk space used, reads/s and writes/s) by locator::get_tablet_load_weights(). Tablets of a table which has
+/// average load weigh 1, so when no statistics are available, the load is equal to the tablet count.
+/// By equalizing tablet load per shard we equalize resource utilization, also when some tables are much
+/// hotter or bigger than others.
 ///
 /// The algorithm produces a migration plan which is a set of instructions about which tablets to move
 /// where. The plan is a small increment, not a complete plan. To achieve balance, the algorithm should
@@ -197,7 +199,7 @@ namespace service {
 /// from the most loaded node first. We also track load per shard, so that we move tablets from the most
 /// loaded shard on a given node first.
 ///
-/// The metric for node load is (number of tablets / shard count) which is the average
+/// The metric for node load is (sum of tablet weights / shard count) which is the average
 /// per-shard load. If we achieve balance according to this metric, and then rebalance the nodes internally,
 /// we will achieve global balance on all shards in the cluster.
 ///
@@ -267,12 +269,15 @@ class load_balancer {
     using shard_id = seastar::shard_id;
 
     // Represents metric for per-node load which we want to equalize between nodes.
-    // It's an average per-shard load in terms of tablet count.
+    // It's an average per-shard load in terms of tablet weight.
     using load_type = double;
 
     struct shard_load {
         size_t tablet_count = 0;
 
+        // Sum of weights of tablets on this shard.
+        load_type load = 0;
+
         absl::flat_hash_map<table_id, size_t> tablet_count_per_table;
 
         // Number of tablets which are streamed from this shard.
@@ -321,6 +326,8 @@ class load_balancer {
         host_id id;
         uint64_t shard_count = 0;
         uint64_t tablet_count = 0;
+        // Sum of weights of tablets on this node.
+        load_type load = 0;
         bool drained = false;
         const locator::node* node; // never nullptr
 
@@ -349,21 +356,31 @@ class load_balancer {
             return node->get_state();
         }
 
-        // Call when tablet_count changes.
+        // Call when load changes.
         void update() {
-            avg_load = get_avg_load(tablet_count);
+            avg_load = get_avg_load(load);
         }
 
-        load_type get_avg_load(uint64_t tablets) const {
-            return double(tablets) / shard_count;
+        load_type get_avg_load(load_type load) const {
+            return load / shard_count;
         }
 
         auto shards_by_load_cmp() {
             return [this] (const auto& a, const auto& b) {
-                return shards[a].tablet_count < shards[b].tablet_count;
+                return shards[a].load < shards[b].load;
             };
         }
 
+        shard_id least_loaded_shard() const {
+            shard_id result = 0;
+            for (shard_id shard = 1; shard < shards.size(); ++shard) {
+                if (shards[shard].load < shards[result].load) {
+                    result = shard;
+                }
+            }
+            return result;
+        }
+
         future<> clear_gently() {
             co_await utils::clear_gently(shards);
             co_await utils::clear_gently(skipped_candidates);
@@ -525,8 +542,9 @@ class load_balancer {
 
     replica::database& _db;
     token_metadata_ptr _tm;
-    std::optional<locator::load_sketch> _load_sketch;
     absl::flat_hash_map<table_id, size_t> _tablet_count_per_table;
+    std::unordered_map<table_id, load_type> _tablet_weights;
+    load_type _min_tablet_weight = 1; // Among all tables.
     dc_name _dc;
     size_t _total_capacity_shards; // Total number of non-drained shards in the balanced node set.
     size_t _total_capacity_nodes; // Total number of non-drained nodes in the balanced node set.
@@ -588,6 +606,8 @@ class load_balancer {
         const locator::topology& topo = _tm->get_topology();
         migration_plan plan;
 
+        compute_tablet_weights();
+
         // Prepare plans for each DC separately and combine them to be executed in parallel.
         for (auto&& dc : topo.get_datacenters()) {
             auto dc_plan = co_await make_plan(dc);
@@ -609,6 +629,22 @@ class load_balancer {
         _use_table_aware_balancing = use_table_aware_balancing;
     }
 
+    load_type tablet_weight(table_id table) const {
+        auto i = _tablet_weights.find(table);
+        return i != _tablet_weights.end() ? i->second : 1;
+    }
+
+    void compute_tablet_weights() {
+        if (_table_load_stats) {
+            _tablet_weights = locator::get_tablet_load_weights(_tm->tablets(), *_table_load_stats);
+        }
+        _min_tablet_weight = 1;
+        for (auto&& [table, weight] : _tablet_weights) {
+            _min_tablet_weight = std::min(_min_tablet_weight, weight);
+            lblogger.debug("Table {} tablet weight: {:.3f}", table, weight);
+        }
+    }
+
     const locator::table_load_stats* load_stats_for_table(table_id id) const {
         if (!_table_load_stats) {
             return nullptr;
@@ -1094,7 +1130,10 @@ class load_balancer {
     // The assumption is that the algorithm moves tablets from more loaded nodes to less loaded nodes,
     // so convergence is reached where the node we picked as source has lower load, or will have lower
     // load post-movement, than the node we picked as the destination.
-    bool check_convergence(node_load& src_info, node_load& dst_info) {
+    //
+    // The weight is the load of the moved tablet. When the tablet is not known yet,
+    // pass the lowest tablet weight, which yields a necessary condition for any movement.
+    bool check_convergence(node_load& src_info, node_load& dst_info, load_type weight) {
         // Allow migrating only from candidate nodes which have higher load than the target.
         if (src_info.avg_load <= dst_info.avg_load) {
             lblogger.trace("Load inversion: src={} (avg_load={}), dst={} (avg_load={})",
@@ -1103,8 +1142,8 @@ class load_balancer {
         }
 
         // Prevent load inversion post-movement which can lead to oscillations.
-        if (src_info.get_avg_load(src_info.tablet_count - 1) <
-            dst_info.get_avg_load(dst_info.tablet_count + 1)) {
+        if (src_info.get_avg_load(src_info.load - weight) <
+            dst_info.get_avg_load(dst_info.load + weight)) {
             lblogger.trace("Load inversion post-movement: src={} (avg_load={}), dst={} (avg_load={})",
                            src_info.id, src_info.avg_load, dst_info.id, dst_info.avg_load);
             return false;
@@ -1123,8 +1162,6 @@ class load_balancer {
             co_return plan;
         }
 
-        auto& sketch = *_load_sketch;
-
         // Keeps candidate source shards in a heap which yields highest-loaded shard first.
         std::vector<shard_id> src_shards;
         src_shards.reserve(node_load.shard_count);
@@ -1133,7 +1170,7 @@ class load_balancer {
         }
         std::make_heap(src_shards.begin(), src_shards.end(), node_load.shards_by_load_cmp());
 
-        size_t max_load = 0; // Tracks max load among shards which ran out of candidates.
+        load_type max_load = 0; // Tracks max load among shards which ran out of candidates.
 
         while (true) {
             co_await coroutine::maybe_yield();
@@ -1158,7 +1195,7 @@ class load_balancer {
             } else {
                 std::pop_heap(src_shards.begin(), src_shards.end(), node_load.shards_by_load_cmp());
                 src = src_shards.back();
-                dst = sketch.get_least_loaded_shard(host);
+                dst = node_load.least_loaded_shard();
             }
 
             auto push_back = seastar::defer([&] {
@@ -1174,14 +1211,14 @@ class load_balancer {
             // Convergence check
 
             // When in shuffle mode, exit condition is guaranteed by running out of candidates or by load limit.
-            if (!shuffle && (src == dst || src_info.tablet_count <= dst_info.tablet_count + 1)) {
+            if (!shuffle && (src == dst || src_info.load < dst_info.load + 2 * _min_tablet_weight)) {
                 lblogger.debug("Node {} is balanced", host);
                 break;
             }
 
             if (!src_info.has_candidates()) {
                 lblogger.debug("No more candidates on shard {} of {}", src, host);
-                max_load = std::max(max_load, src_info.tablet_count);
+                max_load = std::max(max_load, src_info.load);
                 src_shards.pop_back();
                 push_back.cancel();
                 continue;
@@ -1189,6 +1226,15 @@ class load_balancer {
 
             auto candidate = co_await peek_candidate(nodes, src_info, tablet_replica{host, src}, tablet_replica{host, dst});
             auto tablet = candidate.tablet;
+            auto weight = tablet_weight(tablet.table);
+
+            // Prevent load inversion post-movement. The candidate may be heavier than
+            // other tablets on the shard, so drop it and keep looking for lighter ones.
+            if (!shuffle && src_info.load - weight < dst_info.load + weight) {
+                lblogger.debug("Moving tablet {} (weight={:.3f}) on node {} would invert load, skipping", tablet, weight, host);
+                erase_candidate(src_info, tablet);
+                continue;
+            }
 
             // Emit migration.
 
@@ -1218,10 +1264,10 @@ class load_balancer {
 
             dst_info.tablet_count++;
             src_info.tablet_count--;
+            dst_info.load += weight;
+            src_info.load -= weight;
             dst_info.tablet_count_per_table[tablet.table]++;
             src_info.tablet_count_per_table[tablet.table]--;
-            sketch.pick(host, dst);
-            sketch.unload(host, src);
         }
 
         co_return plan;
@@ -1393,7 +1439,7 @@ class load_balancer {
                 auto& new_target_info = nodes[new_target];
 
                 // Skip movements which may harm convergence.
-                if (!src_node_info.drained && !check_convergence(src_node_info, new_target_info)) {
+                if (!src_node_info.drained && !check_convergence(src_node_info, new_target_info, tablet_weight(tablet.table))) {
                     continue;
                 }
 
@@ -1723,7 +1769,7 @@ class load_balancer {
                     break;
                 }
 
-                if (!check_convergence(src_node_info, target_info)) {
+                if (!check_convergence(src_node_info, target_info, _min_tablet_weight)) {
                     lblogger.debug("No more candidates. Load would be inverted.");
                     _stats.for_dc(dc).stop_load_inversion++;
                     break;
@@ -1732,8 +1778,8 @@ class load_balancer {
 
             // Pick best target shard.
 
-            auto dst = global_shard_id {target, _load_sketch->get_least_loaded_shard(target)};
-            lblogger.trace("target shard: {}, load={}", dst.shard, target_info.shards[dst.shard].tablet_count);
+            auto dst = global_shard_id {target, target_info.least_loaded_shard()};
+            lblogger.trace("target shard: {}, load={}", dst.shard, target_info.shards[dst.shard].load);
 
             if (lblogger.is_enabled(seastar::log_level::trace)) {
                 shard_id shard = 0;
@@ -1750,11 +1796,20 @@ class load_balancer {
             auto candidate = co_await pick_candidate(nodes, src_node_info, target_info, src, dst, nodes_by_load_dst,
                                                      drain_skipped);
             auto source_tablet = candidate.tablet;
+            auto weight = tablet_weight(source_tablet.table);
             src = candidate.src;
             dst = candidate.dst;
 
             auto& tmap = tmeta.get_tablet_map(source_tablet.table);
 
+            // The check above assumed the lightest tablet. The candidate can be heavier,
+            // in which case moving it would invert load. Leave it in place and look for lighter candidates.
+            if (!shuffle && nodes_to_drain.empty() && !check_convergence(src_node_info, nodes[dst.host], weight)) {
+                lblogger.debug("Candidate {} (weight={:.3f}) skipped, load would be inverted", source_tablet, weight);
+                erase_candidate(src_node_info.shards[src.shard], source_tablet);
+                continue;
+            }
+
             // Check replication strategy constraints.
 
             // When drain_skipped is true, we already picked movement to a viable target.
@@ -1786,8 +1841,6 @@ class load_balancer {
             auto& src_tinfo = tmap.get_tablet_info(source_tablet.tablet);
             auto mig_streaming_info = get_migration_streaming_info(topo, src_tinfo, mig);
 
-            _load_sketch->pick(dst.host, dst.shard);
-
             if (can_accept_load(nodes, mig_streaming_info)) {
                 apply_load(nodes, mig_streaming_info);
                 lblogger.debug("Adding migration: {}", mig);
@@ -1818,18 +1871,22 @@ class load_balancer {
             {
                 auto& target_info = nodes[dst.host];
                 target_info.shards[dst.shard].tablet_count++;
+                target_info.shards[dst.shard].load += weight;
                 target_info.shards[dst.shard].tablet_count_per_table[source_tablet.table]++;
                 target_info.tablet_count_per_table[source_tablet.table]++;
                 target_info.tablet_count += 1;
+                target_info.load += weight;
                 target_info.update();
             }
 
             auto& src_shard_info = src_node_info.shards[src.shard];
             src_shard_info.tablet_count -= 1;
+            src_shard_info.load -= weight;
             src_shard_info.tablet_count_per_table[source_tablet.table]--;
             src_node_info.tablet_count_per_table[source_tablet.table]--;
 
             src_node_info.tablet_count -= 1;
+            src_node_info.load -= weight;
             src_node_info.update();
             if (src_node_info.tablet_count == 0) {
                 push_back_node_candidate.cancel();
@@ -1950,6 +2007,7 @@ class load_balancer {
                 for (auto&& replica : get_replicas_for_tablet_load(ti, trinfo)) {
                     if (nodes.contains(replica.host)) {
                         nodes[replica.host].tablet_count += 1;
+                        nodes[replica.host].load += tablet_weight(table);
                         // This invariant is assumed later.
                         if (replica.shard >= nodes[replica.host].shard_count) {
                             auto gtid = global_tablet_id{table, tid};
@@ -2013,7 +2071,7 @@ class load_balancer {
                 read += shard_load.streaming_read_load;
                 write += shard_load.streaming_write_load;
             }
-            lblogger.info("Node {}: rack={} avg_load={} tablets={} shards={} state={} stream_read={} stream_write={}",
+            lblogger.info("Node {}: rack={} avg_load={:.3f} tablets={} shards={} state={} stream_read={} stream_write={}",
                           host, load.rack(), load.avg_load, load.tablet_count, load.shard_count, load.state(), read, write);
         }
 
@@ -2035,13 +2093,12 @@ class load_balancer {
 
         // Compute per-shard load and candidate tablets.
 
-        _load_sketch = locator::load_sketch(_tm);
-        co_await _load_sketch->populate_dc(dc);
         _tablet_count_per_table.clear();
 
         for (auto&& [table, tmap_] : _tm->tablets().all_tables()) {
             auto& tmap = *tmap_;
             uint64_t total_load = 0;
+            auto weight = tablet_weight(table);
             co_await tmap.for_each_tablet([&, table = table] (tablet_id tid, const tablet_info& ti) -> future<> {
                 auto trinfo = tmap.get_tablet_transition_info(tid);
 
@@ -2059,6 +2116,7 @@ class load_balancer {
                         node_load_info.shards_by_load.push_back(replica.shard);
                     }
                     shard_load_info.tablet_count += 1;
+                    shard_load_info.load += weight;
                     shard_load_info.tablet_count_per_table[table]++;
                     node_load_info.tablet_count_per_table[table]++;
                     total_load++;
@@ -2787,6 +2787,13 @@ future<locator::load_stats> topology_coordinator::refresh_tablet_load_stats() {
                                                                                              as,
                                                                                              raft::server_id(dst.uuid()));
 
+            if (_feature_service.tablet_load_stats_activity) {
+                node_stats.activity = co_await ser::storage_service_rpc_verbs::send_table_activity_stats(&_messaging,
+                                                                                                        dst,
+                                                                                                        as,
+                                                                                                        raft::server_id(dst.uuid()));
+            }
+
             dc_stats += node_stats;
         });
 
@@ -2824,6 +2831,11 @@ future<locator::load_stats> topology_coordinator::refresh_tablet_load_stats() {
         // for a single table replica. This allows the load balancer to compute, in turn,
         // the average tablet size by dividing total size by tablet count.
         table_load_stats.size_in_bytes /= table_total_replicas;
+        // Same for request rates, so that per-tablet rates are comparable with per-tablet sizes.
+        if (auto i = stats.activity.find(table_id); i != stats.activity.end()) {
+            i->second.reads_per_second /= table_total_replicas;
+            i->second.writes_per_second /= table_total_replicas;
+        }
     }
     rtlogger.debug("raft topology: Refreshed table load stats for all DC(s).");
 
@@ -26,6 +26,7 @@ enum class component_type {
     TemporaryTOC,
     TemporaryStatistics,
     Scylla,
+    RowFilter,
     Unknown,
 };
 
@@ -63,6 +64,8 @@ struct fmt::formatter<sstables::component_type> : fmt::formatter<string_view> {
             return formatter<string_view>::format("TemporaryStatistics", ctx);
         case Scylla:
             return formatter<string_view>::format("Scylla", ctx);
+        case RowFilter:
+            return formatter<string_view>::format("RowFilter", ctx);
         case Unknown:
             return formatter<string_view>::format("Unknown", ctx);
         }
@@ -128,11 +128,56 @@ class HyperLogLog {
         alphaMM_ = alpha * m_ * m_;
     }
 
-    static HyperLogLog from_bytes(temporary_buffer<uint8_t> bytes) {
-        // FIXME: implement class that creates a HyperLogLog from an array of bytes.
-        // This will useful if we need to work with the cardinality data from the
-        // compaction metadata.
-        abort();
+    /**
+     * Creates a HyperLogLog from the serialized form produced by get_bytes().
+     *
+     * @param[in] bytes random-access range of the serialized bytes
+     *
+     * @exception std::invalid_argument the serialized form is malformed, or
+     *            not supported, e.g. the sparse or packed register formats
+     *            of HyperLogLog++ written by Cassandra.
+     */
+    template <typename Bytes>
+    static HyperLogLog from_bytes(const Bytes& bytes) {
+        size_t offset = 0;
+        auto read_byte = [&] {
+            if (offset >= bytes.size()) {
+                throw std::invalid_argument("truncated cardinality metadata");
+            }
+            return uint8_t(bytes[offset++]);
+        };
+        auto read_unsigned_var_int = [&] {
+            unsigned int value = 0;
+            for (unsigned shift = 0; shift < 32; shift += 7) {
+                uint8_t b = read_byte();
+                value |= unsigned(b & 0x7F) << shift;
+                if (!(b & 0x80)) {
+                    return value;
+                }
+            }
+            throw std::invalid_argument("malformed varint in cardinality metadata");
+        };
+
+        uint32_t version = 0;
+        for (size_t i = 0; i < sizeof(version); i++) {
+            version = (version << 8) | read_byte();
+        }
+        if (int32_t(version) != -2) {
+            throw std::invalid_argument("unsupported cardinality metadata version");
+        }
+        auto p = read_unsigned_var_int();
+        auto sp = read_unsigned_var_int();
+        auto type = read_unsigned_var_int();
+        auto size = read_unsigned_var_int();
+        // Only the dense format with one byte per register is supported.
+        if (sp != 0 || type != 0 || p < 4 || p > 16 || size != (1u << p)) {
+            throw std::invalid_argument("unsupported cardinality metadata format");
+        }
+        HyperLogLog hll(p);
+        for (uint32_t i = 0; i < size; i++) {
+            hll.M_[i] = read_byte();
+        }
+        return hll;
     }
 
     /**
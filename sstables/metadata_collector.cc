@@ -51,4 +51,67 @@ void metadata_collector::update_min_max_components(position_in_partition_view po
     }
 }
 
+tombstone_token_histogram_collector::tombstone_token_histogram_collector(uint64_t estimated_partitions)
+    : _partitions_per_bucket(std::max(uint64_t(1), estimated_partitions / target_buckets))
+{
+}
+
+void tombstone_token_histogram_collector::merge_buckets() {
+    size_t merged = 0;
+    for (size_t i = 0; i < _buckets.size(); i += 2, ++merged) {
+        auto b = _buckets[i];
+        if (i + 1 < _buckets.size()) {
+            const auto& next = _buckets[i + 1];
+            b.last_token = next.last_token;
+            b.partitions += next.partitions;
+            b.cells += next.cells;
+            b.tombstones += next.tombstones;
+            b.min_deletion_time = std::min(b.min_deletion_time, next.min_deletion_time);
+            b.max_deletion_time = std::max(b.max_deletion_time, next.max_deletion_time);
+        }
+        _buckets[merged] = b;
+    }
+    _buckets.resize(merged);
+    _partitions_per_bucket *= 2;
+}
+
+void tombstone_token_histogram_collector::update(dht::token token, const column_stats& stats) {
+    // Partitions sharing a token must land in the same bucket, so that
+    // buckets never overlap in token order.
+    auto needs_new_bucket = [&] {
+        return _buckets.empty() || (_buckets.back().partitions >= _partitions_per_bucket && _buckets.back().last_token != token.raw());
+    };
+    if (needs_new_bucket() && _buckets.size() == 2 * target_buckets) {
+        merge_buckets();
+    }
+    if (needs_new_bucket()) {
+        _buckets.push_back(tombstone_token_histogram_bucket{
+            .first_token = token.raw(),
+            .last_token = token.raw(),
+            .partitions = 0,
+            .cells = 0,
+            .tombstones = 0,
+            .min_deletion_time = std::numeric_limits<int32_t>::max(),
+            .max_deletion_time = std::numeric_limits<int32_t>::min(),
+        });
+    }
+    auto& b = _buckets.back();
+    b.last_token = token.raw();
+    ++b.partitions;
+    b.cells += stats.cells_count;
+    if (stats.tombstones_count) {
+        b.tombstones += stats.tombstones_count;
+        b.min_deletion_time = std::min(b.min_deletion_time, stats.tombstone_deletion_time_tracker.min());
+        b.max_deletion_time = std::max(b.max_deletion_time, stats.tombstone_deletion_time_tracker.max());
+    }
+}
+
+scylla_metadata::tombstone_token_histogram tombstone_token_histogram_collector::get() && {
+    scylla_metadata::tombstone_token_histogram histogram;
+    for (auto& b : _buckets) {
+        histogram.elements.push_back(std::move(b));
+    }
+    return histogram;
+}
+
 } // namespace sstables
@@ -54,6 +54,9 @@ struct column_stats {
     min_max_tracker<int32_t> ttl_tracker;
     /** histogram of tombstone drop time */
     utils::streaming_histogram tombstone_histogram;
+    /** number of entries in tombstone_histogram, and their smallest/largest drop time */
+    uint64_t tombstones_count;
+    min_max_tracker<int32_t> tombstone_deletion_time_tracker;
 
     bool has_legacy_counter_shards;
     bool capped_local_deletion_time = false;
@@ -69,6 +72,7 @@ struct column_stats {
         min_live_timestamp_tracker(api::max_timestamp),
         min_live_row_marker_timestamp_tracker(api::max_timestamp),
         tombstone_histogram(TOMBSTONE_HISTOGRAM_BIN_SIZE),
+        tombstones_count(0),
         has_legacy_counter_shards(false)
         {
     }
@@ -96,6 +100,8 @@ struct column_stats {
         int32_t ldt = adjusted_local_deletion_time(value, capped);
         local_deletion_time_tracker.update(ldt);
         tombstone_histogram.update(ldt);
+        ++tombstones_count;
+        tombstone_deletion_time_tracker.update(ldt);
         capped_local_deletion_time |= capped;
     }
     void update_ttl(int32_t value) {
@@ -120,8 +126,8 @@ class metadata_collector {
     static constexpr double NO_COMPRESSION_RATIO = -1.0;
 
     static hll::HyperLogLog hyperloglog(int p, int sp) {
-        // FIXME: hll::HyperLogLog doesn't support sparse format, so ignoring parameters by the time being.
-        return hll::HyperLogLog();
+        // FIXME: hll::HyperLogLog doesn't support sparse format, so ignoring sp by the time being.
+        return hll::HyperLogLog(p);
     }
 private:
     const schema& _schema;
@@ -148,11 +154,12 @@ class metadata_collector {
 
     /**
      * Default cardinality estimation method is to use HyperLogLog++.
-     * Parameter here(p=13, sp=25) should give reasonable estimation
-     * while lowering bytes required to hold information.
-     * See CASSANDRA-5906 for detail.
+     * Cassandra uses p=13, sp=25, see CASSANDRA-5906 for detail.
+     * Registers are stored densely, one byte each, and are kept in memory
+     * with the rest of the statistics, so we use p=10: 1KB per sstable,
+     * for a standard error of about 3%.
      */
-    hll::HyperLogLog _cardinality = hyperloglog(13, 25);
+    hll::HyperLogLog _cardinality = hyperloglog(10, 25);
 private:
     void convert(disk_array<uint32_t, disk_string<uint16_t>>&to, const std::optional<position_in_partition>& from);
 public:
@@ -261,4 +268,27 @@ class metadata_collector {
     }
 };
 
+// Splits the partitions written into an sstable into buckets of partitions
+// adjacent in token order, and counts the cells and tombstones of each.
+// Compaction uses it to find the token ranges which hold the droppable
+// tombstones of the sstable.
+//
+// The bucket size is derived from the estimated partition count. When the
+// estimate is too low and the number of buckets doubles, adjacent buckets
+// are merged pairwise, so the histogram stays within 2 * target_buckets.
+class tombstone_token_histogram_collector {
+    uint64_t _partitions_per_bucket;
+    std::vector<tombstone_token_histogram_bucket> _buckets;
+
+    void merge_buckets();
+public:
+    static constexpr size_t target_buckets = 32;
+
+    explicit tombstone_token_histogram_collector(uint64_t estimated_partitions);
+
+    void update(dht::token token, const column_stats& stats);
+
+    scylla_metadata::tombstone_token_histogram get() &&;
+};
+
 }
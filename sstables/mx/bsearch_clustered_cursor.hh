@@ -14,6 +14,7 @@
 #include "schema/schema.hh"
 #include "utils/assert.hh"
 #include "utils/cached_file.hh"
+#include "utils/div_ceil.hh"
 #include "utils/to_string.hh"
 
 #include <seastar/core/byteorder.hh>
@@ -99,6 +100,7 @@ class cached_promoted_index {
         uint64_t populations = 0; // Number of promoted_index_blocks which got inserted
         uint64_t block_count = 0; // Number of promoted_index_blocks currently cached
         uint64_t used_bytes = 0; // Number of bytes currently used by promoted_index_blocks
+        uint64_t prefetches = 0; // Number of promoted indexes which were read as a whole ahead of the lookup
     };
 
     struct block_comparator {
@@ -177,10 +179,44 @@ class cached_promoted_index {
     reader_permit _permit;
     cached_file::stream _stream;
     logalloc::allocating_section _as;
+    bool _prefetch_attempted = false;
+public:
+    // Promoted indexes not larger than this are read as a whole, in a single I/O,
+    // before the first lookup. Otherwise, the binary search would go to disk for
+    // each page it touches, one page after another.
+    static constexpr uint64_t max_prefetch_size = 32 * 1024;
 private:
+    // Populates the page cache with the pages spanned by the promoted index.
+    // Pages missing in the cache are read together with the pages following them.
+    future<> prefetch(tracing::trace_state_ptr trace_state) {
+        auto start_in_page = _promoted_index_start % cached_file::page_size;
+        auto pages = div_ceil(start_in_page + _promoted_index_size, cached_file::page_size);
+        if (pages < 2) {
+            // A single page will be read by the lookup itself.
+            return make_ready_future<>();
+        }
+        ++_metrics.prefetches;
+        _stream = _cached_file.read(_promoted_index_start, _permit, std::move(trace_state), start_in_page + _promoted_index_size);
+        return do_with(pages, [this] (uint64_t& pages_left) {
+            return repeat([this, &pages_left] {
+                return _stream.next_page_view().then([&pages_left] (cached_file::page_view&& page) {
+                    return stop_iteration(!page || --pages_left == 0);
+                });
+            });
+        });
+    }
+
     template <typename Consumer>
     future<> read(cached_file::offset_type pos, tracing::trace_state_ptr trace_state, Consumer& c) {
         struct retry_exception : std::exception {};
+        if (!_prefetch_attempted) {
+            _prefetch_attempted = true;
+            if (_promoted_index_size <= max_prefetch_size) {
+                return prefetch(trace_state).then([this, pos, trace_state, &c] {
+                    return read(pos, trace_state, c);
+                });
+            }
+        }
         _stream = _cached_file.read(pos, _permit, trace_state);
         c.reset();
         return repeat([this, pos, trace_state, &c] {
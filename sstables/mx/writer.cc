@@ -542,6 +542,7 @@ class writer : public sstable_writer::writer_impl {
     uint64_t _partition_header_length = 0;
     uint64_t _prev_row_start = 0;
     std::optional<key> _partition_key;
+    dht::token _partition_token;
     std::optional<key> _first_key, _last_key;
     index_sampling_state _index_sampling_state;
     bytes_ostream _tmp_bufs;
@@ -601,6 +602,10 @@ class writer : public sstable_writer::writer_impl {
     large_data_stats_entry _row_size_entry;
     large_data_stats_entry _cell_size_entry;
     large_data_stats_entry _elements_in_collection_entry;
+    std::optional<tombstone_token_histogram_collector> _tombstone_token_histogram;
+    // Row filter state of the current partition.
+    utils::hashed_key _row_filter_partition_hash{{0, 0}};
+    bool _row_filter_partition_added = false;
 
     void init_file_writers();
 
@@ -622,6 +627,15 @@ class writer : public sstable_writer::writer_impl {
 
     void drain_tombstones(std::optional<position_in_partition_view> pos = {});
 
+    // Adds the current partition as a whole to the row filter, if any, so
+    // that its tombstones are not missed by single-row reads.
+    void maybe_add_partition_to_row_filter() {
+        if (_sst._components->row_filter && !_row_filter_partition_added) {
+            _sst._components->row_filter->add(_row_filter_partition_hash);
+            _row_filter_partition_added = true;
+        }
+    }
+
     void maybe_add_summary_entry(const dht::token& token, bytes_view key) {
         return sstables::maybe_add_summary_entry(
             _sst._components->summary, token, key, get_data_offset(),
@@ -798,6 +812,10 @@ class writer : public sstable_writer::writer_impl {
         // exactly what callers used to do anyway.
         estimated_partitions = std::max(uint64_t(1), estimated_partitions);
 
+        const bool with_row_filter = _cfg.row_filter_fp_chance < 1.0 && row_filter::is_supported(s) && !_write_regular_as_static;
+        if (with_row_filter) {
+            _sst._recognized_components.insert(component_type::RowFilter);
+        }
         _sst.open_sstable(cfg.origin);
         _sst.create_data().get();
         _compression_enabled = !_sst.has_component(component_type::CRC);
@@ -806,10 +824,14 @@ class writer : public sstable_writer::writer_impl {
 
         _cfg.monitor->on_write_started(_data_writer->offset_tracker());
         _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _sst._schema->bloom_filter_fp_chance(), utils::filter_format::m_format);
+        if (with_row_filter) {
+            _sst._components->row_filter.emplace(estimated_partitions, _cfg.row_filter_fp_chance);
+        }
         _pi_write_m.promoted_index_block_size = cfg.promoted_index_block_size;
         _pi_write_m.promoted_index_auto_scale_threshold = cfg.promoted_index_auto_scale_threshold;
         _index_sampling_state.summary_byte_cost = _cfg.summary_byte_cost;
         prepare_summary(_sst._components->summary, estimated_partitions, _schema.min_index_interval());
+        _tombstone_token_histogram.emplace(estimated_partitions);
     }
 
     ~writer();
@@ -889,11 +911,15 @@ void writer::init_file_writers() {
     if (!_compression_enabled) {
         _data_writer = std::make_unique<crc32_checksummed_file_writer>(std::move(out), _sst.sstable_buffer_size, _sst.filename(component_type::Data));
     } else {
+        auto params = _sst._schema->get_compressor_params();
+        if (_cfg.compression_chunk_length) {
+            params = params.with_chunk_length(*_cfg.compression_chunk_length);
+        }
         _data_writer = std::make_unique<file_writer>(
             make_compressed_file_m_format_output_stream(
                 output_stream<char>(std::move(out)),
                 &_sst._components->compression,
-                _sst._schema->get_compressor_params()), _sst.filename(component_type::Data));
+                params), _sst.filename(component_type::Data));
     }
 
     out = _sst._storage->make_data_or_index_sink(_sst, component_type::Index).get();
@@ -922,9 +948,14 @@ void writer::consume_new_partition(const dht::decorated_key& dk) {
     _prev_row_start = _data_writer->offset();
 
     _partition_key = key::from_partition_key(_schema, dk.key());
+    _partition_token = dk.token();
     maybe_add_summary_entry(dk.token(), bytes_view(*_partition_key));
 
     _sst._components->filter->add(bytes_view(*_partition_key));
+    if (_sst._components->row_filter) {
+        _row_filter_partition_hash = utils::make_hashed_key(bytes_view(*_partition_key));
+        _row_filter_partition_added = false;
+    }
     _collector.add_key(bytes_view(*_partition_key));
     _num_partitions_consumed++;
 
@@ -968,6 +999,7 @@ void writer::consume(tombstone t) {
     if (t) {
         _collector.update_min_max_components(position_in_partition_view::before_all_clustered_rows());
         _collector.update_min_max_components(position_in_partition_view::after_all_clustered_rows());
+        maybe_add_partition_to_row_filter();
     }
 }
 
@@ -1315,6 +1347,9 @@ stop_iteration writer::consume(clustering_row&& cr) {
     ensure_tombstone_is_written();
     ensure_static_row_is_written_if_needed();
     write_clustered(cr);
+    if (_sst._components->row_filter) {
+        _sst._components->row_filter->add(row_filter::make_row_hashed_key(_row_filter_partition_hash, cr.key()));
+    }
 
     auto can_split_partition_at_clustering_boundary = [this] {
         // will allow size limit to be exceeded for 10%, so we won't perform unnecessary split
@@ -1407,6 +1442,7 @@ void writer::write_clustered(const rt_marker& marker, uint64_t prev_row_size) {
 
 void writer::consume(rt_marker&& marker) {
     write_clustered(marker);
+    maybe_add_partition_to_row_filter();
 }
 
 stop_iteration writer::consume(range_tombstone_change&& rtc) {
@@ -1461,6 +1497,7 @@ stop_iteration writer::consume_end_of_partition() {
 
     maybe_record_large_partitions(_sst, *_partition_key, _c_stats.partition_size, _c_stats.rows_count, _c_stats.range_tombstones_count, _c_stats.dead_rows_count);
 
+    _tombstone_token_histogram->update(_partition_token, _c_stats);
     // update is about merging column_stats with the data being stored by collector.
     _collector.update(std::move(_c_stats));
     _c_stats.reset();
@@ -1493,6 +1530,7 @@ void writer::consume_end_of_stream() {
     _sst.write_summary();
     _sst.maybe_rebuild_filter_from_index(_num_partitions_consumed);
     _sst.write_filter();
+    _sst.write_row_filter();
     _sst.write_statistics();
     _sst.write_compression();
     run_identifier identifier{_run_identifier};
@@ -1508,7 +1546,8 @@ void writer::consume_end_of_stream() {
     std::optional<scylla_metadata::ext_timestamp_stats> ts_stats(scylla_metadata::ext_timestamp_stats{
         .map = _collector.get_ext_timestamp_stats()
     });
-    _sst.write_scylla_metadata(_shard, _features, std::move(identifier), std::move(ld_stats), std::move(ts_stats));
+    auto tt_histogram = std::move(*_tombstone_token_histogram).get();
+    _sst.write_scylla_metadata(_shard, _features, std::move(identifier), std::move(ld_stats), std::move(ts_stats), std::move(tt_histogram));
     _sst.seal_sstable(_cfg.backup).get();
 }
 
@@ -0,0 +1,523 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/with_scheduling_group.hh>
+#include <seastar/util/backtrace.hh>
+
+#include "sstables/object_storage_cache.hh"
+#include "utils/lister.hh"
+#include "utils/log.hh"
+
+namespace sstables {
+
+static logging::logger oscachelog("object_storage_cache");
+
+static constexpr auto tmp_suffix = ".tmp";
+static constexpr size_t max_name_length = 255;
+
+// Object names are paths within the bucket, turn them into file names.
+static sstring encode_object_name(std::string_view object_name) {
+    std::string name;
+    for (auto c : object_name) {
+        switch (c) {
+        case '%': name += "%25"; break;
+        case '/': name += "%2F"; break;
+        default: name += c;
+        }
+    }
+    return sstring(name);
+}
+
+struct object_storage_cache::local_copy {
+    file f;
+    // Reads in progress, waited for before the file is closed.
+    gate reads;
+    // Number of open files of the object reading this copy.
+    unsigned users = 0;
+
+    explicit local_copy(file f) : f(std::move(f)) {}
+};
+
+// Reads from the local copy if there is one, and from the remote file otherwise.
+class object_storage_cache::caching_file_impl : public file_impl {
+    object_storage_cache& _cache;
+    sstring _name;
+    noncopyable_function<file()> _make_remote;
+    // Opened on first use when the object had a copy.
+    std::optional<file> _remote;
+    lw_shared_ptr<local_copy> _local;
+    // When reads last marked the copy as used.
+    lowres_clock::time_point _last_touch;
+    bool _admission_requested = false;
+    bool _registered = true;
+
+    friend class object_storage_cache;
+private:
+    [[noreturn]] void unsupported() {
+        throw_with_backtrace<std::logic_error>("unsupported operation on cached object storage file");
+    }
+
+    file& remote() {
+        if (!_remote) {
+            _remote = _make_remote();
+        }
+        return *_remote;
+    }
+
+    void unregister() noexcept {
+        if (!std::exchange(_registered, false)) {
+            return;
+        }
+        auto [it, end] = _cache._open_files.equal_range(_name);
+        while (it->second != this) {
+            ++it;
+        }
+        _cache._open_files.erase(it);
+    }
+
+    template <typename Func>
+    futurize_t<std::invoke_result_t<Func, file&>> with_target(Func func) {
+        if (auto local = _local) {
+            return with_gate(local->reads, [local, func = std::move(func)] () mutable {
+                return func(local->f);
+            });
+        }
+        return func(remote());
+    }
+
+    template <typename Func>
+    futurize_t<std::invoke_result_t<Func, file&>> read(Func func) {
+        if (_local) {
+            // Files stay open for the lifetime of their sstable, so the
+            // copies are ordered by use rather than by open. Once a second
+            // is enough for that.
+            auto now = lowres_clock::now();
+            if (now - _last_touch >= std::chrono::seconds(1)) {
+                _last_touch = now;
+                _cache.touch(_name);
+            }
+        } else if (!_admission_requested) {
+            _admission_requested = _cache.request_admission(_name, _make_remote);
+        }
+        return with_target(std::move(func));
+    }
+public:
+    caching_file_impl(object_storage_cache& cache, sstring name, noncopyable_function<file()> make_remote, std::optional<file> remote, lw_shared_ptr<local_copy> local)
+        : file_impl(*get_file_impl(remote ? *remote : local->f))
+        , _cache(cache)
+        , _name(std::move(name))
+        , _make_remote(std::move(make_remote))
+        , _remote(std::move(remote))
+    {
+        if (local) {
+            attach(std::move(local));
+        }
+        _cache._open_files.emplace(_name, this);
+    }
+
+    ~caching_file_impl() {
+        unregister();
+    }
+
+    void attach(lw_shared_ptr<local_copy> local) noexcept {
+        ++local->users;
+        _local = std::move(local);
+    }
+
+    // unsupported
+    virtual future<size_t> write_dma(uint64_t pos, const void* buffer, size_t len, io_intent*) override { unsupported(); }
+    virtual future<size_t> write_dma(uint64_t pos, std::vector<iovec> iov, io_intent*) override { unsupported(); }
+    virtual future<> truncate(uint64_t length) override { unsupported(); }
+    virtual subscription<directory_entry> list_directory(std::function<future<>(directory_entry)>) override { unsupported(); }
+
+    virtual future<> flush(void) override { return make_ready_future<>(); }
+    virtual future<> allocate(uint64_t position, uint64_t length) override { return make_ready_future<>(); }
+    virtual future<> discard(uint64_t offset, uint64_t length) override { return make_ready_future<>(); }
+
+    // delegating
+    virtual future<struct stat> stat(void) override {
+        return with_target([] (file& f) { return f.stat(); });
+    }
+    virtual future<uint64_t> size(void) override {
+        return with_target([] (file& f) { return f.size(); });
+    }
+    // Other shards read the remote object.
+    virtual std::unique_ptr<seastar::file_handle_impl> dup() override { return get_file_impl(remote())->dup(); }
+
+    virtual future<> close() override {
+        unregister();
+        if (auto local = std::exchange(_local, nullptr); local && --local->users == 0) {
+            co_await _cache.close_copy(_name, std::move(local));
+        }
+        if (_remote) {
+            co_await _remote->close();
+        }
+    }
+
+    virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t size, io_intent* intent) override {
+        return read([offset, size, intent] (file& f) {
+            return f.dma_read_bulk<uint8_t>(offset, size, intent);
+        });
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, io_intent* intent) override {
+        return read([pos, buffer, len, intent] (file& f) {
+            return f.dma_read(pos, reinterpret_cast<char*>(buffer), len, intent);
+        });
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, io_intent* intent) override {
+        return read([pos, iov = std::move(iov), intent] (file& f) mutable {
+            return f.dma_read(pos, std::move(iov), intent);
+        });
+    }
+};
+
+object_storage_cache::object_storage_cache(config cfg)
+    : _cfg(std::move(cfg))
+    , _loaded(load())
+{
+    namespace sm = seastar::metrics;
+    _metrics.add_group("object_storage_cache", {
+        sm::make_counter("hits", _stats.hits,
+            sm::description("Number of opened object storage sstable components which had a local copy")),
+        sm::make_counter("misses", _stats.misses,
+            sm::description("Number of opened object storage sstable components which had no local copy")),
+        sm::make_counter("admissions", _stats.admissions,
+            sm::description("Number of object storage sstable components copied to the local directory")),
+        sm::make_counter("evictions", _stats.evictions,
+            sm::description("Number of local copies removed to stay within the capacity")),
+        sm::make_counter("oversized", _stats.oversized,
+            sm::description("Number of object storage sstable components not copied because they are larger than the capacity")),
+        sm::make_gauge("bytes", _stats.bytes,
+            sm::description("Size of the local copies")),
+    });
+}
+
+std::filesystem::path object_storage_cache::path_of(const sstring& name) const {
+    return _cfg.dir / std::string_view(name);
+}
+
+future<> object_storage_cache::load() {
+    try {
+        co_await recursive_touch_directory(_cfg.dir.native());
+        co_await lister::scan_dir(_cfg.dir, lister::dir_entry_types::of<directory_entry_type::regular>(), [this] (fs::path dir, directory_entry de) -> future<> {
+            auto path = dir / de.name.c_str();
+            if (de.name.ends_with(tmp_suffix)) {
+                // Left behind by a copy which didn't complete.
+                co_await remove_file(path.native());
+                co_return;
+            }
+            auto size = co_await file_size(path.native());
+            // Insertion puts the entry in the front, so the order of the
+            // loaded entries is arbitrary. It will settle as they are used.
+            insert(de.name, size, false);
+        });
+    } catch (...) {
+        oscachelog.error("Failed to load local copies of object storage sstable components from {}, reading from the object storage only: {}",
+                _cfg.dir.native(), std::current_exception());
+        _failed = true;
+        co_return;
+    }
+    oscachelog.info("Loaded {} local copies of object storage sstable components from {}, {} bytes",
+            _entries.size(), _cfg.dir.native(), _stats.bytes);
+    // The capacity may have been reduced since the copies were made.
+    co_await evict_to_fit();
+}
+
+void object_storage_cache::insert(sstring name, uint64_t size, bool confirmed) {
+    _lru.push_front(entry{name, size, confirmed});
+    _entries[std::move(name)] = _lru.begin();
+    _stats.bytes += size;
+}
+
+void object_storage_cache::touch(const sstring& name) {
+    if (auto it = _entries.find(name); it != _entries.end()) {
+        _lru.splice(_lru.begin(), _lru, it->second);
+    }
+}
+
+void object_storage_cache::erase(lru_type::iterator it) {
+    _stats.bytes -= it->size;
+    _entries.erase(it->name);
+    _lru.erase(it);
+}
+
+future<> object_storage_cache::evict_to_fit() {
+    std::vector<sstring> victims;
+    while (_stats.bytes > _cfg.capacity && !_lru.empty()) {
+        victims.push_back(_lru.back().name);
+        ++_stats.evictions;
+        erase(std::prev(_lru.end()));
+    }
+    co_await remove_copies(std::move(victims));
+}
+
+// Returns the open file of the copy of the object, or nullptr if there's no copy.
+future<lw_shared_ptr<object_storage_cache::local_copy>> object_storage_cache::open_copy(const sstring& name) {
+    if (auto it = _copies.find(name); it != _copies.end()) {
+        co_return it->second;
+    }
+    if (!_entries.contains(name)) {
+        co_return nullptr;
+    }
+    auto f = co_await open_file_dma(path_of(name).native(), open_flags::ro);
+    // The copy may have been opened by someone else, or removed, meanwhile.
+    if (auto it = _copies.find(name); it != _copies.end()) {
+        co_await f.close();
+        co_return it->second;
+    }
+    if (!_entries.contains(name)) {
+        co_await f.close();
+        co_return nullptr;
+    }
+    auto copy = make_lw_shared<local_copy>(std::move(f));
+    _copies.emplace(name, copy);
+    co_return copy;
+}
+
+future<> object_storage_cache::close_copy(const sstring& name, lw_shared_ptr<local_copy> copy) {
+    if (auto it = _copies.find(name); it != _copies.end() && it->second == copy) {
+        _copies.erase(it);
+    }
+    co_await copy->reads.close();
+    co_await copy->f.close();
+}
+
+// Switches the open files of the object to its copy.
+future<> object_storage_cache::attach(const sstring& name) {
+    auto copy = co_await open_copy(name);
+    if (!copy) {
+        co_return;
+    }
+    for (auto [it, end] = _open_files.equal_range(name); it != end; ++it) {
+        if (!it->second->_local) {
+            it->second->attach(copy);
+        }
+    }
+    if (!copy->users) {
+        co_await close_copy(name, std::move(copy));
+    }
+}
+
+// Switches the open files of the object back to the remote store, and closes the copy.
+future<> object_storage_cache::detach(const sstring& name) {
+    auto found = _copies.find(name);
+    if (found == _copies.end()) {
+        co_return;
+    }
+    auto copy = found->second;
+    for (auto [it, end] = _open_files.equal_range(name); it != end; ++it) {
+        if (it->second->_local == copy) {
+            it->second->_local = nullptr;
+        }
+    }
+    co_await close_copy(name, std::move(copy));
+}
+
+future<> object_storage_cache::remove_copies(std::vector<sstring> names) {
+    _removing.insert(names.begin(), names.end());
+    for (auto& name : names) {
+        auto path = path_of(name);
+        try {
+            co_await detach(name);
+            co_await remove_file(path.native());
+        } catch (...) {
+            oscachelog.warn("Failed to remove {}: {}", path.native(), std::current_exception());
+        }
+        _removing.erase(name);
+    }
+}
+
+future<std::optional<uint64_t>> object_storage_cache::download(const sstring& name, file& remote) {
+    auto units = co_await get_units(_admission_sem, 1, _as);
+    auto size = co_await remote.size();
+    if (size > _cfg.capacity) {
+        ++_stats.oversized;
+        oscachelog.debug("Not making a local copy of {}, its size {} exceeds the capacity {}", name, size, _cfg.capacity);
+        co_return std::nullopt;
+    }
+
+    auto path = path_of(name);
+    auto tmp_path = path;
+    tmp_path += tmp_suffix;
+    auto f = co_await open_file_dma(tmp_path.native(), open_flags::wo | open_flags::create | open_flags::truncate);
+    auto out = co_await make_file_output_stream(f);
+    std::exception_ptr ex;
+    try {
+        uint64_t pos = 0;
+        while (pos < size) {
+            _as.check();
+            auto buf = co_await remote.dma_read_bulk<char>(pos, std::min<uint64_t>(size - pos, transfer_size));
+            if (buf.empty()) {
+                throw std::runtime_error(format("unexpected end of object at position {}, expected size {}", pos, size));
+            }
+            pos += buf.size();
+            co_await out.write(buf.get(), buf.size());
+        }
+        co_await out.flush();
+        // Make sure a crash can't leave an incomplete copy under the final name.
+        co_await f.flush();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await out.close();
+    if (ex) {
+        co_await remove_file(tmp_path.native()).handle_exception([] (std::exception_ptr) {});
+        std::rethrow_exception(ex);
+    }
+    co_await rename_file(tmp_path.native(), path.native());
+    co_await sync_directory(_cfg.dir.native());
+    co_return size;
+}
+
+future<> object_storage_cache::admit(sstring name, file remote) {
+    std::optional<uint64_t> size;
+    std::exception_ptr ex;
+    try {
+        size = co_await download(name, remote);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await remote.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    if (!size) {
+        co_return;
+    }
+    if (_invalidated.contains(name)) {
+        // The object was deleted while it was being copied.
+        co_await remove_file(path_of(name).native());
+        co_return;
+    }
+
+    insert(name, *size, true);
+    ++_stats.admissions;
+    co_await evict_to_fit();
+    co_await attach(name);
+}
+
+// Called on reads which go to the remote store. Returns false if the
+// object should be admitted on a later read.
+bool object_storage_cache::request_admission(const sstring& name, noncopyable_function<file()>& make_remote) {
+    if (std::ranges::find(_cfg.no_admission_groups, current_scheduling_group()) != _cfg.no_admission_groups.end() || _removing.contains(name)) {
+        return false;
+    }
+    if (_gate.is_closed() || _entries.contains(name) || _admitting.contains(name) || name.size() + strlen(tmp_suffix) > max_name_length) {
+        return true;
+    }
+    try {
+        auto holder = _gate.hold();
+        auto remote = make_remote();
+        _admitting.insert(name);
+        (void)with_scheduling_group(_cfg.download_group, [this, name, remote = std::move(remote)] () mutable {
+            return admit(name, std::move(remote));
+        }).handle_exception([this, name] (std::exception_ptr ep) {
+            if (_as.abort_requested()) {
+                oscachelog.debug("Stopped making a local copy of {}: {}", name, ep);
+            } else {
+                oscachelog.warn("Failed to make a local copy of {}: {}", name, ep);
+            }
+        }).finally([this, name, holder = std::move(holder)] {
+            _admitting.erase(name);
+            _invalidated.erase(name);
+        });
+    } catch (...) {
+        oscachelog.warn("Failed to make a local copy of {}: {}", name, std::current_exception());
+    }
+    return true;
+}
+
+future<file> object_storage_cache::open(sstring object_name, noncopyable_function<file()> make_remote) {
+    auto holder = _gate.hold();
+    co_await _loaded.get_future();
+    if (_failed) {
+        co_return make_remote();
+    }
+
+    auto name = encode_object_name(object_name);
+    if (auto it = _entries.find(name); it != _entries.end()) {
+        _lru.splice(_lru.begin(), _lru, it->second);
+        it->second->confirmed = true;
+        lw_shared_ptr<local_copy> copy;
+        std::exception_ptr ex;
+        try {
+            copy = co_await open_copy(name);
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        if (copy) {
+            ++_stats.hits;
+            co_return file(make_shared<caching_file_impl>(*this, std::move(name), std::move(make_remote), std::nullopt, std::move(copy)));
+        }
+        if (ex) {
+            oscachelog.debug("Failed to open local copy of {}: {}", object_name, ex);
+            if (auto stale = _entries.find(name); stale != _entries.end()) {
+                erase(stale->second);
+            }
+        }
+        // Otherwise the copy was removed meanwhile.
+    }
+
+    ++_stats.misses;
+    auto remote = make_remote();
+    co_return file(make_shared<caching_file_impl>(*this, std::move(name), std::move(make_remote), std::move(remote), nullptr));
+}
+
+future<> object_storage_cache::invalidate(sstring object_name) {
+    auto holder = _gate.hold();
+    co_await _loaded.get_future();
+
+    auto name = encode_object_name(object_name);
+    if (_admitting.contains(name)) {
+        _invalidated.insert(name);
+    }
+    auto it = _entries.find(name);
+    if (it == _entries.end()) {
+        co_return;
+    }
+    erase(it->second);
+    co_await remove_copies({name});
+}
+
+future<> object_storage_cache::reconcile() {
+    auto holder = _gate.hold();
+    co_await _loaded.get_future();
+
+    std::vector<sstring> stale;
+    for (auto& e : _lru) {
+        if (!e.confirmed) {
+            stale.push_back(e.name);
+        }
+    }
+    for (auto& name : stale) {
+        erase(_entries.at(name));
+    }
+    if (!stale.empty()) {
+        oscachelog.info("Removing {} local copies of object storage sstable components which no sstable opened", stale.size());
+    }
+    co_await remove_copies(std::move(stale));
+}
+
+future<> object_storage_cache::stop() {
+    // Don't wait for the queued copies to be made.
+    _as.request_abort();
+    co_await _gate.close();
+    co_await _loaded.get_future();
+}
+
+} // namespace sstables
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/file.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include "seastarx.hh"
+
+namespace sstables {
+
+// Keeps copies of sstable components stored on object storage in a local
+// directory, so that reads of them are served by a local device instead of
+// the remote store.
+//
+// Components are immutable once written, so a copy stays valid for as long
+// as the object exists. A copy is made in the background the first time an
+// opened component is read from the remote store, unless the read runs in
+// one of the configured scheduling groups, so that components which are only
+// read by compaction or right after being written aren't copied. Files opened
+// before the copy is complete read from the remote store until it is, and
+// switch to the copy afterwards. Once the copies take more space than the
+// configured capacity, the least recently used ones are removed, and the
+// files reading them go back to the remote store. Copies are made in the
+// configured download group, not in the group of the read which missed.
+//
+// Copies are kept across restarts. Those of objects which no sstable opened
+// by the time reconcile() is called are removed, they belong to sstables
+// which were deleted while the node was down.
+//
+// There is one instance per shard, each with its own sub-directory and an
+// equal share of the capacity.
+class object_storage_cache {
+public:
+    struct config {
+        std::filesystem::path dir;
+        uint64_t capacity;
+        // Reads running in these groups don't make copies.
+        std::vector<scheduling_group> no_admission_groups;
+        // Copies are made in this group.
+        scheduling_group download_group = default_scheduling_group();
+    };
+
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t admissions = 0;
+        uint64_t evictions = 0;
+        // Objects not copied because they are larger than the capacity.
+        uint64_t oversized = 0;
+        uint64_t bytes = 0;
+    };
+private:
+    class caching_file_impl;
+    struct local_copy;
+
+    struct entry {
+        sstring name;
+        uint64_t size;
+        // Cleared for copies found at startup until an sstable opens them.
+        bool confirmed;
+    };
+    using lru_type = std::list<entry>;
+
+    config _cfg;
+    // Most recently used first.
+    lru_type _lru;
+    std::unordered_map<sstring, lru_type::iterator> _entries;
+    // Open files of the copies, shared by the open files of the objects.
+    std::unordered_map<sstring, lw_shared_ptr<local_copy>> _copies;
+    std::unordered_multimap<sstring, caching_file_impl*> _open_files;
+    std::unordered_set<sstring> _admitting;
+    // Objects deleted while being copied.
+    std::unordered_set<sstring> _invalidated;
+    // Copies being removed, they can't be made again until they are.
+    std::unordered_set<sstring> _removing;
+    semaphore _admission_sem{1};
+    abort_source _as;
+    gate _gate;
+    // Set when the directory couldn't be loaded, all reads go to the remote store then.
+    bool _failed = false;
+    stats _stats;
+    seastar::metrics::metric_groups _metrics;
+    shared_future<> _loaded;
+
+    std::filesystem::path path_of(const sstring& name) const;
+    future<> load();
+    void insert(sstring name, uint64_t size, bool confirmed);
+    void erase(lru_type::iterator it);
+    void touch(const sstring& name);
+    future<> evict_to_fit();
+    future<lw_shared_ptr<local_copy>> open_copy(const sstring& name);
+    future<> close_copy(const sstring& name, lw_shared_ptr<local_copy> copy);
+    future<> attach(const sstring& name);
+    future<> detach(const sstring& name);
+    future<> remove_copies(std::vector<sstring> names);
+    future<std::optional<uint64_t>> download(const sstring& name, file& remote);
+    future<> admit(sstring name, file remote);
+    bool request_admission(const sstring& name, noncopyable_function<file()>& make_remote);
+public:
+    static constexpr size_t transfer_size = 1 << 20;
+
+    explicit object_storage_cache(config cfg);
+
+    future<> stop();
+
+    // Opens the object with the given name for reading. Reads are served
+    // from the local copy if there is one. Otherwise they go to the file
+    // returned by make_remote() until a copy is made. The name must identify
+    // the object across all the object storage endpoints.
+    future<file> open(sstring object_name, noncopyable_function<file()> make_remote);
+    // Removes the local copy of an object which was deleted.
+    future<> invalidate(sstring object_name);
+    // Removes the copies found at startup which weren't opened since. Called
+    // once all the sstables are loaded.
+    future<> reconcile();
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+};
+
+} // namespace sstables
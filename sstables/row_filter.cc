@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "row_filter.hh"
+#include "schema/schema.hh"
+#include "sstables/key.hh"
+#include "utils/bloom_calculations.hh"
+#include "utils/murmur_hash.hh"
+
+namespace sstables {
+
+row_filter::row_filter(uint64_t initial_capacity, double fp_chance)
+    : _fp_chance(fp_chance)
+    , _stage_capacity(std::max<uint64_t>(initial_capacity, 1))
+{
+    add_stage();
+}
+
+row_filter::row_filter(std::vector<utils::filter_ptr> stages) noexcept
+    : _stages(std::move(stages))
+{
+}
+
+void row_filter::add_stage() {
+    if (!_stages.empty()) {
+        _stage_capacity *= capacity_growth_factor;
+    }
+    // Stage i gets fp_chance * (1 - r) * r^i, so that the chances of all
+    // stages sum up to at most fp_chance.
+    auto stage_fp_chance = _fp_chance * (1 - fp_chance_tightening_ratio) * std::pow(fp_chance_tightening_ratio, _stages.size());
+    stage_fp_chance = std::max(stage_fp_chance, utils::bloom_calculations::min_supported_bloom_filter_fp_chance());
+    _stages.push_back(utils::i_filter::get_filter(_stage_capacity, stage_fp_chance, utils::filter_format::m_format));
+    _stage_size = 0;
+}
+
+void row_filter::add(utils::hashed_key key) {
+    if (_stage_size == _stage_capacity) {
+        add_stage();
+    }
+    _stages.back()->add(key);
+    ++_stage_size;
+}
+
+bool row_filter::is_present(utils::hashed_key key) const {
+    return std::ranges::any_of(_stages, [key] (const utils::filter_ptr& stage) {
+        return stage->is_present(key);
+    });
+}
+
+size_t row_filter::memory_size() const {
+    size_t size = 0;
+    for (const auto& stage : _stages) {
+        size += stage->memory_size();
+    }
+    return size;
+}
+
+bool row_filter::is_supported(const schema& s) {
+    // Types such as decimal or varint have several serialized forms of equal
+    // values, so a lookup could miss a row written with another form.
+    return s.clustering_key_size() && std::ranges::all_of(s.clustering_key_columns(), [] (const column_definition& cdef) {
+        return cdef.type->is_byte_order_equal();
+    });
+}
+
+utils::hashed_key row_filter::make_partition_hashed_key(const schema& s, const partition_key& pk) {
+    return utils::make_hashed_key(static_cast<bytes_view>(key::from_partition_key(s, pk)));
+}
+
+utils::hashed_key row_filter::make_row_hashed_key(utils::hashed_key partition_hash, const clustering_key_prefix& ck) {
+    // Seeding the clustering key hash with the partition hash avoids
+    // having to materialize the concatenation of the two keys.
+    return ck.representation().with_linearized([&] (bytes_view ck_bytes) {
+        std::array<uint64_t, 2> h;
+        utils::murmur_hash::hash3_x64_128(ck_bytes, partition_hash.hash()[0], h);
+        return utils::hashed_key(h);
+    });
+}
+
+} // namespace sstables
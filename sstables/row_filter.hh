@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "keys.hh"
+#include "utils/i_filter.hh"
+
+namespace sstables {
+
+// Filter over the full (partition key, clustering key) pairs of the rows
+// written into an sstable. Single-row reads use it to skip sstables which
+// can't contain the requested row, before touching their index.
+//
+// Partitions which have a partition tombstone or range tombstones are
+// added as a whole, see make_partition_hashed_key(), since their
+// tombstones may cover any row.
+//
+// Rows are looked up by the serialized form of their clustering key, so
+// the filter is only written and consulted for schemas whose clustering
+// key types serialize equal values to equal bytes, see is_supported().
+//
+// The number of rows is not known before the sstable is written, so this
+// is a scalable bloom filter: a sequence of bloom filters (stages), each
+// with four times the capacity of the previous one and a tighter false
+// positive chance. Keys are added to the last stage, a new stage is started
+// once it is full. The false positive chances of the stages form a
+// geometric series, which sums to the target chance of the whole filter.
+class row_filter {
+    std::vector<utils::filter_ptr> _stages;
+    // Only used while writing.
+    double _fp_chance = 1.0;
+    uint64_t _stage_capacity = 0;
+    uint64_t _stage_size = 0;
+
+    void add_stage();
+public:
+    static constexpr unsigned capacity_growth_factor = 4;
+    static constexpr double fp_chance_tightening_ratio = 0.8;
+
+    // Creates an empty filter for writing.
+    // Must be called in a seastar thread.
+    row_filter(uint64_t initial_capacity, double fp_chance);
+    // Creates a filter from stages loaded from disk.
+    explicit row_filter(std::vector<utils::filter_ptr> stages) noexcept;
+
+    // Must be called in a seastar thread.
+    void add(utils::hashed_key key);
+    bool is_present(utils::hashed_key key) const;
+
+    const std::vector<utils::filter_ptr>& stages() const noexcept {
+        return _stages;
+    }
+    size_t memory_size() const;
+
+    // Whether rows of the schema can be looked up in a row filter.
+    static bool is_supported(const schema& s);
+
+    static utils::hashed_key make_partition_hashed_key(const schema& s, const partition_key& pk);
+    // Only meaningful for schemas for which is_supported() holds.
+    static utils::hashed_key make_row_hashed_key(utils::hashed_key partition_hash, const clustering_key_prefix& ck);
+};
+
+} // namespace sstables
@@ -13,6 +13,7 @@
 
 #include "compress.hh"
 #include "sstables/types.hh"
+#include "sstables/row_filter.hh"
 #include "utils/i_filter.hh"
 
 namespace sstables {
@@ -21,6 +22,8 @@ namespace sstables {
 struct shareable_components {
     sstables::compression compression;
     utils::filter_ptr filter;
+    // Only engaged for sstables written with a row filter.
+    std::optional<sstables::row_filter> row_filter;
     sstables::summary summary;
     sstables::statistics statistics;
     std::optional<sstables::scylla_metadata> scylla_metadata;
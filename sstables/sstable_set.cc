@@ -7,11 +7,11 @@
  */
 
 #include <algorithm>
+#include <numeric>
 
 #include "utils/assert.hh"
 #include <seastar/util/defer.hh>
 
-#include <boost/icl/interval_map.hpp>
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm/remove_if.hpp>
 #include <boost/range/algorithm/copy.hpp>
@@ -224,81 +224,128 @@ sstable_set::make_incremental_selector() const {
     return incremental_selector(std::get<0>(std::move(selector)), std::get<1>(selector));
 }
 
-partitioned_sstable_set::interval_type partitioned_sstable_set::make_interval(const schema& s, const dht::partition_range& range) {
-    return interval_type::closed(
-            dht::compatible_ring_position_or_view(s, dht::ring_position_view(range.start()->value())),
-            dht::compatible_ring_position_or_view(s, dht::ring_position_view(range.end()->value())));
-}
-
-partitioned_sstable_set::interval_type partitioned_sstable_set::make_interval(const dht::partition_range& range) const {
-    return make_interval(*_schema, range);
-}
+sstable_interval_index::sstable_interval_index(std::vector<shared_sstable> sstables)
+        : _sstables(std::move(sstables)) {
+    constexpr auto max_token = std::numeric_limits<int64_t>::max();
+    struct bounds {
+        int64_t first;
+        int64_t last;
+    };
+    auto sst_bounds = _sstables | std::views::transform([] (const shared_sstable& sst) {
+        return bounds{sst->get_first_decorated_key().token().raw(), sst->get_last_decorated_key().token().raw()};
+    }) | std::ranges::to<std::vector>();
+
+    _starts.reserve(sst_bounds.size() * 2);
+    for (auto& b : sst_bounds) {
+        _starts.push_back(b.first);
+        if (b.last != max_token) {
+            _starts.push_back(b.last + 1);
+        }
+    }
+    std::ranges::sort(_starts);
+    _starts.erase(std::ranges::unique(_starts).begin(), _starts.end());
 
-partitioned_sstable_set::interval_type partitioned_sstable_set::make_interval(const schema_ptr& s, const sstable& sst) {
-    return interval_type::closed(
-            dht::compatible_ring_position_or_view(s, dht::ring_position(sst.get_first_decorated_key())),
-            dht::compatible_ring_position_or_view(s, dht::ring_position(sst.get_last_decorated_key())));
+    // Segments covered by each sstable, as [begin, end) segment indexes.
+    auto segment_of = [this] (int64_t start) {
+        return size_t(std::ranges::lower_bound(_starts, start) - _starts.begin());
+    };
+    auto covered = sst_bounds | std::views::transform([&] (const bounds& b) {
+        return std::make_pair(segment_of(b.first), b.last != max_token ? segment_of(b.last + 1) : _starts.size());
+    }) | std::ranges::to<std::vector>();
+
+    // Count the members of each segment, turn the counts into offsets, then
+    // fill the segments in.
+    _offsets.assign(_starts.size() + 1, 0);
+    for (auto [begin, end] : covered) {
+        for (auto i = begin; i < end; ++i) {
+            ++_offsets[i + 1];
+        }
+    }
+    std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+    _members.resize(_offsets.back());
+    auto fill = _offsets;
+    for (uint32_t member = 0; member < covered.size(); ++member) {
+        for (auto i = covered[member].first; i < covered[member].second; ++i) {
+            _members[fill[i]++] = member;
+        }
+    }
 }
 
-partitioned_sstable_set::interval_type partitioned_sstable_set::make_interval(const sstable& sst) {
-    return make_interval(_schema, sst);
+size_t sstable_interval_index::find(int64_t token) const noexcept {
+    if (_starts.empty()) {
+        return npos;
+    }
+    // Branch-free binary search for the last start <= token: the loop has a
+    // fixed trip count for a given size and the comparison compiles to a
+    // conditional move, so random lookups don't pay for mispredictions.
+    const int64_t* base = _starts.data();
+    size_t n = _starts.size();
+    while (n > 1) {
+        auto half = n / 2;
+        base = (base[half] <= token) ? base + half : base;
+        n -= half;
+    }
+    if (*base > token) {
+        return npos;
+    }
+    return base - _starts.data();
 }
 
-partitioned_sstable_set::interval_type partitioned_sstable_set::singular(const dht::ring_position& rp) const {
-    // We should use the view here, since this is used for queries.
-    auto rpv = dht::ring_position_view(rp);
-    auto crp = dht::compatible_ring_position_or_view(*_schema, std::move(rpv));
-    return interval_type::closed(crp, crp);
+void sstable_interval_index::select(int64_t first, int64_t last, std::vector<shared_sstable>& result) const {
+    auto end = find(last);
+    if (end == npos) {
+        return;
+    }
+    auto begin = find(first);
+    if (begin == npos) {
+        begin = 0;
+    }
+    if (begin == end) {
+        for (auto member : segment(begin)) {
+            result.push_back(_sstables[member]);
+        }
+        return;
+    }
+    // An sstable usually covers several consecutive segments.
+    std::vector<uint32_t> members(_members.begin() + _offsets[begin], _members.begin() + _offsets[end + 1]);
+    std::ranges::sort(members);
+    members.erase(std::ranges::unique(members).begin(), members.end());
+    for (auto member : members) {
+        result.push_back(_sstables[member]);
+    }
 }
 
-std::pair<partitioned_sstable_set::map_iterator, partitioned_sstable_set::map_iterator>
-partitioned_sstable_set::query(const dht::partition_range& range) const {
-    if (range.start() && range.end()) {
-        return _leveled_sstables.equal_range(make_interval(range));
+void partitioned_sstable_set::maybe_rebuild_leveled_index() noexcept {
+    // Merging the changes costs every selection a scan of them, rebuilding
+    // costs a sort of all the leveled sstables.
+    constexpr size_t min_changes = 16;
+    auto changes = _leveled_added.size() + _leveled_erased.size();
+    if (changes <= std::max(min_changes, _leveled_index->sstables().size() / 8)) {
+        return;
     }
-    else if (range.start() && !range.end()) {
-        auto start = singular(range.start()->value());
-        return { _leveled_sstables.lower_bound(start), _leveled_sstables.end() };
-    } else if (!range.start() && range.end()) {
-        auto end = singular(range.end()->value());
-        return { _leveled_sstables.begin(), _leveled_sstables.upper_bound(end) };
-    } else {
-        return { _leveled_sstables.begin(), _leveled_sstables.end() };
+    try {
+        auto ssts = _leveled_index->sstables() | std::views::filter([this] (const shared_sstable& sst) {
+            return !_leveled_erased.contains(sst);
+        }) | std::ranges::to<std::vector>();
+        ssts.insert(ssts.end(), _leveled_added.begin(), _leveled_added.end());
+        _leveled_index = make_lw_shared<const sstable_interval_index>(std::move(ssts));
+    } catch (...) {
+        // The changes are still merged on selection, the index will be
+        // rebuilt on a later update.
+        sstlog.debug("Failed to rebuild the leveled sstable index: {}", std::current_exception());
+        return;
     }
+    _leveled_added.clear();
+    _leveled_erased.clear();
 }
 
 bool partitioned_sstable_set::store_as_unleveled(const shared_sstable& sst) const {
     return _use_level_metadata && sst->get_sstable_level() == 0;
 }
 
-dht::ring_position partitioned_sstable_set::to_ring_position(const dht::compatible_ring_position_or_view& crp) {
-    // Ring position views, representing bounds of sstable intervals are
-    // guaranteed to have key() != nullptr;
-    const auto& pos = crp.position();
-    return dht::ring_position(pos.token(), *pos.key());
-}
-
-dht::partition_range partitioned_sstable_set::to_partition_range(const interval_type& i) {
-    return dht::partition_range::make(
-            {to_ring_position(i.lower()), boost::icl::is_left_closed(i.bounds())},
-            {to_ring_position(i.upper()), boost::icl::is_right_closed(i.bounds())});
-}
-
-dht::partition_range partitioned_sstable_set::to_partition_range(const dht::ring_position_view& pos, const interval_type& i) {
-    auto lower_bound = [&] {
-        if (pos.key()) {
-            return dht::partition_range::bound(dht::ring_position(pos.token(), *pos.key()),
-                    pos.is_after_key() == dht::ring_position_view::after_key::no);
-        } else {
-            return dht::partition_range::bound(dht::ring_position(pos.token(), pos.get_token_bound()), true);
-        }
-    }();
-    auto upper_bound = dht::partition_range::bound(to_ring_position(i.lower()), !boost::icl::is_left_closed(i.bounds()));
-    return dht::partition_range::make(std::move(lower_bound), std::move(upper_bound));
-}
-
 partitioned_sstable_set::partitioned_sstable_set(schema_ptr schema, bool use_level_metadata)
         : _schema(std::move(schema))
+        , _leveled_index(make_lw_shared<const sstable_interval_index>(std::vector<shared_sstable>()))
         , _all(make_lw_shared<sstable_list>())
         , _use_level_metadata(use_level_metadata) {
 }
@@ -309,31 +356,41 @@ static std::unordered_map<run_id, shared_sstable_run> clone_runs(const std::unor
     }) | std::ranges::to<std::unordered_map<run_id, shared_sstable_run>>();
 }
 
-partitioned_sstable_set::partitioned_sstable_set(schema_ptr schema, const std::vector<shared_sstable>& unleveled_sstables, const interval_map_type& leveled_sstables,
+partitioned_sstable_set::partitioned_sstable_set(schema_ptr schema, const std::vector<shared_sstable>& unleveled_sstables,
+        lw_shared_ptr<const sstable_interval_index> leveled_index,
+        const std::vector<shared_sstable>& leveled_added, const std::unordered_set<shared_sstable>& leveled_erased,
         const lw_shared_ptr<sstable_list>& all, const std::unordered_map<run_id, shared_sstable_run>& all_runs, bool use_level_metadata, uint64_t bytes_on_disk)
         : sstable_set_impl(bytes_on_disk)
         , _schema(schema)
         , _unleveled_sstables(unleveled_sstables)
-        , _leveled_sstables(leveled_sstables)
+        , _leveled_index(std::move(leveled_index))
+        , _leveled_added(leveled_added)
+        , _leveled_erased(leveled_erased)
         , _all(make_lw_shared<sstable_list>(*all))
         , _all_runs(clone_runs(all_runs))
         , _use_level_metadata(use_level_metadata) {
 }
 
 std::unique_ptr<sstable_set_impl> partitioned_sstable_set::clone() const {
-    return std::make_unique<partitioned_sstable_set>(_schema, _unleveled_sstables, _leveled_sstables, _all, _all_runs, _use_level_metadata, _bytes_on_disk);
+    return std::make_unique<partitioned_sstable_set>(_schema, _unleveled_sstables, _leveled_index, _leveled_added, _leveled_erased, _all, _all_runs, _use_level_metadata, _bytes_on_disk);
 }
 
 std::vector<shared_sstable> partitioned_sstable_set::select(const dht::partition_range& range) const {
-    auto ipair = query(range);
-    auto b = std::move(ipair.first);
-    auto e = std::move(ipair.second);
-    value_set result;
-    while (b != e) {
-        boost::copy(b++->second, std::inserter(result, result.end()));
-    }
+    auto first = range.start() ? range.start()->value().token().raw() : std::numeric_limits<int64_t>::min();
+    auto last = range.end() ? range.end()->value().token().raw() : std::numeric_limits<int64_t>::max();
     auto r = _unleveled_sstables;
-    r.insert(r.end(), result.begin(), result.end());
+    auto indexed = r.size();
+    _leveled_index->select(first, last, r);
+    if (!_leveled_erased.empty()) {
+        r.erase(std::remove_if(r.begin() + indexed, r.end(), [this] (const shared_sstable& sst) {
+            return _leveled_erased.contains(sst);
+        }), r.end());
+    }
+    for (auto& sst : _leveled_added) {
+        if (sst->get_first_decorated_key().token().raw() <= last && sst->get_last_decorated_key().token().raw() >= first) {
+            r.push_back(sst);
+        }
+    }
     return r;
 }
 
@@ -393,11 +450,11 @@ bool partitioned_sstable_set::insert(shared_sstable sst) {
     if (store_as_unleveled(sst)) {
         _unleveled_sstables.push_back(sst);
     } else {
-        _leveled_sstables_change_cnt++;
-        _leveled_sstables.add({make_interval(*sst), value_set({sst})});
+        _leveled_added.push_back(sst);
     }
     undo_all_insert.cancel();
     undo_all_runs_insert.cancel();
+    maybe_rebuild_leveled_index();
     return true;
 }
 
@@ -414,9 +471,14 @@ bool partitioned_sstable_set::erase(shared_sstable sst) {
     }
     if (store_as_unleveled(sst)) {
         _unleveled_sstables.erase(std::remove(_unleveled_sstables.begin(), _unleveled_sstables.end(), sst), _unleveled_sstables.end());
-    } else {
-        _leveled_sstables_change_cnt++;
-        _leveled_sstables.subtract({make_interval(*sst), value_set({sst})});
+    } else if (ret) {
+        if (auto it = std::ranges::find(_leveled_added, sst); it != _leveled_added.end()) {
+            std::swap(*it, _leveled_added.back());
+            _leveled_added.pop_back();
+        } else {
+            _leveled_erased.insert(sst);
+        }
+        maybe_rebuild_leveled_index();
     }
     return ret;
 }
@@ -427,64 +489,79 @@ partitioned_sstable_set::size() const noexcept {
 }
 
 class partitioned_sstable_set::incremental_selector : public incremental_selector_impl {
-    schema_ptr _schema;
-    const std::vector<shared_sstable>& _unleveled_sstables;
-    const interval_map_type& _leveled_sstables;
-    const uint64_t& _leveled_sstables_change_cnt;
-    uint64_t _last_known_leveled_sstables_change_cnt;
-    map_iterator _it;
+    const partitioned_sstable_set& _set;
+    // Snapshot of the set's index. Changes to the set are picked up on the
+    // next selection, and the snapshot keeps whatever the previous
+    // selection returned alive until then.
+    lw_shared_ptr<const sstable_interval_index> _index;
 private:
-    dht::ring_position_ext next_position(map_iterator it) {
-        if (it == _leveled_sstables.end()) {
-            return dht::ring_position_view::max();
-        } else {
-            auto&& next_position = partitioned_sstable_set::to_ring_position(it->first.lower());
-            return dht::ring_position_ext(next_position, dht::ring_position_ext::after_key(!boost::icl::is_left_closed(it->first.bounds())));
-        }
-    }
-    static bool is_before_interval(const dht::compatible_ring_position_or_view& crp, const interval_type& interval) {
-        if (boost::icl::is_left_closed(interval.bounds())) {
-            return crp < interval.lower();
+    static dht::partition_range::bound lower_bound(const dht::ring_position_view& pos) {
+        if (pos.key()) {
+            return dht::partition_range::bound(dht::ring_position(pos.token(), *pos.key()),
+                    pos.is_after_key() == dht::ring_position_view::after_key::no);
         } else {
-            return crp <= interval.lower();
-        }
-    }
-    void maybe_invalidate_iterator(const dht::compatible_ring_position_or_view& crp) {
-        if (_last_known_leveled_sstables_change_cnt != _leveled_sstables_change_cnt) {
-            _it = _leveled_sstables.lower_bound(interval_type::closed(crp, crp));
-            _last_known_leveled_sstables_change_cnt = _leveled_sstables_change_cnt;
+            return dht::partition_range::bound(dht::ring_position(pos.token(), pos.get_token_bound()), true);
         }
     }
 public:
-    incremental_selector(schema_ptr schema, const std::vector<shared_sstable>& unleveled_sstables, const interval_map_type& leveled_sstables,
-                         const uint64_t& leveled_sstables_change_cnt)
-        : _schema(std::move(schema))
-        , _unleveled_sstables(unleveled_sstables)
-        , _leveled_sstables(leveled_sstables)
-        , _leveled_sstables_change_cnt(leveled_sstables_change_cnt)
-        , _last_known_leveled_sstables_change_cnt(leveled_sstables_change_cnt)
-        , _it(leveled_sstables.begin()) {
+    explicit incremental_selector(const partitioned_sstable_set& set)
+        : _set(set) {
     }
     virtual std::tuple<dht::partition_range, std::vector<shared_sstable>, dht::ring_position_ext> select(const selector_pos& s) override {
         const dht::ring_position_view& pos = s.pos;
-        auto crp = dht::compatible_ring_position_or_view(*_schema, pos);
-        auto ssts = _unleveled_sstables;
+        auto ssts = _set._unleveled_sstables;
         using namespace dht;
 
-        maybe_invalidate_iterator(crp);
-
-        while (_it != _leveled_sstables.end()) {
-            if (boost::icl::contains(_it->first, crp)) {
-                ssts.insert(ssts.end(), _it->second.begin(), _it->second.end());
-                return std::make_tuple(partitioned_sstable_set::to_partition_range(_it->first), std::move(ssts), next_position(std::next(_it)));
+        _index = _set._leveled_index;
+        if (!_index->segment_count() && _set._leveled_added.empty()) {
+            return std::make_tuple(partition_range::make_open_ended_both_sides(), std::move(ssts), ring_position_view::max());
+        }
+        // The selection holds from the last token at or before pos where an
+        // sstable starts or ends, to right before the first one after it.
+        const auto token = pos.token().raw();
+        std::optional<int64_t> start;
+        std::optional<int64_t> end;
+        auto i = _index->find(token);
+        if (i != sstable_interval_index::npos) {
+            start = _index->segment_start(i);
+            for (auto member : _index->segment(i)) {
+                if (!_set._leveled_erased.contains(_index->sstable(member))) {
+                    ssts.push_back(_index->sstable(member));
+                }
+            }
+            if (i + 1 < _index->segment_count()) {
+                end = _index->segment_start(i + 1);
+            }
+        } else if (_index->segment_count()) {
+            end = _index->segment_start(0);
+        }
+        auto cut = [&] (int64_t t) {
+            if (t <= token) {
+                start = std::max(start.value_or(t), t);
+            } else {
+                end = std::min(end.value_or(t), t);
+            }
+        };
+        for (auto& sst : _set._leveled_added) {
+            auto first = sst->get_first_decorated_key().token().raw();
+            auto last = sst->get_last_decorated_key().token().raw();
+            cut(first);
+            if (last != std::numeric_limits<int64_t>::max()) {
+                cut(last + 1);
             }
-            // We don't want to skip current interval if pos lies before it.
-            if (is_before_interval(crp, _it->first)) {
-                return std::make_tuple(partitioned_sstable_set::to_partition_range(pos, _it->first), std::move(ssts), next_position(_it));
+            if (first <= token && token <= last) {
+                ssts.push_back(sst);
             }
-            _it++;
         }
-        return std::make_tuple(partition_range::make_open_ended_both_sides(), std::move(ssts), ring_position_view::max());
+
+        auto lower = start
+                ? partition_range::bound(ring_position::starting_at(dht::token(*start)), true)
+                : lower_bound(pos);
+        if (!end) {
+            return std::make_tuple(partition_range::make_starting_with(std::move(lower)), std::move(ssts), ring_position_ext(ring_position_view::max()));
+        }
+        auto upper = partition_range::bound(ring_position::starting_at(dht::token(*end)), false);
+        return std::make_tuple(partition_range::make(std::move(lower), std::move(upper)), std::move(ssts), ring_position_ext::starting_at(dht::token(*end)));
     }
 };
 
@@ -748,11 +825,11 @@ std::unique_ptr<position_reader_queue> time_series_sstable_set::make_position_re
 }
 
 sstable_set_impl::selector_and_schema_t partitioned_sstable_set::make_incremental_selector() const {
-    return std::make_tuple(std::make_unique<incremental_selector>(_schema, _unleveled_sstables, _leveled_sstables, _leveled_sstables_change_cnt), std::cref(*_schema));
+    return std::make_tuple(std::make_unique<incremental_selector>(*this), std::cref(*_schema));
 }
 
 std::unique_ptr<sstable_set_impl> compaction_strategy_impl::make_sstable_set(schema_ptr schema) const {
-    // with use_level_metadata enabled, L0 sstables will not go to interval map, which suits well STCS.
+    // with use_level_metadata enabled, L0 sstables will not go to the leveled index, which suits well STCS.
     return std::make_unique<partitioned_sstable_set>(schema, true);
 }
 
@@ -928,6 +1005,37 @@ filter_sstable_for_reader_by_ck(std::vector<shared_sstable>&& sstables, replica:
     return std::move(sstables);
 }
 
+// Filter out sstables for reader using the row filter, for reads which
+// select individual rows by their full clustering key.
+static std::vector<shared_sstable>
+filter_sstable_for_reader_by_row_filter(std::vector<shared_sstable>&& sstables, replica::column_family& cf, const schema& schema,
+        const dht::ring_position& pos, const query::partition_slice& slice) {
+    // Static rows are not covered by the row filter.
+    if (!row_filter::is_supported(schema) || slice.static_columns.size()) {
+        return std::move(sstables);
+    }
+    auto ranges = slice.get_all_ranges();
+    if (ranges.empty() || !std::ranges::all_of(ranges, [&schema] (const query::clustering_range& r) {
+                return r.is_singular() && r.start()->value().is_full(schema);
+            })) {
+        return std::move(sstables);
+    }
+
+    replica::cf_stats* stats = cf.cf_stats();
+    stats->sstables_checked_by_row_filter += sstables.size();
+
+    auto partition_hash = row_filter::make_partition_hashed_key(schema, *pos.key());
+    auto skipped = std::partition(sstables.begin(), sstables.end(), [&] (const shared_sstable& sst) {
+        return std::ranges::any_of(ranges, [&] (const query::clustering_range& r) {
+            return sst->may_contain_row(partition_hash, r.start()->value());
+        });
+    });
+    sstables.erase(skipped, sstables.end());
+    stats->surviving_sstables_after_row_filter += sstables.size();
+
+    return std::move(sstables);
+}
+
 std::vector<frozen_sstable_run>
 sstable_set_impl::all_sstable_runs() const {
     throw_with_backtrace<std::bad_function_call>();
@@ -952,14 +1060,16 @@ sstable_set_impl::create_single_key_sstable_reader(
     if (!num_sstables) {
         return make_empty_flat_reader_v2(schema, permit);
     }
-    auto readers = filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice)
+    selected_sstables = filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice);
+    auto readers = filter_sstable_for_reader_by_row_filter(std::move(selected_sstables), *cf, *schema, pos, slice)
         | std::views::transform([&] (const shared_sstable& sstable) {
             tracing::trace(trace_state, "Reading key {} from sstable {}", pos, seastar::value_of([&sstable] { return sstable->get_filename(); }));
             return sstable->make_reader(schema, permit, pr, slice, trace_state, fwd);
           })
         | std::ranges::to<std::vector<mutation_reader>>();
 
-    // If filter_sstable_for_reader_by_ck filtered any sstable that contains the partition
+    // If filter_sstable_for_reader_by_ck or filter_sstable_for_reader_by_row_filter
+    // filtered any sstable that contains the partition
     // we want to emit partition_start/end if no rows were found,
     // to prevent https://github.com/scylladb/scylla/issues/3552.
     //
@@ -8,7 +8,8 @@
 
 #pragma once
 
-#include <boost/icl/interval_map.hpp>
+#include <span>
+#include <unordered_set>
 
 #include "dht/ring_position.hh"
 #include "sstable_set.hh"
@@ -17,44 +18,85 @@
 
 namespace sstables {
 
+// An immutable index of sstables by the token ranges they cover.
+//
+// The token ring is cut at every sstable boundary into disjoint segments,
+// and each segment lists the sstables covering it. Segment bounds and
+// contents live in flat arrays: a lookup is a binary search over raw tokens
+// followed by a contiguous read, and building the index is a sort plus two
+// passes over the sstables, with no per-segment allocation.
+//
+// Segments are token granular, so an sstable is considered to cover all
+// keys of its first and last tokens. Being immutable, the index is shared
+// by all copies of the set it was built for.
+class sstable_interval_index {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+private:
+    // Start token of each segment, sorted. A segment ends right before the
+    // start of the next one, and the last one extends to the end of the ring.
+    std::vector<int64_t> _starts;
+    // Segment i covers _members[_offsets[i], _offsets[i + 1]).
+    std::vector<uint32_t> _offsets;
+    // Positions in _sstables.
+    std::vector<uint32_t> _members;
+    std::vector<shared_sstable> _sstables;
+public:
+    explicit sstable_interval_index(std::vector<shared_sstable> sstables);
+
+    size_t segment_count() const noexcept {
+        return _starts.size();
+    }
+    const std::vector<shared_sstable>& sstables() const noexcept {
+        return _sstables;
+    }
+    // Returns the segment containing the token, or npos if the token is
+    // before the first segment.
+    size_t find(int64_t token) const noexcept;
+    int64_t segment_start(size_t i) const noexcept {
+        return _starts[i];
+    }
+    std::span<const uint32_t> segment(size_t i) const noexcept {
+        return std::span(_members.data() + _offsets[i], _offsets[i + 1] - _offsets[i]);
+    }
+    const shared_sstable& sstable(uint32_t member) const noexcept {
+        return _sstables[member];
+    }
+    // Appends the sstables overlapping the tokens [first, last] to result.
+    void select(int64_t first, int64_t last, std::vector<shared_sstable>& result) const;
+};
+
 // specialized when sstables are partitioned in the token range space
 // e.g. leveled compaction strategy
 class partitioned_sstable_set : public sstable_set_impl {
-    using value_set = std::unordered_set<shared_sstable>;
-    using interval_map_type = boost::icl::interval_map<dht::compatible_ring_position_or_view, value_set>;
-    using interval_type = interval_map_type::interval_type;
-    using map_iterator = interval_map_type::const_iterator;
 private:
     schema_ptr _schema;
     std::vector<shared_sstable> _unleveled_sstables;
-    interval_map_type _leveled_sstables;
+    lw_shared_ptr<const sstable_interval_index> _leveled_index;
+    // Leveled sstables inserted since the index was built, and indexed ones
+    // erased since. Selection merges them with the index, and insert/erase
+    // rebuild the index once they outgrow a fraction of it, so reads never
+    // rebuild it and the rebuilds are amortized over the updates.
+    std::vector<shared_sstable> _leveled_added;
+    std::unordered_set<shared_sstable> _leveled_erased;
     lw_shared_ptr<sstable_list> _all;
     std::unordered_map<run_id, shared_sstable_run> _all_runs;
-    // Change counter on interval map for leveled sstables which is used by
-    // incremental selector to determine whether or not to invalidate iterators.
-    uint64_t _leveled_sstables_change_cnt = 0;
     bool _use_level_metadata = false;
 private:
-    static interval_type make_interval(const schema& s, const dht::partition_range& range);
-    interval_type make_interval(const dht::partition_range& range) const;
-    static interval_type make_interval(const schema_ptr& s, const sstable& sst);
-    interval_type make_interval(const sstable& sst);
-    interval_type singular(const dht::ring_position& rp) const;
-    std::pair<map_iterator, map_iterator> query(const dht::partition_range& range) const;
-    // SSTables are stored separately to avoid interval map's fragmentation issue when level 0 falls behind.
+    void maybe_rebuild_leveled_index() noexcept;
+    // SSTables are stored separately to avoid fragmenting the index when level 0 falls behind.
     bool store_as_unleveled(const shared_sstable& sst) const;
 public:
-    static dht::ring_position to_ring_position(const dht::compatible_ring_position_or_view& crp);
-    static dht::partition_range to_partition_range(const interval_type& i);
-    static dht::partition_range to_partition_range(const dht::ring_position_view& pos, const interval_type& i);
-
     partitioned_sstable_set(const partitioned_sstable_set&) = delete;
     explicit partitioned_sstable_set(schema_ptr schema, bool use_level_metadata = true);
-    // For cloning the partitioned_sstable_set (makes a deep copy, including *_all)
+    // For cloning the partitioned_sstable_set (makes a deep copy, including *_all,
+    // but shares the immutable leveled index)
     explicit partitioned_sstable_set(
         schema_ptr schema,
         const std::vector<shared_sstable>& unleveled_sstables,
-        const interval_map_type& leveled_sstables,
+        lw_shared_ptr<const sstable_interval_index> leveled_index,
+        const std::vector<shared_sstable>& leveled_added,
+        const std::unordered_set<shared_sstable>& leveled_erased,
         const lw_shared_ptr<sstable_list>& all,
         const std::unordered_map<run_id, shared_sstable_run>& all_runs,
         bool use_level_metadata,
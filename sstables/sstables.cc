@@ -1282,6 +1282,48 @@ double sstable::estimate_droppable_tombstone_ratio(const gc_clock::time_point& c
     return 0.0f;
 }
 
+droppable_tombstone_ranges sstable::estimate_droppable_tombstone_ranges(const gc_clock::time_point& compaction_time, const tombstone_gc_state& gc_state,
+        const schema_ptr& s, double threshold) const {
+    droppable_tombstone_ranges ret;
+    auto* histogram = _components->scylla_metadata ? _components->scylla_metadata->get_tombstone_token_histogram() : nullptr;
+    if (!histogram) {
+        return ret;
+    }
+    int64_t gc_before = get_gc_before_for_drop_estimation(compaction_time, gc_state, s).time_since_epoch().count();
+
+    auto droppable_ratio = [gc_before] (const tombstone_token_histogram_bucket& b) {
+        if (!b.tombstones || gc_before <= b.min_deletion_time) {
+            return 0.0;
+        }
+        // Assume the deletion times are evenly spread within the bucket.
+        double droppable = gc_before > b.max_deletion_time ? b.tombstones
+                : double(b.tombstones) * (gc_before - b.min_deletion_time) / (int64_t(b.max_deletion_time) - b.min_deletion_time + 1);
+        return b.cells ? droppable / b.cells : 1.0;
+    };
+
+    uint64_t partitions = 0;
+    uint64_t droppable_partitions = 0;
+    bool extends_last_range = false;
+    for (const auto& b : histogram->elements) {
+        partitions += b.partitions;
+        if (droppable_ratio(b) < threshold) {
+            extends_last_range = false;
+            continue;
+        }
+        droppable_partitions += b.partitions;
+        auto start = extends_last_range ? ret.ranges.back().start()->value() : dht::token::from_int64(b.first_token);
+        auto range = dht::token_range(dht::token_range::bound(start, true), dht::token_range::bound(dht::token::from_int64(b.last_token), true));
+        if (extends_last_range) {
+            ret.ranges.back() = std::move(range);
+        } else {
+            ret.ranges.push_back(std::move(range));
+        }
+        extends_last_range = true;
+    }
+    ret.partitions_fraction = partitions ? double(droppable_partitions) / partitions : 0.0;
+    return ret;
+}
+
 future<> sstable::read_statistics() {
     return read_simple<component_type::Statistics>(_components->statistics);
 }
@@ -1444,6 +1486,51 @@ void sstable::write_filter() {
     write_simple<component_type::Filter>(filter_ref);
 }
 
+future<> sstable::read_row_filter(sstable_open_config cfg) {
+    if (!cfg.load_bloom_filter || !has_component(component_type::RowFilter)) {
+        _components->row_filter.reset();
+        return make_ready_future<>();
+    }
+
+    return seastar::async([this] () mutable {
+        disk_array<uint32_t, sstables::filter> filters;
+        read_simple<component_type::RowFilter>(filters).get();
+        std::vector<utils::filter_ptr> stages;
+        stages.reserve(filters.elements.size());
+        for (auto& filter : filters.elements) {
+            auto nr_bits = filter.buckets.elements.size() * std::numeric_limits<typename decltype(filter.buckets.elements)::value_type>::digits;
+            large_bitset bs(nr_bits, std::move(filter.buckets.elements));
+            stages.push_back(utils::filter::create_filter(filter.hashes, std::move(bs), utils::filter_format::m_format));
+        }
+        _components->row_filter.emplace(std::move(stages));
+    });
+}
+
+void sstable::write_row_filter() {
+    if (!has_component(component_type::RowFilter)) {
+        return;
+    }
+
+    do_write_simple(component_type::RowFilter, [this] (version_types v, file_writer& w) {
+        const auto& stages = _components->row_filter->stages();
+        uint32_t nr_stages = 0;
+        check_truncate_and_assign(nr_stages, stages.size());
+        write(v, w, nr_stages);
+        for (const auto& stage : stages) {
+            auto f = downcast_ptr<utils::filter::murmur3_bloom_filter>(stage.get());
+            write(v, w, sstables::filter_ref(f->num_hashes(), f->bits().get_storage()));
+        }
+    }, sstable_buffer_size);
+}
+
+bool sstable::may_contain_row(utils::hashed_key partition_hash, const clustering_key_prefix& ck) const {
+    if (!_components->row_filter || !row_filter::is_supported(*_schema)) {
+        return true;
+    }
+    return _components->row_filter->is_present(partition_hash)
+        || _components->row_filter->is_present(row_filter::make_row_hashed_key(partition_hash, ck));
+}
+
 void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
     if (!has_component(component_type::Filter)) {
         return;
@@ -1513,7 +1600,8 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
 
 size_t sstable::total_reclaimable_memory_size() const {
     if (!_total_reclaimable_memory) {
-        _total_reclaimable_memory = _components->filter ? _components->filter->memory_size() : 0;
+        _total_reclaimable_memory = (_components->filter ? _components->filter->memory_size() : 0)
+                + (_components->row_filter ? _components->row_filter->memory_size() : 0);
     }
 
     return _total_reclaimable_memory.value();
@@ -1532,6 +1620,12 @@ size_t sstable::reclaim_memory_from_components() {
         }
     }
 
+    if (_components->row_filter) {
+        // Without a row filter, every row may be present.
+        memory_reclaimed_this_iteration += _components->row_filter->memory_size();
+        _components->row_filter.reset();
+    }
+
     _total_reclaimable_memory.reset();
     _total_memory_reclaimed += memory_reclaimed_this_iteration;
     return memory_reclaimed_this_iteration;
@@ -1550,8 +1644,12 @@ future<> sstable::reload_reclaimed_components() {
     co_await utils::get_local_injector().inject("reload_reclaimed_components/pause", utils::wait_for_message(std::chrono::seconds(5)));
 
     co_await read_filter();
+    co_await read_row_filter();
     _total_reclaimable_memory.reset();
     _total_memory_reclaimed -= _components->filter->memory_size();
+    if (_components->row_filter) {
+        _total_memory_reclaimed -= _components->row_filter->memory_size();
+    }
     sstlog.info("Reloaded bloom filter of {}", get_filename());
 }
 
@@ -1566,6 +1664,7 @@ future<> sstable::load_metadata(sstable_open_config cfg, bool validate) noexcept
     co_await coroutine::all(
             [&] { return read_compression(); },
             [&] { return read_filter(cfg); },
+            [&] { return read_row_filter(cfg); },
             [&] { return read_summary(); });
     if (validate) {
         validate_min_max_metadata();
@@ -1815,7 +1914,8 @@ sstable::read_scylla_metadata() noexcept {
 
 void
 sstable::write_scylla_metadata(shard_id shard, sstable_enabled_features features, struct run_identifier identifier,
-        std::optional<scylla_metadata::large_data_stats> ld_stats, std::optional<scylla_metadata::ext_timestamp_stats> ts_stats) {
+        std::optional<scylla_metadata::large_data_stats> ld_stats, std::optional<scylla_metadata::ext_timestamp_stats> ts_stats,
+        std::optional<scylla_metadata::tombstone_token_histogram> tt_histogram) {
     auto&& first_key = get_first_decorated_key();
     auto&& last_key = get_last_decorated_key();
 
@@ -1868,6 +1968,9 @@ sstable::write_scylla_metadata(shard_id shard, sstable_enabled_features features
 
         _components->scylla_metadata->data.set<scylla_metadata_type::ExtTimestampStats>(std::move(*ts_stats));
     }
+    if (tt_histogram) {
+        _components->scylla_metadata->data.set<scylla_metadata_type::TombstoneTokenHistogram>(std::move(*tt_histogram));
+    }
 
     sstable_id sid;
     if (generation().is_uuid_based()) {
@@ -2158,6 +2261,20 @@ uint64_t sstable::bytes_on_disk() const {
     return _metadata_size_on_disk + _data_file_size + _index_file_size;
 }
 
+std::optional<hll::HyperLogLog> sstable::get_partition_cardinality_sketch() const {
+    auto entry = _components->statistics.contents.find(metadata_type::Compaction);
+    if (entry == _components->statistics.contents.end() || !entry->second) {
+        return std::nullopt;
+    }
+    const auto& m = *static_cast<const compaction_metadata*>(entry->second.get());
+    try {
+        return hll::HyperLogLog::from_bytes(m.cardinality.elements);
+    } catch (const std::invalid_argument& e) {
+        sstlog.trace("Cannot use the cardinality metadata of {}: {}", get_filename(), e.what());
+        return std::nullopt;
+    }
+}
+
 uint64_t sstable::filter_size() const {
     return _components->filter->memory_size();
 }
@@ -3129,6 +3246,8 @@ future<> init_metrics() {
             sm::description("Number of promoted index blocks which got inserted")),
         sm::make_counter("pi_cache_evictions", [] { return promoted_index_cache_metrics.evictions; },
             sm::description("Number of promoted index blocks which got evicted")),
+        sm::make_counter("pi_cache_prefetches", [] { return promoted_index_cache_metrics.prefetches; },
+            sm::description("Number of promoted indexes which were read as a whole ahead of the lookup")),
         sm::make_gauge("pi_cache_bytes", [] { return promoted_index_cache_metrics.used_bytes; },
             sm::description("Number of bytes currently used by cached promoted index blocks")),
         sm::make_gauge("pi_cache_block_count", [] { return promoted_index_cache_metrics.block_count; },
@@ -37,6 +37,7 @@
 #include "sstables/storage.hh"
 #include "sstables/generation_type.hh"
 #include "sstables/types.hh"
+#include "sstables/hyperloglog.hh"
 #include "sstables/checksummed_data_source.hh"
 #include "mutation/mutation_fragment_stream_validator.hh"
 #include "readers/mutation_reader_fwd.hh"
@@ -110,6 +111,12 @@ struct sstable_writer_config {
     size_t summary_byte_cost;
     sstring origin;
     bool correct_pi_block_width = true;
+    // If engaged, compressed sstables are written with this chunk length
+    // instead of the one in the table's compression parameters.
+    std::optional<uint32_t> compression_chunk_length;
+    // False-positive chance of the row filter, see row_filter.
+    // 1.0 disables writing a row filter.
+    double row_filter_fp_chance = 1.0;
 
 private:
     explicit sstable_writer_config() {}
@@ -173,6 +180,15 @@ inline fs::path make_path(std::string_view table_dir, sstable_state state) {
 
 constexpr const char* repair_origin = "repair";
 
+// Token ranges of an sstable with a high ratio of droppable tombstones,
+// see sstable::estimate_droppable_tombstone_ranges().
+struct droppable_tombstone_ranges {
+    // Sorted, disjoint, closed token ranges.
+    dht::token_range_vector ranges;
+    // Fraction of the partitions of the sstable within the ranges.
+    double partitions_fraction = 0;
+};
+
 class delayed_commit_changes {
     std::unordered_set<sstring> _dirs;
     friend class filesystem_storage;
@@ -651,11 +667,17 @@ class sstable : public enable_lw_shared_from_this<sstable> {
                                sstable_enabled_features features,
                                run_identifier identifier,
                                std::optional<scylla_metadata::large_data_stats> ld_stats,
-                               std::optional<scylla_metadata::ext_timestamp_stats> ts_stats);
+                               std::optional<scylla_metadata::ext_timestamp_stats> ts_stats,
+                               std::optional<scylla_metadata::tombstone_token_histogram> tt_histogram = std::nullopt);
 
     future<> read_filter(sstable_open_config cfg = {});
 
     void write_filter();
+
+    future<> read_row_filter(sstable_open_config cfg = {});
+
+    void write_row_filter();
+
     // Rebuild a bloom filter from the index with the given number of
     // partitions, if the partition estimate provided during bloom
     // filter initialisation was not good.
@@ -701,7 +723,7 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     future<> create_data() noexcept;
 
-    // Note that only bloom filters are reclaimable by the following methods.
+    // Note that only bloom filters and row filters are reclaimable by the following methods.
     // Return the total reclaimable memory in this SSTable
     size_t total_reclaimable_memory_size() const;
     // Reclaim memory from the components back to the system.
@@ -853,6 +875,12 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     static utils::hashed_key make_hashed_key(const schema& s, const partition_key& key);
 
+    // Checks the row filter for whether the sstable may contain the
+    // clustering row `ck` of the partition with the given hash, see
+    // row_filter::make_partition_hashed_key(). `ck` must be a full
+    // clustering key. Always true for sstables without a row filter.
+    bool may_contain_row(utils::hashed_key partition_hash, const clustering_key_prefix& ck) const;
+
     filter_tracker& get_filter_tracker() { return _filter_tracker; }
 
     uint64_t filter_get_false_positive() const {
@@ -899,6 +927,10 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         const compaction_metadata& s = *static_cast<compaction_metadata *>(p.get());
         return s;
     }
+    // Returns the sketch of the partition key cardinality, stored in the
+    // compaction metadata, or std::nullopt if it is missing or written in
+    // a format we can't read.
+    std::optional<hll::HyperLogLog> get_partition_cardinality_sketch() const;
     const serialization_header& get_serialization_header() const {
         return get_mutable_serialization_header(*_components);
     }
@@ -950,6 +982,12 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // is the point before which expiring data can be purged.
     double estimate_droppable_tombstone_ratio(const gc_clock::time_point& compaction_time, const tombstone_gc_state& gc_state, const schema_ptr& s) const;
 
+    // Gets the token ranges of the sstable whose droppable tombstone ratio is
+    // at least threshold, based on the tombstone token histogram in the Scylla
+    // metadata. No ranges are returned for sstables written without it.
+    droppable_tombstone_ranges estimate_droppable_tombstone_ranges(const gc_clock::time_point& compaction_time, const tombstone_gc_state& gc_state,
+            const schema_ptr& s, double threshold) const;
+
     // get sstable open info from a loaded sstable, which can be used to quickly open a sstable
     // at another shard.
     future<foreign_sstable_open_info> get_open_info() &;
@@ -11,6 +11,7 @@
 #include "utils/log.hh"
 #include "sstables/sstables_manager.hh"
 #include "sstables/sstables_registry.hh"
+#include "sstables/object_storage_cache.hh"
 #include "sstables/partition_index_cache.hh"
 #include "sstables/sstables.hh"
 #include "db/config.hh"
@@ -59,13 +60,27 @@ storage_manager::storage_manager(const db::config& cfg, config stm_cfg)
     for (auto [ep, ecfg] : cfg.object_storage_config()) {
         _s3_endpoints.emplace(std::make_pair(std::move(ep), make_lw_shared<s3::endpoint_config>(std::move(ecfg))));
     }
+    if (!cfg.object_storage_cache_directory().empty() && cfg.object_storage_cache_size_in_mb() > 0) {
+        _object_storage_cache = std::make_unique<object_storage_cache>(object_storage_cache::config{
+            .dir = std::filesystem::path(cfg.object_storage_cache_directory()) / fmt::to_string(this_shard_id()),
+            .capacity = (cfg.object_storage_cache_size_in_mb() << 20) / smp::count,
+            .no_admission_groups = std::move(stm_cfg.object_storage_cache_no_admission_groups),
+            .download_group = stm_cfg.object_storage_cache_download_group,
+        });
+    }
 }
 
+storage_manager::~storage_manager() = default;
+
 future<> storage_manager::stop() {
     if (_config_updater) {
         co_await _config_updater->action.join();
     }
 
+    if (_object_storage_cache) {
+        co_await _object_storage_cache->stop();
+    }
+
     for (auto ep : _s3_endpoints) {
         if (ep.second.client != nullptr) {
             co_await ep.second.client->close();
@@ -105,6 +120,18 @@ bool storage_manager::is_known_endpoint(sstring endpoint) const {
     return _s3_endpoints.contains(endpoint);
 }
 
+future<> storage_manager::invalidate_object_storage_cache(sstring object_name) {
+    return container().invoke_on_all([object_name] (storage_manager& sstm) {
+        return sstm._object_storage_cache ? sstm._object_storage_cache->invalidate(object_name) : make_ready_future<>();
+    });
+}
+
+future<> storage_manager::reconcile_object_storage_cache() {
+    return container().invoke_on_all([] (storage_manager& sstm) {
+        return sstm._object_storage_cache ? sstm._object_storage_cache->reconcile() : make_ready_future<>();
+    });
+}
+
 storage_manager::config_updater::config_updater(const db::config& cfg, storage_manager& sstm)
     : action([&sstm, &cfg] () mutable {
         return sstm.container().invoke_on_all([&cfg] (auto& sstm) {
@@ -146,6 +173,7 @@ sstable_writer_config sstables_manager::configure_writer(sstring origin) const {
             ? mutation_fragment_stream_validation_level::clustering_key
             : mutation_fragment_stream_validation_level::token;
     cfg.summary_byte_cost = summary_byte_cost(_db_config.sstable_summary_ratio());
+    cfg.row_filter_fp_chance = _db_config.sstable_row_filter_fp_chance();
 
     cfg.origin = std::move(origin);
 
@@ -39,6 +39,7 @@ namespace gms { class feature_service; }
 namespace sstables {
 
 class directory_semaphore;
+class object_storage_cache;
 using schema_ptr = lw_shared_ptr<const schema>;
 using shareable_components_ptr = lw_shared_ptr<shareable_components>;
 
@@ -60,17 +61,29 @@ class storage_manager : public peering_sharded_service<storage_manager> {
     semaphore _s3_clients_memory;
     std::unordered_map<sstring, s3_endpoint> _s3_endpoints;
     std::unique_ptr<config_updater> _config_updater;
+    std::unique_ptr<object_storage_cache> _object_storage_cache;
 
     void update_config(const db::config&);
 
 public:
     struct config {
         size_t s3_clients_memory = 16 << 20; // 16M by default
+        // Reads running in these groups don't make local copies of object storage components.
+        std::vector<scheduling_group> object_storage_cache_no_admission_groups;
+        // Local copies of object storage components are made in this group.
+        scheduling_group object_storage_cache_download_group = default_scheduling_group();
     };
 
     storage_manager(const db::config&, config cfg);
+    ~storage_manager();
     shared_ptr<s3::client> get_endpoint_client(sstring endpoint);
     bool is_known_endpoint(sstring endpoint) const;
+    // Returns nullptr unless object_storage_cache_directory is configured.
+    object_storage_cache* get_object_storage_cache() noexcept { return _object_storage_cache.get(); }
+    // Removes the local copies of a deleted object on all shards.
+    future<> invalidate_object_storage_cache(sstring object_name);
+    // Removes the local copies which don't belong to any loaded sstable on all shards.
+    future<> reconcile_object_storage_cache();
     future<> stop();
 };
 
@@ -153,6 +166,15 @@ class sstables_manager {
         return _storage->is_known_endpoint(std::move(endpoint));
     }
 
+    object_storage_cache* get_object_storage_cache() const {
+        return _storage ? _storage->get_object_storage_cache() : nullptr;
+    }
+
+    future<> invalidate_object_storage_cache(sstring object_name) const {
+        SCYLLA_ASSERT(_storage != nullptr);
+        return _storage->invalidate_object_storage_cache(std::move(object_name));
+    }
+
     virtual sstable_writer_config configure_writer(sstring origin) const;
     bool uuid_sstable_identifiers() const;
     const db::config& config() const { return _db_config; }
@@ -22,6 +22,7 @@
 
 #include "db/config.hh"
 #include "sstables/exceptions.hh"
+#include "sstables/object_storage_cache.hh"
 #include "sstables/sstable_directory.hh"
 #include "sstables/sstables_manager.hh"
 #include "sstables/sstable_version.hh"
@@ -505,14 +506,20 @@ future<> filesystem_storage::remove_by_registry_entry(entry_descriptor desc) {
 
 class s3_storage : public sstables::storage {
     shared_ptr<s3::client> _client;
+    sstring _endpoint;
     sstring _bucket;
     std::variant<sstring, table_id> _location;
+    object_storage_cache* _cache;
 
     static constexpr auto status_creating = "creating";
     static constexpr auto status_sealed = "sealed";
     static constexpr auto status_removing = "removing";
 
     sstring make_s3_object_name(const sstable& sst, component_type type) const;
+    // Buckets of different endpoints may have the same name.
+    sstring make_cache_key(const sstring& object_name) const {
+        return _endpoint + object_name;
+    }
 
     table_id owner() const {
         if (std::holds_alternative<sstring>(_location)) {
@@ -522,10 +529,12 @@ class s3_storage : public sstables::storage {
     }
 
 public:
-    s3_storage(shared_ptr<s3::client> client, sstring bucket, std::variant<sstring, table_id> loc)
+    s3_storage(shared_ptr<s3::client> client, sstring endpoint, sstring bucket, std::variant<sstring, table_id> loc, object_storage_cache* cache)
         : _client(std::move(client))
+        , _endpoint(std::move(endpoint))
         , _bucket(std::move(bucket))
         , _location(std::move(loc))
+        , _cache(cache)
     {
     }
 
@@ -585,7 +594,14 @@ void s3_storage::open(sstable& sst) {
 }
 
 future<file> s3_storage::open_component(const sstable& sst, component_type type, open_flags flags, file_open_options options, bool check_integrity) {
-    co_return _client->make_readable_file(make_s3_object_name(sst, type));
+    auto object_name = make_s3_object_name(sst, type);
+    // Other components are read once, when the sstable is loaded.
+    if (_cache && (type == component_type::Index || type == component_type::Data)) {
+        co_return co_await _cache->open(make_cache_key(object_name), [client = _client, object_name] {
+            return client->make_readable_file(object_name);
+        });
+    }
+    co_return _client->make_readable_file(std::move(object_name));
 }
 
 future<data_sink> s3_storage::make_data_or_index_sink(sstable& sst, component_type type) {
@@ -618,7 +634,11 @@ future<> s3_storage::wipe(const sstable& sst, sync_dir) noexcept {
     co_await sstables_registry.update_entry_status(owner(), sst.generation(), status_removing);
 
     co_await coroutine::parallel_for_each(sst._recognized_components, [this, &sst] (auto type) -> future<> {
-        co_await _client->delete_object(make_s3_object_name(sst, type));
+        auto object_name = make_s3_object_name(sst, type);
+        co_await _client->delete_object(object_name);
+        if (_cache) {
+            co_await sst.manager().invalidate_object_storage_cache(make_cache_key(object_name));
+        }
     });
 
     co_await sstables_registry.delete_entry(owner(), sst.generation());
@@ -676,7 +696,7 @@ std::unique_ptr<sstables::storage> make_storage(sstables_manager& manager, const
                     }, os.location)) {
                 on_internal_error(sstlog, "S3 storage options is missing 'location'");
             }
-            return std::make_unique<sstables::s3_storage>(manager.get_endpoint_client(os.endpoint), os.bucket, os.location);
+            return std::make_unique<sstables::s3_storage>(manager.get_endpoint_client(os.endpoint), os.endpoint, os.bucket, os.location, manager.get_object_storage_cache());
         }
     }, s_opts.value);
 }
@@ -535,6 +535,7 @@ enum class scylla_metadata_type : uint32_t {
     ScyllaVersion = 8,
     ExtTimestampStats = 9,
     SSTableIdentifier = 10,
+    TombstoneTokenHistogram = 11,
 };
 
 // UUID is used for uniqueness across nodes, such that an imported sstable
@@ -591,6 +592,27 @@ enum class ext_timestamp_stats_type : uint32_t {
     min_live_row_marker_timestamp = 2,
 };
 
+// Cell and tombstone counts of a run of partitions adjacent in token order.
+// Tombstones and deletion times are counted the same way as for
+// estimated_tombstone_drop_time in the statistics component: expiring
+// cells count as tombstones, with their expiry as deletion time.
+// min_deletion_time and max_deletion_time are only meaningful when
+// tombstones is non-zero.
+struct tombstone_token_histogram_bucket {
+    int64_t first_token;        // token of the first partition in the bucket
+    int64_t last_token;         // token of the last partition in the bucket
+    uint64_t partitions;
+    uint64_t cells;
+    uint64_t tombstones;
+    int32_t min_deletion_time;
+    int32_t max_deletion_time;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) {
+        return f(first_token, last_token, partitions, cells, tombstones, min_deletion_time, max_deletion_time);
+    }
+};
+
 struct scylla_metadata {
     using extension_attributes = disk_hash<uint32_t, disk_string<uint32_t>, disk_string<uint32_t>>;
     using large_data_stats = disk_hash<uint32_t, large_data_type, large_data_stats_entry>;
@@ -599,6 +621,7 @@ struct scylla_metadata {
     using scylla_version = disk_string<uint32_t>;
     using ext_timestamp_stats = disk_hash<uint32_t, ext_timestamp_stats_type, int64_t>;
     using sstable_identifier = sstable_identifier_type;
+    using tombstone_token_histogram = disk_array<uint32_t, tombstone_token_histogram_bucket>;
 
     disk_set_of_tagged_union<scylla_metadata_type,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::Sharding, sharding_metadata>,
@@ -610,7 +633,8 @@ struct scylla_metadata {
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ScyllaBuildId, scylla_build_id>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ScyllaVersion, scylla_version>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ExtTimestampStats, ext_timestamp_stats>,
-            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::SSTableIdentifier, sstable_identifier>
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::SSTableIdentifier, sstable_identifier>,
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::TombstoneTokenHistogram, tombstone_token_histogram>
             > data;
 
     sstable_enabled_features get_features() const {
@@ -645,6 +669,9 @@ struct scylla_metadata {
         auto* sid = data.get<scylla_metadata_type::SSTableIdentifier, scylla_metadata::sstable_identifier>();
         return sid ? sid->value : sstable_id::create_null_id();
     }
+    const tombstone_token_histogram* get_tombstone_token_histogram() const {
+        return data.get<scylla_metadata_type::TombstoneTokenHistogram, tombstone_token_histogram>();
+    }
 
     template <typename Describer>
     auto describe_type(sstable_version_types v, Describer f) { return f(data); }
@@ -14,6 +14,8 @@
 #include "cql3/query_processor.hh"
 #include "cql3/statements/create_table_statement.hh"
 #include "cql3/statements/modification_statement.hh"
+#include "cql3/statements/batch_statement.hh"
+#include "cql3/cql_config.hh"
 #include "replica/database.hh"
 #include "service/migration_manager.hh"
 
@@ -139,6 +141,45 @@ future<> table_helper::insert(cql3::query_processor& qp, service::migration_mana
     co_await _insert_stmt->execute(qp, qs, opts, std::nullopt);
 }
 
+future<> table_helper::insert_batch(cql3::query_processor& qp, service::migration_manager& mm, service::query_state& qs, std::vector<batch_row> rows) {
+    if (rows.empty()) {
+        co_return;
+    }
+
+    std::vector<table_helper*> tables;
+    for (auto& row : rows) {
+        if (std::ranges::find(tables, row.table) == tables.end()) {
+            tables.push_back(row.table);
+        }
+    }
+
+    // A prepared statement may get invalidated while we are waiting for
+    // another table's one to be prepared, so make sure all of them are ready
+    // after the last preemption point.
+    auto all_prepared = [&tables] {
+        return std::ranges::all_of(tables, [] (const table_helper* t) { return bool(t->_prepared_stmt); });
+    };
+    do {
+        for (auto* t : tables) {
+            co_await t->cache_table_info(qp, mm, qs);
+        }
+    } while (!all_prepared());
+
+    std::vector<cql3::statements::batch_statement::single_statement> modifications;
+    std::vector<cql3::raw_value_view_vector_with_unset> values;
+    modifications.reserve(rows.size());
+    values.reserve(rows.size());
+    for (auto& row : rows) {
+        row.options.prepare(row.table->_prepared_stmt->bound_names);
+        modifications.emplace_back(row.table->_insert_stmt, false);
+        values.emplace_back(row.options.get_values());
+    }
+
+    auto batch_options = cql3::query_options::make_batch_options(cql3::query_options(cql3::default_cql_config, db::consistency_level::ANY, std::nullopt, std::vector<cql3::raw_value>{}, false, cql3::query_options::specific_options::DEFAULT), std::move(values));
+    cql3::statements::batch_statement batch(cql3::statements::batch_statement::type::UNLOGGED, std::move(modifications), cql3::attributes::none(), qp.get_cql_stats());
+    co_await batch.execute(qp, qs, batch_options, std::nullopt);
+}
+
 future<> table_helper::setup_keyspace(cql3::query_processor& qp, service::migration_manager& mm, std::string_view keyspace_name, sstring replication_factor, service::query_state& qs, std::vector<table_helper*> tables) {
     if (this_shard_id() != 0) {
         co_return;
@@ -99,6 +99,25 @@ class table_helper {
 
     future<> insert(cql3::query_processor& qp, service::migration_manager& mm, service::query_state& qs, noncopyable_function<cql3::query_options ()> opt_maker);
 
+    /**
+     * A single row to be inserted by insert_batch(): the table to insert into
+     * and the values for its INSERT statement (either positional or named).
+     */
+    struct batch_row {
+        table_helper* table;
+        cql3::query_options options;
+    };
+
+    /**
+     * Execute insertions of several rows, possibly into different tables, as
+     * a single UNLOGGED batch. The batch is subject to the batch size
+     * thresholds when it spans several partitions, so it is up to the caller
+     * to keep it small.
+     *
+     * @param rows rows to insert
+     */
+    static future<> insert_batch(cql3::query_processor& qp, service::migration_manager& mm, service::query_state& qs, std::vector<batch_row> rows);
+
     static future<> setup_keyspace(cql3::query_processor& qp, service::migration_manager& mm, std::string_view keyspace_name, sstring replication_factor, service::query_state& qs, std::vector<table_helper*> tables);
 
     /**
@@ -227,3 +227,17 @@ def test_long_delete(test_table):
     test_table.put_item(Item={'p': p, 'c': c, 'att': val, 'another': val2}, ReturnConsumedCapacity='TOTAL')
     response = test_table.delete_item(Key={'p': p, 'c': c}, ReturnConsumedCapacity='TOTAL', ReturnValues='ALL_OLD')
     assert 3 == response['ConsumedCapacity']["CapacityUnits"]
+
+# A list is charged for its logical size: 3 bytes, plus one byte and the
+# size of each element. The list below is about 1.8KB, but its text
+# representation is several times longer. The capacity must not depend on
+# how Alternator stores the list, for reads and for the old item returned
+# by ReturnValues=ALL_OLD alike.
+def test_list_capacity(test_table):
+    p = random_string()
+    c = random_string()
+    test_table.put_item(Item={'p': p, 'c': c, 'l': ['a'] * 900})
+    response = test_table.get_item(Key={'p': p, 'c': c}, ConsistentRead=True, ReturnConsumedCapacity='TOTAL')
+    assert 1 == response['ConsumedCapacity']["CapacityUnits"]
+    response = test_table.delete_item(Key={'p': p, 'c': c}, ReturnConsumedCapacity='TOTAL', ReturnValues='ALL_OLD')
+    assert 2 == response['ConsumedCapacity']["CapacityUnits"]
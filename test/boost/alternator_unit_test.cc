@@ -14,6 +14,8 @@
 #include "utils/base64.hh"
 #include "utils/rjson.hh"
 #include "alternator/serialization.hh"
+#include "alternator/ttl.hh"
+#include "types/types.hh"
 
 static std::map<std::string, std::string> strings {
     {"", ""},
@@ -166,3 +168,103 @@ BOOST_AUTO_TEST_CASE(test_magnitude_and_precision) {
     res = alternator::internal::get_magnitude_and_precision("1e-1000000000000");
     BOOST_CHECK(res.magnitude < -1000);
 }
+
+// Check that attribute values without a native Scylla type (sets, lists,
+// maps, NULL) survive a round trip through both the binary encoding and the
+// older JSON text encoding, and that the binary encoding can read values
+// written in the older encoding.
+BOOST_AUTO_TEST_CASE(test_serialize_item_binary_encoding) {
+    std::vector<std::string> values = {
+        R"({"SS":["a","bc",""]})",
+        R"({"NS":["1","-2.5e10","0.000"]})",
+        R"({"BS":["YWJj","YQ=="]})",
+        R"({"NULL":true})",
+        R"({"L":[]})",
+        R"({"M":{}})",
+        R"({"L":[{"S":"x"},{"N":"12.30"},{"B":"YWI="},{"BOOL":false},{"NULL":true},{"SS":["y"]}]})",
+        R"({"M":{"a":{"S":"x"},"b":{"L":[{"M":{"c":{"N":"1"},"":{"BOOL":true}}}]},"d":{"NS":["3"]}}})",
+    };
+    for (auto& str : values) {
+        rjson::value v = rjson::parse(str);
+
+        bytes json_encoded = alternator::serialize_item(v, alternator::attribute_encoding::json);
+        BOOST_REQUIRE_EQUAL(json_encoded[0], int8_t(alternator::alternator_type::NOT_SUPPORTED_YET));
+        BOOST_REQUIRE_EQUAL(rjson::print(alternator::deserialize_item(json_encoded)), rjson::print(v));
+
+        bytes binary_encoded = alternator::serialize_item(v, alternator::attribute_encoding::binary);
+        BOOST_REQUIRE_GT(binary_encoded[0], int8_t(alternator::alternator_type::NOT_SUPPORTED_YET));
+        BOOST_REQUIRE_LT(binary_encoded.size(), json_encoded.size());
+        BOOST_REQUIRE_EQUAL(rjson::print(alternator::deserialize_item(binary_encoded)), rjson::print(v));
+        BOOST_REQUIRE_EQUAL(rjson::print(alternator::deserialize_item(json_encoded)), rjson::print(v));
+
+        // Write capacity is charged for the value, not for how it is stored.
+        BOOST_REQUIRE_EQUAL(alternator::item_length_in_bytes(v, json_encoded), alternator::item_length_in_bytes(v, binary_encoded));
+        // Read capacity too, which is charged for stored values.
+        BOOST_REQUIRE_EQUAL(alternator::item_length_in_bytes(json_encoded), alternator::item_length_in_bytes(v, json_encoded));
+        BOOST_REQUIRE_EQUAL(alternator::item_length_in_bytes(binary_encoded), alternator::item_length_in_bytes(v, binary_encoded));
+
+        // A truncated value must be rejected, not silently misread.
+        BOOST_REQUIRE_THROW(alternator::deserialize_item(bytes_view(binary_encoded).substr(0, binary_encoded.size() - 1)), std::runtime_error);
+    }
+}
+
+// Check that rjson::chunked_content_writer, used for printing large Query
+// and Scan responses, produces the same text as rjson::print() while never
+// using large contiguous chunks.
+BOOST_AUTO_TEST_CASE(test_chunked_content_writer) {
+    rjson::value items = rjson::empty_array();
+    for (int i = 0; i < 1000; ++i) {
+        rjson::value item = rjson::parse(R"({"p":{"S":"key"},"a":{"L":[{"N":"1"},{"S":"some text value"}]}})");
+        rjson::add(item, "i", rjson::value(i));
+        rjson::push_back(items, std::move(item));
+    }
+    rjson::chunked_content_writer writer;
+    writer.write_raw("{\"Items\":");
+    writer.write(items);
+    writer.write_raw("}");
+    auto size = writer.size();
+    std::string expected = "{\"Items\":" + rjson::print(items) + "}";
+    BOOST_REQUIRE_EQUAL(size, expected.size());
+    std::string printed;
+    auto chunks = std::move(writer).finish();
+    BOOST_REQUIRE_GT(chunks.size(), 1);
+    for (const auto& chunk : chunks) {
+        BOOST_REQUIRE(!chunk.empty());
+        BOOST_REQUIRE_LE(chunk.size(), 16 * 1024);
+        printed.append(chunk.get(), chunk.size());
+    }
+    BOOST_REQUIRE_EQUAL(printed, expected);
+}
+
+// Test the expiration_index used by the expiration service to find items
+// which are due to expire without scanning entire tables.
+BOOST_AUTO_TEST_CASE(test_expiration_index) {
+    alternator::expiration_index index(3);
+    index.set_horizon(std::chrono::hours(1));
+    auto now = gc_clock::now();
+    auto t = table_id::create_random_id();
+    auto key = [] (std::string_view k) {
+        return partition_key::from_single_value(*utf8_type, to_bytes(k));
+    };
+    // Items expiring beyond the horizon, or so long ago that they never
+    // expire, are not indexed.
+    BOOST_REQUIRE(!index.add(now + std::chrono::hours(2), t, key("far")));
+    BOOST_REQUIRE(!index.add(now - std::chrono::years(6), t, key("malformed")));
+    BOOST_REQUIRE(index.add(now + std::chrono::minutes(30), t, key("c")));
+    BOOST_REQUIRE(index.add(now - std::chrono::minutes(1), t, key("a")));
+    BOOST_REQUIRE(index.add(now + std::chrono::minutes(10), t, key("b")));
+    BOOST_REQUIRE_EQUAL(index.size(), 3);
+    // When full, the latest-expiring entries are the ones dropped.
+    BOOST_REQUIRE(!index.add(now + std::chrono::minutes(40), t, key("d")));
+    BOOST_REQUIRE(index.add(now + std::chrono::minutes(5), t, key("e")));
+    BOOST_REQUIRE_EQUAL(index.size(), 3);
+
+    auto due = index.pop_due(now);
+    BOOST_REQUIRE_EQUAL(due.size(), 1);
+    BOOST_REQUIRE(due[0].key == to_bytes(key("a").representation()));
+    due = index.pop_due(now + std::chrono::minutes(20));
+    BOOST_REQUIRE_EQUAL(due.size(), 2);
+    BOOST_REQUIRE(due[0].key == to_bytes(key("e").representation()));
+    BOOST_REQUIRE(due[1].key == to_bytes(key("b").representation()));
+    BOOST_REQUIRE_EQUAL(index.size(), 0);
+}
@@ -204,6 +204,25 @@ BOOST_AUTO_TEST_CASE(test_big_decimal_sub) {
     test_sub("+10.", "1.e+1", "0");
 }
 
+// Values that fit in 128 bits are computed natively, check the results
+// are the same when crossing into and out of the cpp_int representation.
+BOOST_AUTO_TEST_CASE(test_big_decimal_int128_boundary) {
+    test_add("170141183460469231731687303715884105727", "1", "170141183460469231731687303715884105728");
+    test_add("170141183460469231731687303715884105728", "-1", "170141183460469231731687303715884105727");
+    test_sub("-170141183460469231731687303715884105728", "1", "-170141183460469231731687303715884105729");
+    test_add("1.7014118346046923173168730371588410572", "0.00000000000000000000000000000000000001", "1.70141183460469231731687303715884105721");
+    test_add("99999999999999999999999999999999999999", "99999999999999999999999999999999999999", "199999999999999999999999999999999999998");
+    test_div("-170141183460469231731687303715884105728", 1, "-170141183460469231731687303715884105728");
+    test_div("-170141183460469231731687303715884105728", 3, "-56713727820156410577229101238628035243");
+    test_div("340282366920938463463374607431768211455", 2, "170141183460469231731687303715884105728");
+
+    const auto min = big_decimal("-170141183460469231731687303715884105728");
+    BOOST_REQUIRE_EQUAL((-min).to_string(), "170141183460469231731687303715884105728");
+    BOOST_REQUIRE_EQUAL(min.to_string(), "-170141183460469231731687303715884105728");
+    BOOST_REQUIRE(big_decimal("1e-38") < big_decimal("170141183460469231731687303715884105727"));
+    BOOST_REQUIRE((big_decimal("1.00000000000000000000000000000000000000") <=> big_decimal("1")) == 0);
+}
+
 
 BOOST_AUTO_TEST_CASE(test_boost_multiprecision_sign) {
     namespace bmp = boost::multiprecision;
@@ -41,11 +41,13 @@
 #include "utils/log.hh"
 #include "test/lib/exception_utils.hh"
 #include "test/lib/cql_test_env.hh"
+#include "test/lib/cql_assertions.hh"
 #include "test/lib/data_model.hh"
 #include "test/lib/sstable_utils.hh"
 #include "test/lib/mutation_source_test.hh"
 #include "test/lib/key_utils.hh"
 #include "test/lib/test_utils.hh"
+#include "test/lib/random_utils.hh"
 
 using namespace db;
 
@@ -973,6 +975,49 @@ SEASTAR_TEST_CASE(test_commitlog_replay_invalid_key){
     });
 }
 
+// Replays segments concurrently, with mutations too large for a single entry
+// written as several entries which span segments.
+SEASTAR_TEST_CASE(test_commitlog_replay_parallel_fragmented) {
+    auto cfg = cql_test_config();
+    cfg.db_config->commitlog_segment_size_in_mb.set(1);
+    // Big enough for the commitlog not to flush the (empty) memtables, which
+    // would free the segments before they are replayed.
+    cfg.db_config->commitlog_total_space_in_mb.set(1024);
+    cfg.db_config->commitlog_use_fragmented_entries.set(true);
+    cfg.db_config->commitlog_replay_parallelism.set(4);
+
+    return do_with_cql_env_thread([] (cql_test_env& env) {
+        env.execute_cql("create table ks.t (pk int, ck int, v blob, primary key (pk, ck))").get();
+
+        auto& table = env.local_db().find_column_family("ks", "t");
+        auto& cl = *table.commitlog();
+        auto s = table.schema();
+
+        std::vector<std::vector<bytes_opt>> expected;
+        for (int pk = 0; pk < 16; ++pk) {
+            // Every other mutation is larger than a segment.
+            auto rows = pk % 2 ? 24 : 1;
+            mutation m(s, partition_key::from_single_value(*s, int32_type->decompose(pk)));
+            for (int ck = 0; ck < rows; ++ck) {
+                auto v = tests::random::get_bytes(64 * 1024);
+                m.set_clustered_cell(clustering_key::from_single_value(*s, int32_type->decompose(ck)), "v", data_value(v), api::new_timestamp());
+                expected.push_back({int32_type->decompose(pk), int32_type->decompose(ck), std::move(v)});
+            }
+            auto fm = freeze(m);
+            commitlog_entry_writer cew(s, fm, db::commitlog::force_sync::no);
+            cl.add_entry(s->id(), cew, db::no_timeout).get();
+        }
+        cl.sync_all_segments().get();
+
+        auto paths = cl.get_active_segment_names();
+        BOOST_REQUIRE_GT(paths.size(), 4u);
+        auto rp = db::commitlog_replayer::create_replayer(env.db(), env.get_system_keyspace()).get();
+        rp.recover(paths, db::commitlog::descriptor::FILENAME_PREFIX).get();
+
+        assert_that(env.execute_cql("select pk, ck, v from ks.t").get()).is_rows().with_rows_ignore_order(std::move(expected));
+    }, cfg);
+}
+
 using namespace std::chrono_literals;
 
 SEASTAR_TEST_CASE(test_commitlog_add_entry) {
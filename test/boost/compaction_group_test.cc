@@ -23,6 +23,7 @@
 
 #include "sstables/sstables.hh"
 #include "sstables/compress.hh"
+#include "sstables/open_info.hh"
 #include "compaction/compaction.hh"
 #include "compaction/compaction_manager.hh"
 #include "replica/compaction_group.hh"
@@ -110,6 +111,9 @@ class single_compaction_group : public compaction::table_state {
     virtual reader_permit make_compaction_reader_permit() const override { return _semaphore.make_permit(); }
     virtual sstables::sstables_manager& get_sstables_manager() noexcept override { return _sst_man; }
     virtual sstables::shared_sstable make_sstable() const override { return _sstable_factory(); }
+    virtual future<sstables::shared_sstable> load_foreign_sstable(sstables::foreign_sstable_open_info info) const override {
+        return make_exception_future<sstables::shared_sstable>(std::runtime_error("loading foreign sstables is not supported"));
+    }
     virtual sstables::sstable_writer_config configure_writer(sstring origin) const override { return _sst_man.configure_writer(std::move(origin)); }
     virtual api::timestamp_type min_memtable_timestamp() const override { return api::min_timestamp; }
     virtual api::timestamp_type min_memtable_live_timestamp() const override { return api::min_timestamp; }
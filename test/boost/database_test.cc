@@ -20,6 +20,8 @@
 #include <fmt/std.h>
 
 #include "test/lib/cql_test_env.hh"
+#include "test/lib/cql_assertions.hh"
+#include "test/lib/eventually.hh"
 #include "test/lib/result_set_assertions.hh"
 #include "test/lib/log.hh"
 #include "test/lib/random_utils.hh"
@@ -1271,6 +1273,44 @@ SEASTAR_TEST_CASE(upgrade_sstables) {
     });
 }
 
+// Regular compactions handed over to an idle shard must leave the data intact,
+// with the new sstables replacing the inputs on the owning shard.
+SEASTAR_TEST_CASE(test_regular_compaction_work_stealing) {
+    cql_test_config cfg;
+    cfg.db_config->compaction_work_stealing_backlog_ratio(std::numeric_limits<float>::min(), utils::config_file::config_source::CommandLine);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.cf (p int, c int, v int, PRIMARY KEY (p, c)) "
+                "WITH compaction = {'class': 'SizeTieredCompactionStrategy', 'min_threshold': 2}").get();
+        e.db().invoke_on_all([] (replica::database& db) {
+            return db.find_column_family("ks", "cf").disable_auto_compaction();
+        }).get();
+
+        constexpr int partitions = 16;
+        constexpr int flushes = 4;
+        for (int c = 0; c < flushes; ++c) {
+            for (int p = 0; p < partitions; ++p) {
+                e.execute_cql(format("INSERT INTO ks.cf (p, c, v) VALUES ({}, {}, {})", p, c, p * c)).get();
+            }
+            e.db().invoke_on_all([] (replica::database& db) {
+                return db.find_column_family("ks", "cf").flush();
+            }).get();
+        }
+
+        // Compact only on this shard, leaving the other shards idle.
+        auto& t = e.local_db().find_column_family("ks", "cf");
+        t.enable_auto_compaction();
+        t.trigger_compaction();
+        BOOST_REQUIRE(eventually_true([&] { return t.sstables_count() <= 1; }));
+        BOOST_REQUIRE_EQUAL(e.local_db().get_compaction_manager().get_stats().errors, 0);
+        if (smp::count > 1) {
+            BOOST_REQUIRE_GT(e.local_db().get_compaction_manager().get_stats().offloaded_tasks, 0);
+        }
+
+        auto msg = e.execute_cql("SELECT * FROM ks.cf").get();
+        assert_that(msg).is_rows().with_size(partitions * flushes);
+    }, cfg);
+}
+
 SEASTAR_TEST_CASE(populate_from_quarantine_works) {
     auto tmpdir_for_data = make_lw_shared<tmpdir>();
     auto db_cfg_ptr = make_shared<db::config>();
@@ -1491,3 +1531,33 @@ SEASTAR_TEST_CASE(mutation_dump_generated_schema_deterministic_id_version) {
 
     return make_ready_future<>();
 }
+
+SEASTAR_THREAD_TEST_CASE(test_compaction_chunk_length_read_classification) {
+    using namespace std::chrono_literals;
+    auto rates = [] (uint64_t count, double rate) {
+        utils::rate_moving_average r;
+        r.count = count;
+        r.rates[2] = rate;
+        return r;
+    };
+    auto chunk_length = [] (const utils::rate_moving_average& point, const utils::rate_moving_average& range, lowres_clock::duration tracked_for) {
+        return replica::table::compaction_chunk_length_for_reads(16 * 1024, point, range, tracked_for);
+    };
+
+    // Right after a restart, the rates are still 0.
+    BOOST_REQUIRE(!chunk_length(rates(0, 0), rates(0, 0), 1min));
+    // Reads were seen, but the rates were not updated yet.
+    BOOST_REQUIRE(!chunk_length(rates(5000, 0), rates(0, 0), 5s));
+    // Too few reads to tell the workload apart early on.
+    BOOST_REQUIRE(!chunk_length(rates(100, 10), rates(0, 0), 1min));
+
+    // Point reads dominate.
+    BOOST_REQUIRE_EQUAL(chunk_length(rates(5000, 95), rates(500, 5), 1min), 4 * 1024);
+    BOOST_REQUIRE_EQUAL(chunk_length(rates(100, 95), rates(5, 5), 1h), 4 * 1024);
+    // Scans dominate.
+    BOOST_REQUIRE_EQUAL(chunk_length(rates(500, 5), rates(5000, 95), 1min), 64 * 1024);
+    // A mixed workload keeps the configured chunk length.
+    BOOST_REQUIRE(!chunk_length(rates(5000, 50), rates(5000, 50), 1h));
+    // A table only looks cold once the rates cover their whole window.
+    BOOST_REQUIRE_EQUAL(chunk_length(rates(10, 0), rates(0, 0), 1h), 64 * 1024);
+}
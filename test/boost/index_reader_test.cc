@@ -251,3 +251,60 @@ SEASTAR_TEST_CASE(test_no_data_file_read_on_missing_clustering_keys_with_dense_i
         }
     });
 }
+
+SEASTAR_TEST_CASE(test_small_promoted_index_is_read_in_single_io) {
+    return test_env::do_with_async([](test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+
+        auto pk = ss.make_pkey();
+        auto mut = mutation(s, pk);
+
+        std::vector<clustering_key> keys;
+        const auto n_keys = 64;
+        auto key_size = 128; // so that the promoted index spans several pages, but is still small
+        keys.reserve(n_keys);
+        for (int i = 0; i < n_keys; ++i) {
+            keys.push_back(ss.make_ckey(make_random_string(key_size)));
+            ss.add_row(mut, keys[i], "v");
+        }
+
+        clustering_key::less_compare less(*s);
+        std::sort(keys.begin(), keys.end(), less);
+
+        env.manager().set_promoted_index_block_size(1); // force entry for each row
+        auto mut_reader = make_mutation_reader_from_mutations_v2(s, env.make_reader_permit(), std::move(mut));
+        auto sst = make_sstable_easy(env, std::move(mut_reader), env.manager().configure_writer());
+
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        auto permit = semaphore.make_permit();
+        tracing::trace_state_ptr trace = nullptr;
+
+        // Without caching, the cursor gets its own cached_file, so none of the promoted index pages are cached.
+        auto index = std::make_unique<index_reader>(sst, permit, trace, use_caching::no, true);
+        auto close_index = deferred_close(*index);
+
+        index->advance_to(dht::ring_position_view(pk)).get();
+        index->read_partition_data().get();
+
+        auto cur = dynamic_cast<mc::bsearch_clustered_cursor*>(index->current_clustered_cursor());
+        BOOST_REQUIRE(cur);
+
+        auto& pi = cur->promoted_index();
+        auto start_in_page = pi._promoted_index_start % cached_file::page_size;
+        auto pages = div_ceil(start_in_page + pi._promoted_index_size, cached_file::page_size);
+        BOOST_REQUIRE_LE(pi._promoted_index_size, mc::cached_promoted_index::max_prefetch_size);
+        BOOST_REQUIRE_GT(pages, 2);
+
+        auto& stats = sst->manager().get_cache_tracker().get_index_cached_file_stats();
+        auto misses_before = stats.page_misses;
+        auto populations_before = stats.page_populations;
+
+        auto skip = cur->advance_to(position_in_partition::before_key(keys[n_keys / 2])).get();
+        BOOST_REQUIRE(skip);
+
+        // The binary search touches several pages, but they are all read together.
+        BOOST_REQUIRE_EQUAL(stats.page_misses - misses_before, 1);
+        BOOST_REQUIRE_EQUAL(stats.page_populations - populations_before, pages);
+    });
+}
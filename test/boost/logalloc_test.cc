@@ -96,6 +96,55 @@ SEASTAR_TEST_CASE(test_compaction) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_compaction_time_accounting) {
+    region reg;
+    with_allocator(reg.allocator(), [&reg] {
+        std::vector<managed_ref<int>> allocated;
+        for (int i = 0; i < 32 * 1024 * 8; i++) {
+            allocated.push_back(make_managed<int>());
+        }
+        // Make every segment sparse
+        for (size_t i = 0; i < allocated.size(); i += 2) {
+            allocated[i] = {};
+        }
+
+        auto before = shard_tracker().statistics();
+        shard_tracker().full_compaction();
+        auto diff = shard_tracker().statistics() - before;
+
+        BOOST_REQUIRE_GT(diff.segments_compacted, 0);
+        BOOST_REQUIRE_GT(diff.inline_compaction_time.count(), 0);
+        BOOST_REQUIRE_EQUAL(diff.background_compaction_time.count(), 0);
+    });
+}
+
+SEASTAR_THREAD_TEST_CASE(test_background_compaction) {
+    region reg;
+    with_allocator(reg.allocator(), [&reg] {
+        std::vector<managed_ref<int>> allocated;
+        for (int i = 0; i < 4 * 32 * 1024 * 8; i++) {
+            allocated.push_back(make_managed<int>());
+        }
+        // Make every segment sparse
+        for (size_t i = 0; i < allocated.size(); i += 2) {
+            allocated[i] = {};
+        }
+        // Leave no free segments in the pool, so it isn't the reason not to compact.
+        shard_tracker().reclaim_all_free_segments();
+
+        auto before = shard_tracker().statistics();
+        auto total_space_before = reg.occupancy().total_space();
+        while (shard_tracker().compact_in_background()) {
+        }
+        auto diff = shard_tracker().statistics() - before;
+
+        BOOST_REQUIRE_GT(diff.segments_compacted, 0);
+        BOOST_REQUIRE_GT(diff.background_compaction_time.count(), 0);
+        BOOST_REQUIRE_EQUAL(diff.inline_compaction_time.count(), 0);
+        BOOST_REQUIRE_LT(reg.occupancy().total_space(), total_space_before);
+    });
+}
+
 SEASTAR_TEST_CASE(test_occupancy) {
     return seastar::async([] {
         region reg;
@@ -130,6 +179,31 @@ SEASTAR_TEST_CASE(test_occupancy) {
 }
 
 
+SEASTAR_TEST_CASE(test_huge_page_occupancy) {
+    return seastar::async([] {
+        auto before = shard_tracker().huge_page_occupancy();
+        {
+            region reg;
+            with_allocator(reg.allocator(), [&reg] {
+                std::vector<managed_bytes> objs;
+                // Fill several huge pages worth of segments
+                while (reg.occupancy().total_space() < 8 * 2 * 1024 * 1024) {
+                    objs.emplace_back(managed_bytes(managed_bytes::initialized_later(), 1024));
+                }
+
+                auto occ = shard_tracker().huge_page_occupancy();
+                BOOST_REQUIRE_GE(occ.total_space(), reg.occupancy().total_space());
+                BOOST_REQUIRE_LE(occ.used_space(), occ.total_space());
+                BOOST_REQUIRE_GE(occ.used_space(), reg.occupancy().total_space());
+                BOOST_REQUIRE_EQUAL(occ.total_space() % (2 * 1024 * 1024), 0);
+            });
+        }
+        auto after = shard_tracker().huge_page_occupancy();
+        BOOST_REQUIRE_EQUAL(after.total_space(), before.total_space());
+        BOOST_REQUIRE_EQUAL(after.used_space(), before.used_space());
+    });
+}
+
 SEASTAR_TEST_CASE(test_compaction_with_multiple_regions) {
     return seastar::async([] {
         region reg1;
@@ -467,6 +467,63 @@ SEASTAR_TEST_CASE(test_segment_migration_during_flush) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_flush_readers_of_split_token_span) {
+    simple_schema ss;
+    auto s = ss.schema();
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+
+    replica::table_stats tbl_stats;
+    replica::memtable_table_shared_data table_shared_data;
+    replica::dirty_memory_manager mgr;
+
+    auto mt = make_lw_shared<replica::memtable>(s, mgr, table_shared_data, tbl_stats);
+    BOOST_REQUIRE_EQUAL(mt->split_token_span(4).size(), 1);
+
+    std::vector<mutation> ring;
+    for (auto& pk : ss.make_pkeys(100)) {
+        mutation m(s, pk);
+        ss.add_row(m, ss.make_ckey(0), "v");
+        mt->apply(m);
+        ring.push_back(std::move(m));
+    }
+
+    BOOST_REQUIRE_EQUAL(mt->split_token_span(1).size(), 1);
+    auto ranges = mt->split_token_span(4);
+    BOOST_REQUIRE_GT(ranges.size(), 1);
+    BOOST_REQUIRE_LE(ranges.size(), 4);
+
+    // Read all ranges concurrently, one partition at a time from each.
+    std::vector<mutation_reader> readers;
+    for (auto& range : ranges) {
+        readers.push_back(mt->make_flush_reader(s, semaphore.make_permit(), range));
+    }
+    std::vector<std::vector<mutation>> results(readers.size());
+    bool done = false;
+    while (!done) {
+        done = true;
+        for (size_t i = 0; i < readers.size(); ++i) {
+            auto mo = read_mutation_from_mutation_reader(readers[i]).get();
+            if (mo) {
+                results[i].push_back(std::move(*mo));
+                done = false;
+            }
+        }
+    }
+    for (auto& rd : readers) {
+        rd.close().get();
+    }
+
+    std::vector<mutation> flushed;
+    for (auto& result : results) {
+        BOOST_REQUIRE(!result.empty());
+        std::move(result.begin(), result.end(), std::back_inserter(flushed));
+    }
+    BOOST_REQUIRE_EQUAL(flushed.size(), ring.size());
+    for (size_t i = 0; i < ring.size(); ++i) {
+        assert_that(flushed[i]).is_equal_to(ring[i]);
+    }
+}
+
 // Reproducer for #2854
 SEASTAR_TEST_CASE(test_fast_forward_to_after_memtable_is_flushed) {
     return seastar::async([] {
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <deque>
+
+#include "test/lib/scylla_test_case.hh"
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/core/file.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/util/defer.hh>
+
+#include "test/lib/eventually.hh"
+#include "test/lib/random_utils.hh"
+#include "test/lib/tmpdir.hh"
+
+#include "sstables/object_storage_cache.hh"
+
+using namespace sstables;
+
+static void write_file(const std::filesystem::path& path, const sstring& contents) {
+    auto f = open_file_dma(path.native(), open_flags::create | open_flags::wo).get();
+    auto out = make_file_output_stream(std::move(f)).get();
+    auto close_out = defer([&] { out.close().get(); });
+    out.write(contents.begin(), contents.size()).get();
+    out.flush().get();
+}
+
+static sstring read_all(file f, size_t size) {
+    auto close_f = defer([&] { f.close().get(); });
+    auto buf = f.dma_read_bulk<char>(0, size).get();
+    return sstring(buf.get(), buf.size());
+}
+
+// Stands in for the object storage client. The remote files are opened
+// upfront, since the cache asks for them outside of a seastar thread.
+static noncopyable_function<file()> remote_files(const std::filesystem::path& path, unsigned count) {
+    auto files = make_lw_shared<std::deque<file>>();
+    for (unsigned i = 0; i < count; ++i) {
+        files->push_back(open_file_dma(path.native(), open_flags::ro).get());
+    }
+    return [files] {
+        auto f = std::move(files->front());
+        files->pop_front();
+        return f;
+    };
+}
+
+SEASTAR_THREAD_TEST_CASE(test_object_storage_cache) {
+    tmpdir remote_dir;
+    tmpdir cache_dir;
+
+    // Takes more than one transfer to copy.
+    auto contents = tests::random::get_sstring(object_storage_cache::transfer_size * 3 / 2);
+    auto remote_path = remote_dir.path() / "object";
+    write_file(remote_path, contents);
+
+    auto a = sstring("/bucket/a/Data.db");
+    auto b = sstring("/bucket/b/Data.db");
+    auto a_copy = cache_dir.path() / "%2Fbucket%2Fa%2FData.db";
+    auto b_copy = cache_dir.path() / "%2Fbucket%2Fb%2FData.db";
+    auto stale_copy = cache_dir.path() / "%2Fbucket%2Fstale%2FData.db";
+
+    {
+        object_storage_cache cache({cache_dir.path(), 4 * contents.size()});
+        auto stop_cache = defer([&] { cache.stop().get(); });
+
+        // Opening alone doesn't make a copy, the first read does, in the background.
+        auto f = cache.open(a, remote_files(remote_path, 2)).get();
+        BOOST_REQUIRE_EQUAL(cache.get_stats().misses, 1);
+        BOOST_REQUIRE_EQUAL(f.dma_read_bulk<char>(0, 1).get()[0], contents[0]);
+        REQUIRE_EVENTUALLY_EQUAL(cache.get_stats().admissions, 1);
+        BOOST_REQUIRE(file_exists(a_copy.native()).get());
+        BOOST_REQUIRE_EQUAL(cache.get_stats().bytes, contents.size());
+        // Whether the read goes to the remote file or to the copy, the contents are the same.
+        BOOST_REQUIRE_EQUAL(read_all(std::move(f), contents.size()), contents);
+
+        f = cache.open(a, remote_files(remote_path, 0)).get();
+        BOOST_REQUIRE_EQUAL(cache.get_stats().hits, 1);
+        BOOST_REQUIRE_EQUAL(read_all(std::move(f), contents.size()), contents);
+    }
+
+    // Belongs to an sstable which was deleted while the node was down.
+    write_file(stale_copy, contents);
+
+    {
+        // The copies survive a restart.
+        object_storage_cache cache({cache_dir.path(), 4 * contents.size()});
+        auto stop_cache = defer([&] { cache.stop().get(); });
+
+        auto f = cache.open(a, remote_files(remote_path, 0)).get();
+        BOOST_REQUIRE_EQUAL(cache.get_stats().hits, 1);
+        BOOST_REQUIRE_EQUAL(cache.get_stats().bytes, 2 * contents.size());
+        BOOST_REQUIRE_EQUAL(read_all(std::move(f), contents.size()), contents);
+
+        // Only the copies which were opened are kept.
+        cache.reconcile().get();
+        BOOST_REQUIRE(!file_exists(stale_copy.native()).get());
+        BOOST_REQUIRE(file_exists(a_copy.native()).get());
+        BOOST_REQUIRE_EQUAL(cache.get_stats().bytes, contents.size());
+    }
+
+    {
+        // Only one copy fits, the least recently opened one is removed.
+        object_storage_cache cache({cache_dir.path(), contents.size()});
+        auto stop_cache = defer([&] { cache.stop().get(); });
+
+        // Goes back to the remote file once its copy is removed.
+        auto fa = cache.open(a, remote_files(remote_path, 1)).get();
+        BOOST_REQUIRE_EQUAL(cache.get_stats().hits, 1);
+
+        auto f = cache.open(b, remote_files(remote_path, 2)).get();
+        BOOST_REQUIRE_EQUAL(f.dma_read_bulk<char>(0, 1).get()[0], contents[0]);
+        REQUIRE_EVENTUALLY_EQUAL(cache.get_stats().admissions, 1);
+        BOOST_REQUIRE_EQUAL(cache.get_stats().evictions, 1);
+        BOOST_REQUIRE(eventually_true([&] { return !file_exists(a_copy.native()).get(); }));
+        BOOST_REQUIRE(file_exists(b_copy.native()).get());
+        BOOST_REQUIRE_EQUAL(read_all(std::move(f), contents.size()), contents);
+        BOOST_REQUIRE_EQUAL(read_all(std::move(fa), contents.size()), contents);
+
+        cache.invalidate(b).get();
+        BOOST_REQUIRE(!file_exists(b_copy.native()).get());
+        BOOST_REQUIRE_EQUAL(cache.get_stats().bytes, 0);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_object_storage_cache_no_admission_groups) {
+    tmpdir remote_dir;
+    tmpdir cache_dir;
+
+    auto contents = tests::random::get_sstring(4096);
+    auto remote_path = remote_dir.path() / "object";
+    write_file(remote_path, contents);
+
+    object_storage_cache cache({cache_dir.path(), 4 * contents.size(), {current_scheduling_group()}});
+    auto stop_cache = defer([&] { cache.stop().get(); });
+
+    auto f = cache.open("/bucket/a/Data.db", remote_files(remote_path, 1)).get();
+    BOOST_REQUIRE_EQUAL(read_all(std::move(f), contents.size()), contents);
+    stop_cache.cancel();
+    // Waits for the copies being made.
+    cache.stop().get();
+    BOOST_REQUIRE_EQUAL(cache.get_stats().misses, 1);
+    BOOST_REQUIRE_EQUAL(cache.get_stats().admissions, 0);
+    BOOST_REQUIRE(!file_exists((cache_dir.path() / "%2Fbucket%2Fa%2FData.db").native()).get());
+}
+
+SEASTAR_THREAD_TEST_CASE(test_object_storage_cache_oversized) {
+    tmpdir remote_dir;
+    tmpdir cache_dir;
+
+    auto contents = tests::random::get_sstring(4096);
+    auto remote_path = remote_dir.path() / "object";
+    write_file(remote_path, contents);
+
+    object_storage_cache cache({cache_dir.path(), contents.size() - 1});
+    auto stop_cache = defer([&] { cache.stop().get(); });
+
+    auto f = cache.open("/bucket/a/Data.db", remote_files(remote_path, 2)).get();
+    BOOST_REQUIRE_EQUAL(read_all(std::move(f), contents.size()), contents);
+    REQUIRE_EVENTUALLY_EQUAL(cache.get_stats().oversized, 1);
+    BOOST_REQUIRE_EQUAL(cache.get_stats().admissions, 0);
+}
@@ -2084,6 +2084,91 @@ SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
     });
 }
 
+SEASTAR_TEST_CASE(tombstone_compaction_isolates_droppable_token_ranges) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("tests", "tombstone_token_histogram")
+                .with_column("p1", utf8_type, column_kind::partition_key)
+                .with_column("c1", utf8_type, column_kind::clustering_key)
+                .with_column("r1", utf8_type)
+                .build();
+        auto table = env.make_table_for_tests(s);
+        auto close_table = deferred_stop(table);
+        auto sst_gen = env.make_sst_factory(s);
+
+        static constexpr size_t total_keys = 200;
+        static constexpr size_t first_expired = 100;
+        static constexpr size_t last_expired = 139;
+        auto keys = tests::generate_partition_keys(total_keys, s);
+        auto now = gc_clock::now();
+        auto c_key = clustering_key::from_exploded(*s, {to_bytes("c1")});
+        const auto& r1 = *s->get_column_definition("r1");
+
+        auto mt = make_lw_shared<replica::memtable>(s);
+        for (size_t i = 0; i < total_keys; ++i) {
+            mutation m(s, keys[i]);
+            if (i >= first_expired && i <= last_expired) {
+                auto expiration_time = (now - gc_clock::duration(DEFAULT_GC_GRACE_SECONDS * 2 + i)).time_since_epoch().count();
+                m.set_clustered_cell(c_key, r1, make_atomic_cell(utf8_type, bytes("a"), 1, expiration_time));
+            } else {
+                m.set_clustered_cell(c_key, r1, make_atomic_cell(utf8_type, bytes("a")));
+            }
+            mt->apply(std::move(m));
+        }
+        auto sst = make_sstable_containing(sst_gen, mt);
+
+        auto* histogram = sst->get_scylla_metadata()->get_tombstone_token_histogram();
+        BOOST_REQUIRE(histogram);
+        BOOST_REQUIRE_GT(histogram->elements.size(), 1);
+        BOOST_REQUIRE_LE(histogram->elements.size(), 2 * tombstone_token_histogram_collector::target_buckets);
+        uint64_t partitions = 0;
+        uint64_t tombstones = 0;
+        for (const auto& b : histogram->elements) {
+            BOOST_REQUIRE_LE(b.first_token, b.last_token);
+            partitions += b.partitions;
+            tombstones += b.tombstones;
+        }
+        BOOST_REQUIRE_EQUAL(partitions, total_keys);
+        BOOST_REQUIRE_EQUAL(tombstones, last_expired - first_expired + 1);
+
+        tombstone_gc_state gc_state(nullptr);
+        auto droppable = sst->estimate_droppable_tombstone_ranges(now, gc_state, s, 0.2);
+        BOOST_REQUIRE_EQUAL(droppable.ranges.size(), 1);
+        const auto& range = droppable.ranges.front();
+        for (size_t i = first_expired; i <= last_expired; ++i) {
+            BOOST_REQUIRE(range.contains(keys[i].token(), dht::token_comparator()));
+        }
+        BOOST_REQUIRE(!range.contains(keys.front().token(), dht::token_comparator()));
+        BOOST_REQUIRE(!range.contains(keys.back().token(), dht::token_comparator()));
+        BOOST_REQUIRE_LT(droppable.partitions_fraction, 0.5);
+
+        std::map<sstring, sstring> options;
+        options.emplace("tombstone_threshold", "0.1");
+        auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, options);
+        sstables::test(sst).set_data_file_write_time(db_clock::time_point::min());
+        auto descriptor = get_sstables_for_compaction(cs, table.as_table_state(), { sst });
+        BOOST_REQUIRE_EQUAL(descriptor.sstables.size(), 1);
+        BOOST_REQUIRE_EQUAL(descriptor.isolated_token_ranges.size(), 1);
+        auto isolated = descriptor.isolated_token_ranges.front();
+
+        auto info = compact_sstables(env, std::move(descriptor), table, sst_gen).get();
+        BOOST_REQUIRE_GE(info.new_sstables.size(), 2);
+        partitions = 0;
+        for (const auto& new_sst : info.new_sstables) {
+            auto first = new_sst->get_first_decorated_key().token();
+            auto last = new_sst->get_last_decorated_key().token();
+            // Output sstables don't straddle the bounds of the isolated range.
+            BOOST_REQUIRE_EQUAL(isolated.contains(first, dht::token_comparator()), isolated.contains(last, dht::token_comparator()));
+            BOOST_REQUIRE(isolated.contains(first, dht::token_comparator())
+                    || last < isolated.start()->value() || first > isolated.end()->value());
+            BOOST_REQUIRE_EQUAL(new_sst->estimate_droppable_tombstone_ratio(now, gc_state, s), 0.0);
+            for (const auto& b : new_sst->get_scylla_metadata()->get_tombstone_token_histogram()->elements) {
+                partitions += b.partitions;
+            }
+        }
+        BOOST_REQUIRE_EQUAL(partitions, total_keys - (last_expired - first_expired + 1));
+    });
+}
+
 SEASTAR_TEST_CASE(compaction_correctness_with_partitioned_sstable_set) {
     return test_env::do_with_async([] (test_env& env) {
         auto builder = schema_builder("tests", "tombstone_purge")
@@ -6090,3 +6175,57 @@ SEASTAR_TEST_CASE(splitting_compaction_test) {
                             std::runtime_error);
     });
 }
+
+SEASTAR_TEST_CASE(partition_overlap_estimate_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        auto pks = ss.make_pkeys(1500);
+
+        auto make_sst = [&] (size_t first, size_t last, size_t value_size) {
+            std::vector<mutation> muts;
+            for (size_t i = first; i < last; ++i) {
+                auto m = mutation(s, pks[i]);
+                ss.add_row(m, ss.make_ckey(0), tests::random::get_sstring(value_size));
+                muts.push_back(std::move(m));
+            }
+            return make_sstable_containing(env.make_sstable(s), std::move(muts));
+        };
+        auto check_estimate = [] (uint64_t estimate, uint64_t expected) {
+            testlog.info("estimate: {}, expected: {}", estimate, expected);
+            BOOST_REQUIRE_GE(estimate, expected * 0.85);
+            BOOST_REQUIRE_LE(estimate, expected * 1.15);
+        };
+
+        auto sst1 = make_sst(0, 1000, 1);
+        auto sst2 = make_sst(500, 1500, 1);
+
+        auto sketch = sst1->get_partition_cardinality_sketch();
+        BOOST_REQUIRE(sketch);
+        check_estimate(sketch->estimate(), 1000);
+
+        auto overlap = estimate_partition_overlap({sst1, sst2});
+        BOOST_REQUIRE(overlap);
+        check_estimate(overlap->total_partitions, 2000);
+        check_estimate(overlap->distinct_partitions, 1500);
+        BOOST_REQUIRE_GT(overlap->deduplication_ratio(), 0.15);
+        BOOST_REQUIRE_LT(overlap->deduplication_ratio(), 0.35);
+
+        // Among size tiers with as many sstables, the one whose
+        // sstables overlap the most is picked.
+        std::vector<shared_sstable> candidates;
+        for (size_t i = 0; i < 4; ++i) {
+            // Disjoint sstables, in a small tier.
+            candidates.push_back(make_sst(i * 100, (i + 1) * 100, 1));
+            // Overlapping sstables, in a large tier.
+            candidates.push_back(make_sst(0, 100, 1000));
+        }
+        auto options = size_tiered_compaction_strategy_options(std::map<sstring, sstring>{
+            {size_tiered_compaction_strategy_options::MIN_SSTABLE_SIZE_KEY, "1"}});
+        auto bucket = size_tiered_compaction_strategy::most_interesting_bucket(candidates, 4, 32, options);
+        BOOST_REQUIRE_EQUAL(bucket.size(), 4);
+        for (const auto& sst : bucket) {
+            BOOST_REQUIRE_GT(sst->data_size(), 50000);
+        }
+    });
+}
@@ -3286,3 +3286,85 @@ SEASTAR_TEST_CASE(sstable_identifier_correctness) {
         BOOST_REQUIRE_EQUAL(sst->sstable_identifier()->uuid(), sst->generation().as_uuid());
     });
 }
+
+SEASTAR_TEST_CASE(sstable_row_filter) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        auto pks = ss.make_pkeys(2);
+        const uint32_t rows = 2000;
+
+        // Rows with even clustering keys only.
+        auto mut1 = mutation(s, pks[0]);
+        for (uint32_t i = 0; i < rows; ++i) {
+            ss.add_row(mut1, ss.make_ckey(2 * i), "v");
+        }
+        // A single range tombstone, which may cover any row.
+        auto mut2 = mutation(s, pks[1]);
+        ss.delete_range(mut2, ss.make_ckey_range(10, 20));
+
+        auto cfg = env.manager().configure_writer();
+        cfg.row_filter_fp_chance = 0.01;
+        // Estimate a single partition, so the row filter has to grow.
+        auto sst = make_sstable_easy(env, make_mutation_reader_from_mutations_v2(s, env.make_reader_permit(), {mut1, mut2}), cfg);
+        BOOST_REQUIRE(sst->has_component(component_type::RowFilter));
+        sst = env.reusable_sst(sst).get();
+
+        auto hash1 = row_filter::make_partition_hashed_key(*s, pks[0].key());
+        uint32_t false_positives = 0;
+        for (uint32_t i = 0; i < rows; ++i) {
+            BOOST_REQUIRE(sst->may_contain_row(hash1, ss.make_ckey(2 * i)));
+            false_positives += sst->may_contain_row(hash1, ss.make_ckey(2 * i + 1));
+        }
+        testlog.info("row filter false positives: {}/{}", false_positives, rows);
+        // Leave plenty of slack over the configured 1%.
+        BOOST_REQUIRE_LT(false_positives, rows / 20);
+
+        auto hash2 = row_filter::make_partition_hashed_key(*s, pks[1].key());
+        for (uint32_t i = 0; i < 100; ++i) {
+            BOOST_REQUIRE(sst->may_contain_row(hash2, ss.make_ckey(i)));
+        }
+
+        // No row filter is written when it is disabled.
+        cfg.row_filter_fp_chance = 1.0;
+        sst = make_sstable_easy(env, make_mutation_reader_from_mutations_v2(s, env.make_reader_permit(), {mut1, mut2}), cfg);
+        BOOST_REQUIRE(!sst->has_component(component_type::RowFilter));
+        BOOST_REQUIRE(sst->may_contain_row(hash1, ss.make_ckey(1)));
+
+        // Nor for clustering keys with several serialized forms of equal values.
+        auto vs = schema_builder(some_keyspace, some_column_family)
+                    .with_column("p1", utf8_type, column_kind::partition_key)
+                    .with_column("c1", varint_type, column_kind::clustering_key)
+                    .with_column("r1", int32_type)
+                    .build();
+        BOOST_REQUIRE(!row_filter::is_supported(*vs));
+        mutation vm(vs, partition_key::from_exploded(*vs, {to_bytes("key1")}));
+        vm.set_clustered_cell(clustering_key::from_exploded(*vs, {to_bytes("\x01")}), "r1", data_value(1), api::new_timestamp());
+        cfg.row_filter_fp_chance = 0.01;
+        sst = make_sstable_easy(env, make_mutation_reader_from_mutations_v2(vs, env.make_reader_permit(), {vm}), cfg);
+        BOOST_REQUIRE(!sst->has_component(component_type::RowFilter));
+    });
+}
+
+SEASTAR_TEST_CASE(sstable_compression_chunk_length_override) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        BOOST_REQUIRE(s->get_compressor_params().get_compressor());
+        BOOST_REQUIRE_NE(s->get_compressor_params().chunk_length(), 64 * 1024);
+        auto pks = ss.make_pkeys(1);
+        auto mut = mutation(s, pks[0]);
+        for (uint32_t i = 0; i < 1000; ++i) {
+            ss.add_row(mut, ss.make_ckey(i), format("v{}", i));
+        }
+
+        auto cfg = env.manager().configure_writer();
+        cfg.compression_chunk_length = 64 * 1024;
+        auto sst = make_sstable_easy(env, make_mutation_reader_from_mutations_v2(s, env.make_reader_permit(), {mut}), cfg);
+        sst = env.reusable_sst(sst).get();
+        BOOST_REQUIRE_EQUAL(sst->get_compression().uncompressed_chunk_length(), 64 * 1024);
+        assert_that(sstable_reader_v2(sst, s, env.make_reader_permit()))
+            .produces(mut)
+            .produces_end_of_stream();
+    });
+}
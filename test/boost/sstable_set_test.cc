@@ -20,6 +20,8 @@
 #include "test/lib/cql_test_env.hh"
 #include "test/lib/simple_schema.hh"
 #include "test/lib/sstable_utils.hh"
+#include "test/lib/key_utils.hh"
+#include "test/lib/random_utils.hh"
 #include "readers/from_mutations_v2.hh"
 
 using namespace sstables;
@@ -197,3 +199,81 @@ SEASTAR_TEST_CASE(test_tablet_sstable_set_copy_ctor) {
 
     }, std::move(cfg));
 }
+
+SEASTAR_TEST_CASE(test_partitioned_sstable_set_select) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        const auto keys = tests::generate_partition_keys(32, s);
+
+        struct sst_bounds {
+            shared_sstable sst;
+            size_t first;
+            size_t last;
+        };
+        std::vector<sst_bounds> ssts;
+        auto set = make_lw_shared<sstable_set>(std::make_unique<partitioned_sstable_set>(s, false));
+        auto make_sst = [&] {
+            auto first = tests::random::get_int<size_t>(0, keys.size() - 1);
+            auto last = tests::random::get_int<size_t>(first, std::min(first + 4, keys.size() - 1));
+            auto sst = env.make_sstable(s);
+            sstables::test(sst).set_values_for_leveled_strategy(1 /* data_size */, 1 /* level */, 0 /* max_timestamp */, keys[first].key(), keys[last].key());
+            return sst_bounds{sst, first, last};
+        };
+        for (int i = 0; i < 64; ++i) {
+            ssts.push_back(make_sst());
+            set->insert(ssts.back().sst);
+        }
+
+        auto expected = [&] (size_t first, size_t last) {
+            return ssts | std::views::filter([&] (const sst_bounds& b) {
+                return b.first <= last && b.last >= first;
+            }) | std::views::transform(&sst_bounds::sst) | std::ranges::to<std::unordered_set<shared_sstable>>();
+        };
+        auto check = [&] (const sstable_set& set) {
+            for (size_t first = 0; first < keys.size(); ++first) {
+                for (size_t last = first; last < std::min(first + 3, keys.size()); ++last) {
+                    auto range = dht::partition_range::make(dht::ring_position(keys[first]), dht::ring_position(keys[last]));
+                    auto selected = set.select(range) | std::ranges::to<std::unordered_set<shared_sstable>>();
+                    BOOST_REQUIRE(selected == expected(first, last));
+                }
+            }
+            auto selector = set.make_incremental_selector();
+            for (size_t k = 0; k < keys.size(); ++k) {
+                auto selected = selector.select(keys[k]).sstables | std::ranges::to<std::unordered_set<shared_sstable>>();
+                BOOST_REQUIRE(selected == expected(k, k));
+            }
+            // Walking the positions returned by the selector visits every sstable.
+            std::unordered_set<shared_sstable> visited;
+            dht::ring_position_view pos = dht::ring_position_view::min();
+            do {
+                auto ret = selector.select(pos);
+                pos = ret.next_position;
+                visited.insert(ret.sstables.begin(), ret.sstables.end());
+            } while (!pos.is_max());
+            BOOST_REQUIRE_EQUAL(visited.size(), ssts.size());
+        };
+
+        check(*set);
+
+        // A copy shares the index until it is modified, and modifying it
+        // doesn't affect the original.
+        auto copy = make_lw_shared<sstable_set>(*set);
+        check(*copy);
+        auto original = ssts;
+        for (int i = 0; i < 16; ++i) {
+            copy->erase(ssts.back().sst);
+            ssts.pop_back();
+        }
+        check(*copy);
+        // Updates which don't trigger a rebuild are merged with the index.
+        for (int i = 0; i < 8; ++i) {
+            copy->erase(ssts[i].sst);
+            ssts[i] = make_sst();
+            copy->insert(ssts[i].sst);
+            check(*copy);
+        }
+        ssts = std::move(original);
+        check(*set);
+    });
+}
@@ -1551,6 +1551,191 @@ SEASTAR_THREAD_TEST_CASE(test_load_balancing_with_empty_node) {
   }).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_tablet_load_weights) {
+    auto table1 = table_id(next_uuid());
+    auto table2 = table_id(next_uuid());
+    auto table3 = table_id(next_uuid());
+
+    tablet_metadata tmeta;
+    tmeta.set_tablet_map(table1, tablet_map(2));
+    tmeta.set_tablet_map(table2, tablet_map(8));
+    tmeta.set_tablet_map(table3, tablet_map(4));
+
+    locator::load_stats stats;
+    stats.activity[table1] = table_activity_stats{.reads_per_second = 100};
+    stats.activity[table2] = table_activity_stats{.reads_per_second = 8};
+
+    // Without stats, all tablets weigh the same.
+    for (auto&& [table, weight] : get_tablet_load_weights(tmeta, locator::load_stats{})) {
+        BOOST_REQUIRE_EQUAL(weight, 1);
+    }
+
+    auto weights = get_tablet_load_weights(tmeta, stats);
+    BOOST_REQUIRE_GT(weights[table1], 1);
+    BOOST_REQUIRE_LT(weights[table2], 1);
+    BOOST_REQUIRE_GT(weights[table2], 0);
+    BOOST_REQUIRE_EQUAL(weights[table3], 1);
+
+    // An average tablet weighs 1.
+    auto avg_weight = (weights[table1] * 2 + weights[table2] * 8) / 10;
+    BOOST_REQUIRE_CLOSE(avg_weight, 1.0, 0.001);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_load_balancing_with_skewed_table_load) {
+  do_with_cql_env_thread([] (auto& e) {
+    // Tests that tablets of a hot table are weighted more than tablets of a cold table,
+    // so nodes with equal tablet count but unequal load get rebalanced.
+
+    inet_address ip1("192.168.0.1");
+    inet_address ip2("192.168.0.2");
+
+    auto host1 = host_id(next_uuid());
+    auto host2 = host_id(next_uuid());
+
+    auto table1 = table_id(next_uuid());
+    auto table2 = table_id(next_uuid());
+
+    semaphore sem(1);
+    shared_token_metadata stm([&sem] () noexcept { return get_units(sem, 1); }, locator::token_metadata::config{
+        locator::topology::config{
+            .this_endpoint = ip1,
+            .this_host_id = host1,
+            .local_dc_rack = locator::endpoint_dc_rack::default_location
+        }
+    });
+
+    stm.mutate_token_metadata([&] (token_metadata& tm) -> future<> {
+        tm.update_host_id(host1, ip1);
+        tm.update_host_id(host2, ip2);
+        tm.update_topology(host1, locator::endpoint_dc_rack::default_location, node::state::normal, 1);
+        tm.update_topology(host2, locator::endpoint_dc_rack::default_location, node::state::normal, 1);
+        co_await tm.update_normal_tokens(std::unordered_set{token(tests::d2t(1. / 2))}, host1);
+        co_await tm.update_normal_tokens(std::unordered_set{token(tests::d2t(2. / 2))}, host2);
+
+        // The hot table has both its tablets on host1.
+        tablet_map tmap1(2);
+        for (auto tid : tmap1.tablet_ids()) {
+            tmap1.set_tablet(tid, tablet_info {
+                    tablet_replica_set { tablet_replica {host1, 0} }
+            });
+        }
+
+        // The cold table has 3 tablets on host1 and 5 on host2, so tablet count is equal on both nodes.
+        tablet_map tmap2(8);
+        for (auto tid : tmap2.tablet_ids()) {
+            tmap2.set_tablet(tid, tablet_info {
+                    tablet_replica_set { tablet_replica {tid.value() < 3 ? host1 : host2, 0} }
+            });
+        }
+
+        tablet_metadata tmeta;
+        tmeta.set_tablet_map(table1, std::move(tmap1));
+        tmeta.set_tablet_map(table2, std::move(tmap2));
+        tm.set_tablets(std::move(tmeta));
+        co_return;
+    }).get();
+
+    // Count-based balancing sees no imbalance.
+    rebalance_tablets(e.get_tablet_allocator().local(), stm);
+    {
+        load_sketch load(stm.get());
+        load.populate().get();
+        BOOST_REQUIRE_EQUAL(load.get_load(host1), 5);
+        BOOST_REQUIRE_EQUAL(load.get_load(host2), 5);
+    }
+
+    locator::load_stats stats;
+    stats.activity[table1] = table_activity_stats{.reads_per_second = 100};
+    stats.activity[table2] = table_activity_stats{.reads_per_second = 8};
+    rebalance_tablets(e.get_tablet_allocator().local(), stm, make_lw_shared<const locator::load_stats>(std::move(stats)));
+
+    {
+        load_sketch load(stm.get());
+        load.populate().get();
+        BOOST_REQUIRE_LT(load.get_load(host1), load.get_load(host2));
+
+        // Hot tablets are not moved, as moving them would invert the load.
+        load_sketch hot_load(stm.get());
+        hot_load.populate(std::nullopt, table1).get();
+        BOOST_REQUIRE_EQUAL(hot_load.get_load(host1), 2);
+    }
+  }).get();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_load_balancing_skips_heavy_tablet) {
+  do_with_cql_env_thread([] (auto& e) {
+    // Tests that a tablet which is too heavy to move without inverting the load
+    // is skipped, and lighter tablets of the same node are moved instead.
+
+    inet_address ip1("192.168.0.1");
+    inet_address ip2("192.168.0.2");
+
+    auto host1 = host_id(next_uuid());
+    auto host2 = host_id(next_uuid());
+
+    auto table1 = table_id(next_uuid());
+    auto table2 = table_id(next_uuid());
+
+    semaphore sem(1);
+    shared_token_metadata stm([&sem] () noexcept { return get_units(sem, 1); }, locator::token_metadata::config{
+        locator::topology::config{
+            .this_endpoint = ip1,
+            .this_host_id = host1,
+            .local_dc_rack = locator::endpoint_dc_rack::default_location
+        }
+    });
+
+    stm.mutate_token_metadata([&] (token_metadata& tm) -> future<> {
+        tm.update_host_id(host1, ip1);
+        tm.update_host_id(host2, ip2);
+        tm.update_topology(host1, locator::endpoint_dc_rack::default_location, node::state::normal, 1);
+        tm.update_topology(host2, locator::endpoint_dc_rack::default_location, node::state::normal, 1);
+        co_await tm.update_normal_tokens(std::unordered_set{token(tests::d2t(1. / 2))}, host1);
+        co_await tm.update_normal_tokens(std::unordered_set{token(tests::d2t(2. / 2))}, host2);
+
+        // The heavy tablet is on host1.
+        tablet_map tmap1(1);
+        for (auto tid : tmap1.tablet_ids()) {
+            tmap1.set_tablet(tid, tablet_info {
+                    tablet_replica_set { tablet_replica {host1, 0} }
+            });
+        }
+
+        // Light tablets, 2 on each node.
+        tablet_map tmap2(4);
+        for (auto tid : tmap2.tablet_ids()) {
+            tmap2.set_tablet(tid, tablet_info {
+                    tablet_replica_set { tablet_replica {tid.value() < 2 ? host1 : host2, 0} }
+            });
+        }
+
+        tablet_metadata tmeta;
+        tmeta.set_tablet_map(table1, std::move(tmap1));
+        tmeta.set_tablet_map(table2, std::move(tmap2));
+        tm.set_tablets(std::move(tmeta));
+        co_return;
+    }).get();
+
+    // The heavy tablet weighs 2, light tablets weigh 0.75. Moving the heavy tablet
+    // would leave host1 with 1.5 and host2 with 3.5.
+    locator::load_stats stats;
+    stats.activity[table1] = table_activity_stats{.reads_per_second = 100};
+    stats.activity[table2] = table_activity_stats{.reads_per_second = 0};
+    rebalance_tablets(e.get_tablet_allocator().local(), stm, make_lw_shared<const locator::load_stats>(std::move(stats)));
+
+    {
+        load_sketch load(stm.get());
+        load.populate().get();
+        BOOST_REQUIRE_EQUAL(load.get_load(host1), 2);
+        BOOST_REQUIRE_EQUAL(load.get_load(host2), 3);
+
+        load_sketch heavy_load(stm.get());
+        heavy_load.populate(std::nullopt, table1).get();
+        BOOST_REQUIRE_EQUAL(heavy_load.get_load(host1), 1);
+    }
+  }).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_load_balancing_with_skiplist) {
   do_with_cql_env_thread([] (auto& e) {
     // Tests the scenario of balacning cluster with DOWN node
@@ -12,6 +12,8 @@
 #include "tracing/trace_state.hh"
 
 #include "test/lib/cql_test_env.hh"
+#include "test/lib/cql_assertions.hh"
+#include "test/lib/eventually.hh"
 
 future<> do_with_tracing_env(std::function<future<>(cql_test_env&)> func, cql_test_config cfg_in = {}) {
     return do_with_cql_env_thread([func](auto &env) {
@@ -80,3 +82,79 @@ SEASTAR_TEST_CASE(tracing_slow_query_fast_mode) {
         return make_ready_future<>();
     });
 }
+
+SEASTAR_TEST_CASE(tracing_slow_query_keeps_bounded_events) {
+    return do_with_tracing_env([](auto &e) {
+        tracing::tracing &t = tracing::tracing::get_local_tracing_instance();
+
+        t.set_ignore_trace_events(false);
+        t.set_slow_query_threshold(std::chrono::seconds(3600));
+
+        const size_t nr_events = 3 * tracing::tracing::max_tail_events_per_session;
+
+        // A session that is only traced for slow query logging keeps at most
+        // max_tail_events_per_session latest events while it's fast
+        tracing::trace_state_props_set slow_props;
+        slow_props.set(tracing::trace_state_props::log_slow_query);
+
+        auto overwritten_before = t.stats.overwritten_records;
+        tracing::trace_state_ptr slow_state = t.create_session(tracing::trace_type::QUERY, slow_props);
+        tracing::begin(slow_state, "begin", gms::inet_address());
+        for (size_t i = 0; i < nr_events; ++i) {
+            tracing::trace(slow_state, "trace {}", i);
+        }
+        BOOST_CHECK_EQUAL(slow_state->events_size(), tracing::tracing::max_tail_events_per_session);
+        BOOST_CHECK_EQUAL(t.stats.overwritten_records - overwritten_before, nr_events - tracing::tracing::max_tail_events_per_session);
+
+        // Fully traced sessions are not limited
+        tracing::trace_state_props_set full_props;
+        full_props.set(tracing::trace_state_props::log_slow_query);
+        full_props.set(tracing::trace_state_props::full_tracing);
+
+        tracing::trace_state_ptr full_state = t.create_session(tracing::trace_type::QUERY, full_props);
+        tracing::begin(full_state, "begin", gms::inet_address());
+        for (size_t i = 0; i < nr_events; ++i) {
+            tracing::trace(full_state, "trace {}", i);
+        }
+        BOOST_CHECK_EQUAL(full_state->events_size(), nr_events);
+
+        t.set_slow_query_threshold(tracing::tracing::default_slow_query_duraion_threshold);
+        return make_ready_future<>();
+    });
+}
+
+SEASTAR_TEST_CASE(tracing_write_many_sessions) {
+    return do_with_tracing_env([](auto &e) {
+        tracing::tracing &t = tracing::tracing::get_local_tracing_instance();
+
+        t.set_ignore_trace_events(false);
+
+        tracing::trace_state_props_set trace_props;
+        trace_props.set(tracing::trace_state_props::full_tracing);
+
+        // Enough events to have them split between several batches
+        const size_t nr_sessions = 20;
+        const size_t nr_events = 7;
+        std::vector<utils::UUID> session_ids;
+        for (size_t i = 0; i < nr_sessions; ++i) {
+            tracing::trace_state_ptr trace_state = t.create_session(tracing::trace_type::QUERY, trace_props);
+            tracing::begin(trace_state, "begin", gms::inet_address());
+            for (size_t j = 0; j < nr_events; ++j) {
+                tracing::trace(trace_state, "trace {}", j);
+            }
+            session_ids.push_back(trace_state->session_id());
+        }
+        t.write_pending_records();
+
+        for (auto& id : session_ids) {
+            eventually([&] {
+                assert_that(e.execute_cql(seastar::format("SELECT session_id FROM system_traces.sessions WHERE session_id = {}", id)).get())
+                    .is_rows().with_size(1);
+                assert_that(e.execute_cql(seastar::format("SELECT event_id FROM system_traces.events WHERE session_id = {}", id)).get())
+                    .is_rows().with_size(nr_events);
+            });
+        }
+
+        return make_ready_future<>();
+    });
+}
@@ -10,7 +10,9 @@
 
 import re
 import pytest
+from cassandra import ConsistencyLevel
 from cassandra.protocol import InvalidRequest
+from cassandra.query import BatchStatement
 
 from .util import new_test_table, unique_key_int
 
@@ -102,3 +104,27 @@ def test_lwt_with_batch_conflict_2(cql, table1):
     # Scylla returns a separate row for each of the two conditions.
     for r in rs:
         assert r.applied == False
+
+# Prepared LWT statements are routed by the CQL server to the shard owning
+# their partition before they are executed. Check that conditional updates,
+# conditional batches and SERIAL reads of many partitions (so on many
+# shards) give the right results, and that an invalid key still produces
+# the usual error rather than being routed somewhere.
+def test_lwt_prepared_on_many_partitions(cql, table1):
+    insert = cql.prepare(f'INSERT INTO {table1}(p, c, r) VALUES (?, ?, ?) IF NOT EXISTS')
+    update = cql.prepare(f'UPDATE {table1} SET r=? WHERE p=? AND c=? IF r=?')
+    select = cql.prepare(f'SELECT r FROM {table1} WHERE p=? AND c=?')
+    select.consistency_level = ConsistencyLevel.SERIAL
+    keys = [unique_key_int() for _ in range(32)]
+    for p in keys:
+        assert list(cql.execute(insert, [p, 1, 1]))[0].applied == True
+        assert list(cql.execute(insert, [p, 1, 2]))[0].applied == False
+        assert list(cql.execute(update, [2, p, 1, 1]))[0].applied == True
+        batch = BatchStatement()
+        batch.add(update, [3, p, 1, 2])
+        batch.add(insert, [p, 2, 3])
+        assert all(r.applied for r in cql.execute(batch))
+        assert list(cql.execute(select, [p, 1])) == [(3,)]
+        assert list(cql.execute(select, [p, 2])) == [(3,)]
+    with pytest.raises(InvalidRequest, match='null'):
+        cql.execute(insert, [None, 1, 1])
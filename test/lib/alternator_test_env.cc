@@ -36,6 +36,7 @@ future<> alternator_test_env::start(std::string_view isolation_level) {
             std::ref(_sdks),
             std::ref(_cdc_metadata),
             // end-of-streams-parameters
+            std::ref(_expiration_service),
             ssg,
             get_timeout_in_ms);
     try {
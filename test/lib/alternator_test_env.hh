@@ -15,6 +15,7 @@
 #include "utils/rjson.hh"
 #include "db/system_distributed_keyspace.hh"
 #include "cdc/metadata.hh"
+#include "alternator/ttl.hh"
 
 namespace service {
 class storage_proxy;
@@ -48,6 +49,8 @@ class alternator_test_env {
     sharded<db::system_distributed_keyspace> _sdks;
     // Dummy service, only needed for alternator streams
     sharded<cdc::metadata> _cdc_metadata;
+    // Dummy service, only needed for alternator TTL
+    sharded<alternator::expiration_service> _expiration_service;
 
     sharded<alternator::executor> _executor;
 public:
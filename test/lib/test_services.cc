@@ -17,6 +17,7 @@
 #include "gms/feature_service.hh"
 #include "repair/row_level.hh"
 #include "replica/compaction_group.hh"
+#include "sstables/open_info.hh"
 #include "utils/assert.hh"
 #include "utils/overloaded_functor.hh"
 #include <boost/program_options.hpp>
@@ -90,6 +91,9 @@ class table_for_tests::table_state : public compaction::table_state {
     sstables::shared_sstable make_sstable() const override {
         return table().make_sstable();
     }
+    future<sstables::shared_sstable> load_foreign_sstable(sstables::foreign_sstable_open_info info) const override {
+        return table().load_foreign_sstable(std::move(info));
+    }
     sstables::sstable_writer_config configure_writer(sstring origin) const override {
         return _sstables_manager.configure_writer(std::move(origin));
     }
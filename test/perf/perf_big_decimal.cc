@@ -7,6 +7,7 @@
  */
 
 #include <seastar/testing/perf_tests.hh>
+#include <seastar/testing/random.hh>
 #include <seastar/testing/test_runner.hh>
 
 #include <random>
@@ -36,3 +37,101 @@ PERF_TEST_F(big_decimal_test, from_string) {
     perf_tests::do_not_optimize(big_decimal{neg_data_fraction_neg_exponent});
 }
 
+
+// Arithmetic on decimals and varints, like the sum() and avg() aggregates
+// and Alternator number handling do. The "small" fixtures fit in 128 bits
+// and stay on the inline fast path, the "large" ones force cpp_int.
+class big_decimal_arithmetic {
+public:
+    static constexpr size_t count = 1000;
+private:
+    std::vector<big_decimal> _small;
+    std::vector<big_decimal> _small_mixed_scale;
+    std::vector<big_decimal> _large;
+    std::vector<utils::multiprecision_int> _varints;
+public:
+    big_decimal_arithmetic() {
+        auto eng = seastar::testing::local_random_engine;
+        auto value_dist = std::uniform_int_distribution<int64_t>{};
+        auto scale_dist = std::uniform_int_distribution<int32_t>{0, 8};
+        for (size_t i = 0; i < count; ++i) {
+            _small.emplace_back(2, boost::multiprecision::cpp_int(value_dist(eng)));
+            _small_mixed_scale.emplace_back(scale_dist(eng), boost::multiprecision::cpp_int(value_dist(eng)));
+            _large.emplace_back(big_decimal{make_random_numeric_string(60) + "." + make_random_numeric_string(10)});
+            _varints.emplace_back(value_dist(eng));
+        }
+    }
+
+    const std::vector<big_decimal>& small() const { return _small; }
+    const std::vector<big_decimal>& small_mixed_scale() const { return _small_mixed_scale; }
+    const std::vector<big_decimal>& large() const { return _large; }
+    const std::vector<utils::multiprecision_int>& varints() const { return _varints; }
+};
+
+PERF_TEST_F(big_decimal_arithmetic, from_string_small) {
+    perf_tests::do_not_optimize(big_decimal{"1234567.891"});
+    perf_tests::do_not_optimize(big_decimal{"-0.000001234"});
+    perf_tests::do_not_optimize(big_decimal{"98765432109876543210"});
+    perf_tests::do_not_optimize(big_decimal{"1.5E-7"});
+    return 4;
+}
+
+PERF_TEST_F(big_decimal_arithmetic, sum_small) {
+    big_decimal sum;
+    for (const auto& v : small()) {
+        sum += v;
+    }
+    perf_tests::do_not_optimize(sum);
+    return count;
+}
+
+PERF_TEST_F(big_decimal_arithmetic, sum_small_mixed_scale) {
+    big_decimal sum;
+    for (const auto& v : small_mixed_scale()) {
+        sum += v;
+    }
+    perf_tests::do_not_optimize(sum);
+    return count;
+}
+
+PERF_TEST_F(big_decimal_arithmetic, sum_large) {
+    big_decimal sum;
+    for (const auto& v : large()) {
+        sum += v;
+    }
+    perf_tests::do_not_optimize(sum);
+    return count;
+}
+
+PERF_TEST_F(big_decimal_arithmetic, avg_small) {
+    big_decimal sum;
+    for (const auto& v : small()) {
+        sum += v;
+    }
+    perf_tests::do_not_optimize(sum.div(count, big_decimal::rounding_mode::HALF_EVEN));
+    return count;
+}
+
+PERF_TEST_F(big_decimal_arithmetic, compare_small_mixed_scale) {
+    const auto& values = small_mixed_scale();
+    for (size_t i = 1; i < values.size(); ++i) {
+        perf_tests::do_not_optimize(values[i - 1] <=> values[i]);
+    }
+    return count - 1;
+}
+
+PERF_TEST_F(big_decimal_arithmetic, to_string_small) {
+    for (const auto& v : small_mixed_scale()) {
+        perf_tests::do_not_optimize(v.to_string());
+    }
+    return count;
+}
+
+PERF_TEST_F(big_decimal_arithmetic, sum_varint) {
+    utils::multiprecision_int sum(0);
+    for (const auto& v : varints()) {
+        sum += v;
+    }
+    perf_tests::do_not_optimize(sum);
+    return count;
+}
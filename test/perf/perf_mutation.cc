@@ -9,6 +9,7 @@
 
 #include "replica/database.hh"
 #include "schema/schema_builder.hh"
+#include "mutation/frozen_mutation.hh"
 #include "test/perf/perf.hh"
 #include <seastar/core/app-template.hh>
 #include <seastar/core/reactor.hh>
@@ -21,7 +22,8 @@ int main(int argc, char* argv[]) {
     namespace bpo = boost::program_options;
     app_template app;
     app.add_options()
-        ("column-count", bpo::value<size_t>()->default_value(1), "column count");
+        ("column-count", bpo::value<size_t>()->default_value(1), "column count")
+        ("partitions", bpo::value<size_t>()->default_value(100000), "number of distinct single-row partitions inserted into a memtable before it is replaced with a fresh one");
     return app.run_deprecated(argc, argv, [&] {
         size_t column_count = app.configuration()["column-count"].as<size_t>();
         auto builder = schema_builder("ks", "cf")
@@ -49,6 +51,31 @@ int main(int argc, char* argv[]) {
             m.set_clustered_cell(c_key, col, make_atomic_cell(col.type, value));
             mt.apply(std::move(m));
         });
+
+        std::cout << "Timing insertion of single-row partitions as frozen mutations...\n";
+
+        size_t partition_count = app.configuration()["partitions"].as<size_t>();
+        std::vector<frozen_mutation> partitions;
+        partitions.reserve(partition_count);
+        for (size_t i = 0; i < partition_count; i++) {
+            mutation m(s, partition_key::from_exploded(*s, {to_bytes(fmt::format("key{}", i))}));
+            const column_definition& col = *s->get_column_definition(to_bytes(cnames[i % column_count]));
+            m.set_clustered_cell(c_key, col, make_atomic_cell(col.type, value));
+            partitions.push_back(freeze(m));
+        }
+
+        // Every partition is inserted once into each memtable. Once all of
+        // them are in, the memtable is replaced with an empty one, so the
+        // cost of destroying it is included in the result.
+        auto insert_mt = make_lw_shared<replica::memtable>(s);
+        size_t next = 0;
+        time_it([&] {
+            if (next == partitions.size()) {
+                insert_mt = make_lw_shared<replica::memtable>(s);
+                next = 0;
+            }
+            insert_mt->apply(partitions[next++], s);
+        });
         engine().exit(0);
     });
 }
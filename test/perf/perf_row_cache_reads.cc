@@ -46,6 +46,10 @@
 /// The second row which starts with "read:" has high max latency (106 ms),
 /// which is an indication of the following bug: https://github.com/scylladb/scylla/issues/8153
 ///
+/// To compare the effect of huge page backed LSA memory, run once with
+/// --hugepages=/path/to/hugetlbfs and once without, and compare read times.
+/// The "huge pages" figure is the number of 2M pages holding cache segments.
+///
 
 static const int cell_size = 128;
 static bool cancelled = false;
@@ -118,11 +122,13 @@ void test_scans_with_dummy_entries() {
         });
         slm.stop();
 
-        fmt::print(std::cout, "read: {:.6f} [ms], preemption: {}, cache: {:d}/{:d} [MB]\n",
+        fmt::print(std::cout, "read: {:.6f} [ms], preemption: {}, cache: {:d}/{:d} [MB], huge pages: {:d} ({:.2f}% occupied)\n",
                    d.count() * 1000,
                    slm,
                    tracker.region().occupancy().used_space() / MB,
-                   tracker.region().occupancy().total_space() / MB);
+                   tracker.region().occupancy().total_space() / MB,
+                   logalloc::shard_tracker().huge_page_occupancy().total_space() / (2 * MB),
+                   logalloc::shard_tracker().huge_page_occupancy().used_fraction() * 100);
     };
 
     // The first scan populates the cache with continuity
@@ -200,11 +206,13 @@ void test_scan_with_range_delete_over_rows() {
 
         slm.stop();
 
-        fmt::print(std::cout, "read: {:.6f} [ms], preemption: {}, cache: {:d}/{:d} [MB]\n",
+        fmt::print(std::cout, "read: {:.6f} [ms], preemption: {}, cache: {:d}/{:d} [MB], huge pages: {:d} ({:.2f}% occupied)\n",
                    d.count() * 1000,
                    slm,
                    tracker.region().occupancy().used_space() / MB,
-                   tracker.region().occupancy().total_space() / MB);
+                   tracker.region().occupancy().total_space() / MB,
+                   logalloc::shard_tracker().huge_page_occupancy().total_space() / (2 * MB),
+                   logalloc::shard_tracker().huge_page_occupancy().used_fraction() * 100);
     };
 
     // The first scan populates the cache with continuity
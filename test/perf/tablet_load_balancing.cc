@@ -170,6 +170,8 @@ struct params {
     int shards;
     int scale1 = 1;
     int scale2 = 1;
+    // Request rate of a tablet of the first table relative to a tablet of the second table.
+    double skew = 1;
 };
 
 struct table_balance {
@@ -182,6 +184,8 @@ constexpr auto nr_tables = 2;
 
 struct cluster_balance {
     table_balance tables[nr_tables];
+    // Max shard load over average shard load, where load is the sum of tablet weights.
+    double load_overcommit = 0;
 };
 
 struct results {
@@ -204,7 +208,7 @@ template<>
 struct fmt::formatter<cluster_balance> : fmt::formatter<string_view> {
     template <typename FormatContext>
     auto format(const cluster_balance& r, FormatContext& ctx) const {
-        return fmt::format_to(ctx.out(), "{{table1={}, table2={}}}", r.tables[0], r.tables[1]);
+        return fmt::format_to(ctx.out(), "{{table1={}, table2={}, load={:.2f}}}", r.tables[0], r.tables[1], r.load_overcommit);
     }
 };
 
@@ -214,11 +218,11 @@ struct fmt::formatter<params> : fmt::formatter<string_view> {
     auto format(const params& p, FormatContext& ctx) const {
         auto tablets1_per_shard = double(p.tablets1.value_or(0)) * p.rf1 / (p.nodes * p.shards);
         auto tablets2_per_shard = double(p.tablets2.value_or(0)) * p.rf2 / (p.nodes * p.shards);
-        return fmt::format_to(ctx.out(), "{{iterations={}, nodes={}, tablets1={} ({:0.1f}/sh), tablets2={} ({:0.1f}/sh), rf1={}, rf2={}, shards={}}}",
+        return fmt::format_to(ctx.out(), "{{iterations={}, nodes={}, tablets1={} ({:0.1f}/sh), tablets2={} ({:0.1f}/sh), rf1={}, rf2={}, shards={}, skew={}}}",
                          p.iterations, p.nodes,
                          p.tablets1.value_or(0), tablets1_per_shard,
                          p.tablets2.value_or(0), tablets2_per_shard,
-                         p.rf1, p.rf2, p.shards);
+                         p.rf1, p.rf2, p.shards, p.skew);
     }
 };
 
@@ -252,6 +256,8 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
             add_host();
         }
 
+        locator::load_stats_ptr load_stats;
+
         semaphore sem(1);
         auto stm = shared_token_metadata([&sem]() noexcept { return get_units(sem, 1); }, locator::token_metadata::config {
                 locator::topology::config {
@@ -266,7 +272,7 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
                 add_host();
                 return add_host_to_topology(tm, hosts.size() - 1);
             }).get();
-            global_res.stats += rebalance_tablets(e.get_tablet_allocator().local(), stm);
+            global_res.stats += rebalance_tablets(e.get_tablet_allocator().local(), stm, load_stats);
         };
 
         auto decommission = [&] (host_id host) {
@@ -279,7 +285,7 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
                 return make_ready_future<>();
             }).get();
 
-            global_res.stats += rebalance_tablets(e.get_tablet_allocator().local(), stm);
+            global_res.stats += rebalance_tablets(e.get_tablet_allocator().local(), stm, load_stats);
 
             stm.mutate_token_metadata([&] (token_metadata& tm) {
                 tm.remove_endpoint(host);
@@ -313,6 +319,15 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
         allocate(s1, p.rf1, p.tablets1);
         allocate(s2, p.rf2, p.tablets2);
 
+        if (p.skew != 1) {
+            // Per-replica request rates, as reported by the topology coordinator.
+            // Every tablet of the first table is skew times hotter than a tablet of the second table.
+            locator::load_stats stats;
+            stats.activity[s1->id()] = table_activity_stats{.reads_per_second = p.skew * p.tablets1.value_or(1)};
+            stats.activity[s2->id()] = table_activity_stats{.reads_per_second = double(p.tablets2.value_or(1))};
+            load_stats = make_lw_shared<const locator::load_stats>(std::move(stats));
+        }
+
         auto check_balance = [&] () -> cluster_balance {
             cluster_balance res;
 
@@ -359,11 +374,38 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
                 };
             }
 
+            {
+                auto& tablets = stm.get()->tablets();
+                auto weights = get_tablet_load_weights(tablets, load_stats ? *load_stats : locator::load_stats{});
+                std::unordered_map<host_id, std::vector<double>> shard_load;
+                double total_load = 0;
+                for (auto h : hosts) {
+                    shard_load[h].resize(shard_count);
+                }
+                for (auto s : {s1, s2}) {
+                    auto weight = weights.at(s->id());
+                    for (auto&& ti : tablets.get_tablet_map(s->id()).tablets()) {
+                        for (auto&& r : ti.replicas) {
+                            shard_load[r.host][r.shard] += weight;
+                            total_load += weight;
+                        }
+                    }
+                }
+                double max_load = 0;
+                for (auto&& [h, loads] : shard_load) {
+                    max_load = std::max(max_load, std::ranges::max(loads));
+                }
+                auto avg_load = total_load / (hosts.size() * shard_count);
+                res.load_overcommit = max_load / avg_load;
+                testlog.info("Weighted shard load: max={:.2f}, avg={:.2f}, overcommit={:.2f}", max_load, avg_load, res.load_overcommit);
+            }
+
             for (int i = 0; i < nr_tables; i++) {
                 auto t = res.tables[i];
                 global_res.worst.tables[i].shard_overcommit = std::max(global_res.worst.tables[i].shard_overcommit, t.shard_overcommit);
                 global_res.worst.tables[i].node_overcommit = std::max(global_res.worst.tables[i].node_overcommit, t.node_overcommit);
             }
+            global_res.worst.load_overcommit = std::max(global_res.worst.load_overcommit, res.load_overcommit);
 
             testlog.info("Overcommit: {}", res);
             return res;
@@ -375,7 +417,7 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
 
         check_balance();
 
-        rebalance_tablets(e.get_tablet_allocator().local(), stm);
+        rebalance_tablets(e.get_tablet_allocator().local(), stm, load_stats);
 
         global_res.init = global_res.worst = check_balance();
 
@@ -415,6 +457,10 @@ future<> run_simulation(const params& p, const sstring& name = "") {
     testlog.info("[run {}] Overcommit       : time : {:.3f} [s], max={:.3f} [s], count={}", name,
                  old_res.stats.elapsed_time.count(), old_res.stats.max_rebalance_time.count(), old_res.stats.rebalance_count);
 
+    if (p.skew != 1 && res.worst.load_overcommit > 1.2) {
+        testlog.warn("[run {}] weighted shard overcommit {:.2f} > 1.2!", name, res.worst.load_overcommit);
+    }
+
     for (int i = 0; i < nr_tables; ++i) {
         if (res.worst.tables[i].shard_overcommit > old_res.worst.tables[i].shard_overcommit) {
             testlog.warn("[run {}] table{} shard overcommit worse!", name, i + 1);
@@ -444,6 +490,7 @@ future<> run_simulations(const boost::program_options::variables_map& app_cfg) {
             .shards = shards,
             .scale1 = scale1,
             .scale2 = scale2,
+            .skew = app_cfg["skew"].as<double>(),
         };
 
         auto name = format("#{}", i);
@@ -465,6 +512,7 @@ int scylla_tablet_load_balancing_main(int argc, char** argv) {
             ("rf1", bpo::value<int>(), "Replication factor for the first table.")
             ("rf2", bpo::value<int>(), "Replication factor for the second table.")
             ("shards", bpo::value<int>(), "Number of shards per node.")
+            ("skew", bpo::value<double>()->default_value(1), "Request rate of a tablet of the first table relative to a tablet of the second table.")
             ("verbose", "Enables standard logging")
             ;
     return app.run(argc, argv, [&] {
@@ -491,6 +539,7 @@ int scylla_tablet_load_balancing_main(int argc, char** argv) {
                         .rf1 = app.configuration()["rf1"].as<int>(),
                         .rf2 = app.configuration()["rf2"].as<int>(),
                         .shards = app.configuration()["shards"].as<int>(),
+                        .skew = app.configuration()["skew"].as<double>(),
                     };
                     run_simulation(p).get();
                 }
@@ -0,0 +1,40 @@
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+import pytest
+import redis
+import logging
+from util import random_string, connect
+
+logger = logging.getLogger('redis-test')
+
+def test_push_lrange(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    assert r.rpush(key, 'b', 'c') == 2
+    assert r.lpush(key, 'a') == 3
+    assert r.rpush(key, 'd') == 4
+    assert r.llen(key) == 4
+    assert r.lrange(key, 0, -1) == ['a', 'b', 'c', 'd']
+    assert r.lrange(key, 1, 2) == ['b', 'c']
+    assert r.lrange(key, -2, 100) == ['c', 'd']
+    assert r.lrange(key, 3, 1) == []
+    assert r.delete(key) == 1
+    assert r.lrange(key, 0, -1) == []
+
+def test_lpush_order(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    # Each element is pushed to the head in turn.
+    assert r.lpush(key, 'a', 'b', 'c') == 3
+    assert r.lrange(key, 0, -1) == ['c', 'b', 'a']
+    r.delete(key)
+
+def test_lrange_wrong_arguments(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    with pytest.raises(redis.exceptions.ResponseError) as excinfo:
+        r.execute_command("LRANGE", random_string(10), "x", "1")
+    assert "invalid argument for 'lrange' command" in str(excinfo.value)
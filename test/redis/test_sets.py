@@ -0,0 +1,24 @@
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+import pytest
+import redis
+import logging
+from util import random_string, connect
+
+logger = logging.getLogger('redis-test')
+
+def test_sadd_smembers_srem(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    assert r.sadd(key, 'a', 'b') == 2
+    assert r.sadd(key, 'b', 'c', 'c') == 1
+    assert r.smembers(key) == {'a', 'b', 'c'}
+    assert r.sismember(key, 'a')
+    assert not r.sismember(key, 'd')
+    assert r.srem(key, 'a', 'd') == 1
+    assert r.smembers(key) == {'b', 'c'}
+    assert r.delete(key) == 1
+    assert r.smembers(key) == set()
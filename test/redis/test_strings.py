@@ -231,3 +231,37 @@ def test_strlen_wrongtype(redis_host, redis_port):
         r.strlen(key1)
     except redis.exceptions.ResponseError as ex:
         assert str(ex) == 'WRONGTYPE Operation against a key holding the wrong kind of value'
+
+def test_mset_mget(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key1 = random_string(10)
+    key2 = random_string(10)
+    key3 = random_string(10)
+    val1 = random_string(10)
+    val2 = random_string(10)
+
+    r.delete(key3)
+    assert r.mset({key1: val1, key2: val2}) == True
+    assert r.mget(key1, key3, key2, key1) == [val1, None, val2, val1]
+
+    with pytest.raises(redis.exceptions.ResponseError) as excinfo:
+        r.execute_command("MSET", key1)
+    assert "wrong number of arguments for 'mset' command" in str(excinfo.value)
+
+def test_pipeline(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+    val1 = random_string(10)
+    val2 = random_string(10)
+
+    # Replies come back in order, and each command sees the effect of the
+    # ones sent before it, even though they are not waited for.
+    p = r.pipeline(transaction=False)
+    p.set(key, val1)
+    p.get(key)
+    p.get(key)
+    p.set(key, val2)
+    p.get(key)
+    p.delete(key)
+    p.get(key)
+    assert p.execute() == [True, val1, val1, True, val2, 1, None]
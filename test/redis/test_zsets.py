@@ -0,0 +1,56 @@
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+import pytest
+import redis
+import logging
+from util import random_string, connect
+
+logger = logging.getLogger('redis-test')
+
+def test_zadd_zrangebyscore(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    assert r.zadd(key, {'a': 1, 'b': 2.5, 'c': 3}) == 3
+    assert r.zrangebyscore(key, '-inf', '+inf') == ['a', 'b', 'c']
+    assert r.zrangebyscore(key, 1, 2.5) == ['a', 'b']
+    assert r.zrangebyscore(key, '(1', 3) == ['b', 'c']
+    assert r.zrangebyscore(key, 3, 1) == []
+    assert r.zrangebyscore(key, 2, 3, withscores=True) == [('b', 2.5), ('c', 3.0)]
+
+    # Updating the score of an existing member moves it.
+    assert r.zadd(key, {'a': 4}) == 0
+    assert r.zrangebyscore(key, '-inf', '+inf') == ['b', 'c', 'a']
+    assert r.delete(key) == 1
+    assert r.zrangebyscore(key, '-inf', '+inf') == []
+
+def test_zadd_equal_scores(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    # Members with equal scores coexist, ordered by the member.
+    assert r.zadd(key, {'b': 1, 'a': 1, 'c': -1}) == 3
+    assert r.zrangebyscore(key, '-inf', '+inf') == ['c', 'a', 'b']
+    assert r.zrangebyscore(key, 1, 1) == ['a', 'b']
+    assert r.zrangebyscore(key, '(-1', '+inf') == ['a', 'b']
+    assert r.zrangebyscore(key, '-inf', '(1') == ['c']
+    r.delete(key)
+
+def test_zadd_update_members(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    # A member which is a prefix of another keeps its own score.
+    assert r.zadd(key, {'a': 1, 'ab': 2}) == 2
+    assert r.zadd(key, {'a': 3, 'abc': 0}) == 1
+    assert r.zadd(key, {'ab': 2}) == 0
+    assert r.zrangebyscore(key, '-inf', '+inf', withscores=True) == [('abc', 0.0), ('ab', 2.0), ('a', 3.0)]
+    r.delete(key)
+
+def test_zrangebyscore_wrong_arguments(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    with pytest.raises(redis.exceptions.ResponseError) as excinfo:
+        r.execute_command("ZRANGEBYSCORE", random_string(10), "x", "1")
+    assert "invalid argument for 'zrangebyscore' command" in str(excinfo.value)
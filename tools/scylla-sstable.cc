@@ -945,6 +945,9 @@ class scylla_sstable_table_state : public compaction::table_state {
     virtual reader_permit make_compaction_reader_permit() const override { return _permit; }
     virtual sstables::sstables_manager& get_sstables_manager() noexcept override { return _sst_man; }
     virtual sstables::shared_sstable make_sstable() const override { return do_make_sstable(); }
+    virtual future<sstables::shared_sstable> load_foreign_sstable(sstables::foreign_sstable_open_info info) const override {
+        return make_exception_future<sstables::shared_sstable>(std::runtime_error("loading foreign sstables is not supported"));
+    }
     virtual sstables::sstable_writer_config configure_writer(sstring origin) const override { return do_configure_writer(std::move(origin)); }
     virtual api::timestamp_type min_memtable_timestamp() const override { return api::min_timestamp; }
     virtual api::timestamp_type min_memtable_live_timestamp() const override { return api::min_timestamp; }
@@ -1460,6 +1463,7 @@ const char* to_string(sstables::scylla_metadata_type t) {
         case sstables::scylla_metadata_type::ScyllaBuildId: return "scylla_build_id";
         case sstables::scylla_metadata_type::ExtTimestampStats: return "ext_timestamp_stats";
         case sstables::scylla_metadata_type::SSTableIdentifier: return "sstable_identifier";
+        case sstables::scylla_metadata_type::TombstoneTokenHistogram: return "tombstone_token_histogram";
     }
     std::abort();
 }
@@ -1585,6 +1589,31 @@ class scylla_metadata_visitor : public boost::static_visitor<> {
     void operator()(const sstables::scylla_metadata::sstable_identifier& sid) const {
         _writer.AsString(sid.value);
     }
+
+    void operator()(const sstables::scylla_metadata::tombstone_token_histogram& val) const {
+        _writer.StartArray();
+        for (const auto& b : val.elements) {
+            _writer.StartObject();
+            _writer.Key("first_token");
+            _writer.Int64(b.first_token);
+            _writer.Key("last_token");
+            _writer.Int64(b.last_token);
+            _writer.Key("partitions");
+            _writer.Uint64(b.partitions);
+            _writer.Key("cells");
+            _writer.Uint64(b.cells);
+            _writer.Key("tombstones");
+            _writer.Uint64(b.tombstones);
+            if (b.tombstones) {
+                _writer.Key("min_deletion_time");
+                _writer.Int(b.min_deletion_time);
+                _writer.Key("max_deletion_time");
+                _writer.Int(b.max_deletion_time);
+            }
+            _writer.EndObject();
+        }
+        _writer.EndArray();
+    }
 };
 
 void dump_scylla_metadata_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
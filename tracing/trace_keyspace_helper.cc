@@ -8,9 +8,10 @@
  * SPDX-License-Identifier: (AGPL-3.0-or-later and Apache-2.0)
  */
 #include <seastar/core/metrics.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/coroutine/parallel_for_each.hh>
 #include "types/types.hh"
 #include "tracing/trace_keyspace_helper.hh"
-#include "cql3/statements/batch_statement.hh"
 #include "cql3/statements/modification_statement.hh"
 #include "cql3/query_processor.hh"
 #include "cql3/cql_config.hh"
@@ -20,6 +21,7 @@
 #include "utils/UUID_gen.hh"
 #include "utils/class_registrator.hh"
 #include "service/storage_proxy.hh"
+#include "db/config.hh"
 
 namespace tracing {
 
@@ -37,7 +39,6 @@ static service::client_state& tracing_client_state() {
 
 struct trace_keyspace_backend_sesssion_state final : public backend_session_state_base {
     int64_t last_nanos = 0;
-    semaphore write_sem {1};
     virtual ~trace_keyspace_backend_sesssion_state() {}
 };
 
@@ -219,11 +220,16 @@ gms::inet_address trace_keyspace_helper::my_address() const noexcept {
     return _qp_anchor->proxy().my_address();
 }
 
-void trace_keyspace_helper::write_one_session_records(lw_shared_ptr<one_session_records> records) {
+void trace_keyspace_helper::write_records_bulk(records_bulk& bulk) {
+    tlogger.trace("Writing {} sessions", bulk.size());
+    uint64_t num_records = 0;
+    for (auto& records : bulk) {
+        num_records += records->size();
+    }
+
     // Future is waited on indirectly in `stop()` (via `_pending_writes`).
-    (void)with_gate(_pending_writes, [this, records = std::move(records)] {
-        auto num_records = records->size();
-        return this->flush_one_session_mutations(std::move(records)).finally([this, num_records] { _local_tracing.write_complete(num_records); });
+    (void)with_gate(_pending_writes, [this, bulk = std::move(bulk), num_records] () mutable {
+        return this->flush_records_bulk(std::move(bulk)).finally([this, num_records] { _local_tracing.write_complete(num_records); });
     }).handle_exception([this] (auto ep) {
         try {
             ++_stats.tracing_errors;
@@ -242,13 +248,6 @@ void trace_keyspace_helper::write_one_session_records(lw_shared_ptr<one_session_
     }).discard_result();
 }
 
-void trace_keyspace_helper::write_records_bulk(records_bulk& bulk) {
-    tlogger.trace("Writing {} sessions", bulk.size());
-    std::for_each(bulk.begin(), bulk.end(), [this] (records_bulk::value_type& one_session_records_ptr) {
-        write_one_session_records(std::move(one_session_records_ptr));
-    });
-}
-
 cql3::query_options trace_keyspace_helper::make_session_mutation_data(gms::inet_address my_address, const one_session_records& session_records) {
     const session_record& record = session_records.session_rec;
     auto millis_since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(record.started_at.time_since_epoch()).count();
@@ -389,35 +388,25 @@ std::vector<cql3::raw_value> trace_keyspace_helper::make_event_mutation_data(gms
     return values;
 }
 
-future<> trace_keyspace_helper::apply_events_mutation(cql3::query_processor& qp, service::migration_manager& mm, lw_shared_ptr<one_session_records> records, std::deque<event_record>& events_records) {
-    if (events_records.empty()) {
-        return now();
-    }
-
-    return _events.cache_table_info(qp, mm, _dummy_query_state).then([this, &qp, records, &events_records] {
-        tlogger.trace("{}: storing {} events records: parent_id {} span_id {}", records->session_id, events_records.size(), records->parent_id, records->my_span_id);
-
-        std::vector<cql3::statements::batch_statement::single_statement> modifications(events_records.size(), cql3::statements::batch_statement::single_statement(_events.insert_stmt(), false));
-        std::vector<cql3::raw_value_vector_with_unset> values;
-
-        values.reserve(events_records.size());
-        std::for_each(events_records.begin(), events_records.end(), [&values, all_records = records, this] (event_record& one_event_record) { values.emplace_back(make_event_mutation_data(my_address(), *all_records, one_event_record)); });
-
-        return do_with(
-            cql3::query_options::make_batch_options(cql3::query_options(cql3::default_cql_config, db::consistency_level::ANY, std::nullopt, std::vector<cql3::raw_value>{}, false, cql3::query_options::specific_options::DEFAULT), std::move(values)),
-            cql3::statements::batch_statement(cql3::statements::batch_statement::type::UNLOGGED, std::move(modifications), cql3::attributes::none(), qp.get_cql_stats()),
-            [this, &qp] (auto& batch_options, auto& batch) {
-                return batch.execute(qp, _dummy_query_state, batch_options, std::nullopt).then([] (shared_ptr<cql_transport::messages::result_message> res) { return now(); });
-            }
-        );
-    });
+static cql3::query_options make_positional_options(std::vector<cql3::raw_value> values) {
+    return cql3::query_options(cql3::default_cql_config,
+            db::consistency_level::ANY, std::nullopt, std::move(values), false, cql3::query_options::specific_options::DEFAULT);
 }
 
-future<> trace_keyspace_helper::flush_one_session_mutations(lw_shared_ptr<one_session_records> records) {
-    // grab events records available so far
-    return do_with(std::move(records->events_recs), [this, records] (std::deque<event_record>& events_records) {
-        records->events_recs.clear();
-
+future<> trace_keyspace_helper::flush_records_bulk(records_bulk bulk) {
+    // This code is inside the _pending_writes gate and the qp pointer
+    // is cleared on ::stop() after the gate is closed.
+    SCYLLA_ASSERT(_qp_anchor != nullptr && _mm_anchor != nullptr);
+    cql3::query_processor& qp = *_qp_anchor;
+    service::migration_manager& mm = *_mm_anchor;
+    auto my_addr = my_address();
+
+    // Grab the records available so far and build the rows of all sessions
+    // in the bulk before the first preemption point: this way rows of events
+    // that were created first are going to be created first too.
+    std::vector<table_helper::batch_row> events_rows;
+    std::vector<table_helper::batch_row> sessions_rows;
+    for (auto& records : bulk) {
         // Check if a session's record is ready before handling events' records.
         //
         // New event's records and a session's record may become ready while a
@@ -426,46 +415,68 @@ future<> trace_keyspace_helper::flush_one_session_mutations(lw_shared_ptr<one_se
         // event record from the same session.
         bool session_record_is_ready = records->session_rec.ready();
 
+        tlogger.trace("{}: storing {} events records: parent_id {} span_id {}", records->session_id, records->events_recs.size(), records->parent_id, records->my_span_id);
+        for (const event_record& one_event_record : records->events_recs) {
+            events_rows.push_back({&_events, make_positional_options(make_event_mutation_data(my_addr, *records, one_event_record))});
+        }
+        records->events_recs.clear();
+
+        if (session_record_is_ready) {
+            // if session is finished - store a session and a session time index entries
+            tlogger.trace("{}: going to store a session event", records->session_id);
+            sessions_rows.push_back({&_sessions, make_session_mutation_data(my_addr, *records)});
+            sessions_rows.push_back({&_sessions_time_idx, make_session_time_idx_mutation_data(my_addr, *records)});
+
+            // if slow query log is requested - store a slow query log and a slow query log time index entries
+            if (records->do_log_slow_query) {
+                auto start_time_id = utils::UUID_gen::get_time_UUID(table_helper::make_monotonic_UUID_tp(_slow_query_last_nanos, records->session_rec.started_at));
+                tlogger.trace("{}: going to store a slow query event", records->session_id);
+                sessions_rows.push_back({&_slow_query_log, make_slow_query_mutation_data(my_addr, *records, start_time_id)});
+                sessions_rows.push_back({&_slow_query_log_time_idx, make_slow_query_time_idx_mutation_data(my_addr, *records, start_time_id)});
+            }
+        }
+
         // From this point on - all new data will have to be handled in the next write event
         records->data_consumed();
+    }
+
+    // Bulks are written one after another so that records of the same session
+    // that were consumed by an earlier write event are stored first. Within a
+    // bulk all events go first and only then the sessions' records.
+    auto units = co_await get_units(_write_sem, 1);
+    co_await write_rows(qp, mm, std::move(events_rows));
+    co_await write_rows(qp, mm, std::move(sessions_rows));
+}
+
+static size_t row_size(const table_helper::batch_row& row) {
+    size_t size = 0;
+    for (auto& v : row.options.get_values()) {
+        if (!v.is_null()) {
+            size += v.size_bytes();
+        }
+    }
+    return size;
+}
+
+future<> trace_keyspace_helper::write_rows(cql3::query_processor& qp, service::migration_manager& mm, std::vector<table_helper::batch_row> rows) {
+    // Batches spanning several partitions are rejected above the batch size
+    // fail threshold, and logged above the warning one.
+    const size_t max_bytes_per_batch = qp.db().get_config().batch_size_warn_threshold_in_kb() * 1024 / 4;
+
+    std::vector<std::vector<table_helper::batch_row>> batches;
+    size_t batch_bytes = 0;
+    for (auto& row : rows) {
+        auto size = row_size(row);
+        if (batches.empty() || batches.back().size() == max_rows_per_batch || batch_bytes + size > max_bytes_per_batch) {
+            batches.emplace_back();
+            batch_bytes = 0;
+        }
+        batches.back().push_back(std::move(row));
+        batch_bytes += size;
+    }
 
-        // We want to serialize the creation of events mutations in order to ensure
-        // that mutations for events that were created first are going to be
-        // created first too.
-        auto backend_state_ptr = static_cast<trace_keyspace_backend_sesssion_state*>(records->backend_state_ptr.get());
-        semaphore& write_sem = backend_state_ptr->write_sem;
-        return with_semaphore(write_sem, 1, [this, records, session_record_is_ready, &events_records] {
-            // This code is inside the _pending_writes gate and the qp pointer
-            // is cleared on ::stop() after the gate is closed.
-            SCYLLA_ASSERT(_qp_anchor != nullptr && _mm_anchor != nullptr);
-            cql3::query_processor& qp = *_qp_anchor;
-            service::migration_manager& mm = *_mm_anchor;
-            return apply_events_mutation(qp, mm, records, events_records).then([this, &qp, &mm, session_record_is_ready, records] {
-                if (session_record_is_ready) {
-
-                    // if session is finished - store a session and a session time index entries
-                    tlogger.trace("{}: going to store a session event", records->session_id);
-                    return _sessions.insert(qp, mm, _dummy_query_state, make_session_mutation_data, my_address(), std::ref(*records)).then([this, &qp, &mm, records] {
-                        tlogger.trace("{}: going to store a {} entry", records->session_id, _sessions_time_idx.name());
-                        return _sessions_time_idx.insert(qp, mm, _dummy_query_state, make_session_time_idx_mutation_data, my_address(), std::ref(*records));
-                    }).then([this, &qp, &mm, records] {
-                        if (!records->do_log_slow_query) {
-                            return now();
-                        }
-
-                        // if slow query log is requested - store a slow query log and a slow query log time index entries
-                        auto start_time_id = utils::UUID_gen::get_time_UUID(table_helper::make_monotonic_UUID_tp(_slow_query_last_nanos, records->session_rec.started_at));
-                        tlogger.trace("{}: going to store a slow query event", records->session_id);
-                        return _slow_query_log.insert(qp, mm, _dummy_query_state, make_slow_query_mutation_data, my_address(), std::ref(*records), start_time_id).then([this, &qp, &mm, records, start_time_id] {
-                            tlogger.trace("{}: going to store a {} entry", records->session_id, _slow_query_log_time_idx.name());
-                            return _slow_query_log_time_idx.insert(qp, mm, _dummy_query_state, make_slow_query_time_idx_mutation_data, my_address(), std::ref(*records), start_time_id);
-                        });
-                    });
-                } else {
-                    return now();
-                }
-            });
-        }).finally([records] {});
+    co_await coroutine::parallel_for_each(batches, [this, &qp, &mm] (std::vector<table_helper::batch_row>& batch) {
+        return table_helper::insert_batch(qp, mm, _dummy_query_state, std::move(batch));
     });
 }
 
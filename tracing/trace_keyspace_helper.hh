@@ -10,6 +10,7 @@
 #pragma once
 
 #include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/metrics_registration.hh>
 #include "tracing/tracing.hh"
 #include "table_helper.hh"
@@ -29,8 +30,12 @@ class trace_keyspace_helper final : public i_tracing_backend_helper {
     static constexpr std::string_view NODE_SLOW_QUERY_LOG_TIME_IDX = "node_slow_log_time_idx";
 private:
     static constexpr int bad_column_family_message_period = 10000;
+    // maximum number of rows written in a single UNLOGGED batch
+    static constexpr size_t max_rows_per_batch = 100;
 
     seastar::gate _pending_writes;
+    // serializes writes of consecutive bulks
+    semaphore _write_sem{1};
     int64_t _slow_query_last_nanos = 0;
     service::query_state _dummy_query_state;
 
@@ -76,39 +81,31 @@ class trace_keyspace_helper final : public i_tracing_backend_helper {
     gms::inet_address my_address() const noexcept;
 
     /**
-     * Write records of a single tracing session
-     *
-     * @param records records to write
-     */
-    void write_one_session_records(lw_shared_ptr<one_session_records> records);
-
-    /**
-     * Flush mutations of one particular tracing session. First "events"
-     * mutations and then, when they are complete, a "sessions" mutation.
+     * Flush mutations of all tracing sessions in a bulk. Events of all
+     * sessions are written in large UNLOGGED batches first and then, when
+     * they are complete, the "sessions" (and slow query log) records of the
+     * sessions that are finished.
      *
      * @note This function guaranties that it'll handle exactly the same number
-     * of records @param records had when the function was invoked.
+     * of records the sessions in @param bulk had when the function was invoked.
      *
-     * @param records records describing the session's records
+     * @param bulk sessions whose records are to be written
      *
      * @return A future that resolves when applying of above mutations is
      *         complete.
      */
-    future<> flush_one_session_mutations(lw_shared_ptr<one_session_records> records);
+    future<> flush_records_bulk(records_bulk bulk);
 
     /**
-     * Apply events records mutations.
-     *
-     * @param records all session records
-     * @param events_records events recods to apply
-     * @param start_point a time point when this tracing session data writing has started
-     *
-     * @return a future that resolves when the mutation has been written.
+     * Write the given rows in UNLOGGED batches of at most max_rows_per_batch
+     * rows each. A batch is also closed once its values take a quarter of
+     * the batch size warning threshold, which leaves room for the per-cell
+     * overhead the threshold is checked against. The batches are written in
+     * parallel.
      *
-     * @note A caller must ensure that @param events_records is alive till the
-     * returned future resolves.
+     * @return a future that resolves when all batches have been written.
      */
-    future<> apply_events_mutation(cql3::query_processor& qp, service::migration_manager& mm, lw_shared_ptr<one_session_records> records, std::deque<event_record>& events_records);
+    future<> write_rows(cql3::query_processor& qp, service::migration_manager& mm, std::vector<table_helper::batch_row> rows);
 
     /**
      * Create a mutation data for a new session record
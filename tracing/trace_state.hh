@@ -526,6 +526,16 @@ inline void trace_state::trace_internal(std::string&& message) {
         throw std::logic_error("trying to use a trace() before begin() for \"" + message + "\" tracepoint");
     }
 
+    auto e = elapsed();
+
+    // A session that is traced only for the sake of slow query logging keeps
+    // its events in a bounded ring while it's still below the slow query
+    // threshold: the oldest event is overwritten by the new one. This way fast
+    // queries don't exhaust the shared budget below and an outlier still keeps
+    // the events that lead to it becoming slow.
+    bool overwrite_oldest = !full_tracing() && !should_log_slow_query(e) && !_records->is_pending_for_write()
+            && _records->events_recs.size() >= tracing::max_tail_events_per_session;
+
     // We don't want the total amount of pending, active and flushing records to
     // bypass two times the maximum number of pending records.
     //
@@ -533,7 +543,7 @@ inline void trace_state::trace_internal(std::string&& message) {
     // keep up we want to start dropping records.
     // In any case, this should be rare, therefore we don't try to optimize this
     // flow.
-    if (!_local_tracing_ptr->have_records_budget()) {
+    if (!overwrite_oldest && !_local_tracing_ptr->have_records_budget()) {
         tracing_logger.trace("{}: Maximum number of traces is reached. Some traces are going to be dropped", session_id());
         if ((++_local_tracing_ptr->stats.dropped_records) % tracing::log_warning_period == 1) {
             tracing_logger.warn("Maximum records limit is hit {} times", _local_tracing_ptr->stats.dropped_records);
@@ -543,9 +553,14 @@ inline void trace_state::trace_internal(std::string&& message) {
     }
 
     try {
-        auto e = elapsed();
+        if (overwrite_oldest) {
+            _records->events_recs.pop_front();
+            ++_local_tracing_ptr->stats.overwritten_records;
+        }
         _records->events_recs.emplace_back(std::move(message), e, i_tracing_backend_helper::wall_clock::now());
-        _records->consume_from_budget();
+        if (!overwrite_oldest) {
+            _records->consume_from_budget();
+        }
 
         // If we have aggregated enough records - schedule them for write already.
         //
@@ -45,6 +45,10 @@ tracing::tracing(sstring tracing_backend_helper_class_name)
                         sm::description("Counts a number of dropped records due to too many pending records. "
                                         "High value indicates that backend is saturated with the rate with which new tracing records are created.")),
 
+        sm::make_counter("overwritten_records", stats.overwritten_records,
+                        sm::description("Counts a number of records of slow query logging sessions that were overwritten by newer records of the same session "
+                                        "while the session was still below the slow query threshold.")),
+
         sm::make_counter("trace_records_count", stats.trace_records_count,
                         sm::description("This metric is a rate of tracing records generation.")),
 
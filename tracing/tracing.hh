@@ -300,6 +300,10 @@ class tracing : public seastar::async_sharded_service<tracing> {
     static constexpr int write_event_sessions_threshold = 100;
     // number of pending records that would trigger a write event
     static constexpr int write_event_records_threshold = write_event_sessions_threshold * exp_trace_events_per_session;
+    // maximum number of events a session that is only traced for slow query
+    // logging keeps while it's still below the slow query threshold; older
+    // events are overwritten by newer ones
+    static constexpr int max_tail_events_per_session = 4 * exp_trace_events_per_session;
     // Number of events when an info message is printed
     static constexpr int log_warning_period = 10000;
 
@@ -309,6 +313,7 @@ class tracing : public seastar::async_sharded_service<tracing> {
     struct stats {
         uint64_t dropped_sessions = 0;
         uint64_t dropped_records = 0;
+        uint64_t overwritten_records = 0;
         uint64_t trace_records_count = 0;
         uint64_t trace_errors = 0;
     } stats;
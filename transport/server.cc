@@ -1024,6 +1024,22 @@ cql_server::connection::process(uint16_t stream, request_reader in, service::cli
     co_return std::get<cql_server::result_with_foreign_response_ptr>(std::move(msg));
 }
 
+// Statements which have to execute on a particular shard (lightweight
+// transactions) are sent there as soon as the bound values are known, instead
+// of being authorized and partially executed on this shard before the
+// statement itself asks for the bounce.
+static std::optional<cql_server::process_fn_return_type>
+route_to_execution_shard(cql3::query_processor& qp, const cql3::cql_statement& stmt, cql3::query_options& options,
+        const tracing::trace_state_ptr& trace_state) {
+    auto shard = stmt.execution_shard(options);
+    if (!shard || *shard == this_shard_id()) {
+        return std::nullopt;
+    }
+    tracing::trace(trace_state, "Routing the request to shard {}", *shard);
+    return cql_server::process_fn_return_type(make_foreign(dynamic_pointer_cast<messages::result_message::bounce_to_shard>(
+            qp.bounce_to_shard(*shard, options.take_cached_pk_function_calls()))));
+}
+
 static future<cql_server::process_fn_return_type>
 process_query_internal(service::client_state& client_state, distributed<cql3::query_processor>& qp, request_reader in,
         uint16_t stream, cql_protocol_version_type version,
@@ -1143,6 +1159,11 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
 
     if (init_trace) {
         tracing::add_prepared_query_options(trace_state, options);
+
+        // init_trace is only set on the shard which received the request.
+        if (auto routed = route_to_execution_shard(qp.local(), *stmt, options, trace_state)) {
+            return make_ready_future<cql_server::process_fn_return_type>(std::move(*routed));
+        }
     }
 
     tracing::trace(trace_state, "Processing a statement");
@@ -1267,6 +1288,11 @@ process_batch_internal(service::client_state& client_state, distributed<cql3::qu
     }
 
     auto batch = ::make_shared<cql3::statements::batch_statement>(cql3::statements::batch_statement::type(type), std::move(modifications), cql3::attributes::none(), qp.local().get_cql_stats());
+    if (init_trace) {
+        if (auto routed = route_to_execution_shard(qp.local(), *batch, options, trace_state)) {
+            return make_ready_future<cql_server::process_fn_return_type>(std::move(*routed));
+        }
+    }
     return qp.local().execute_batch_without_checking_exception_message(batch, query_state, options, std::move(pending_authorization_entries))
             .then([stream, batch, q_state = std::move(q_state), trace_state = query_state.get_trace_state(), version] (auto msg) {
         if (msg->move_to_shard()) {
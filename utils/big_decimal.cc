@@ -8,6 +8,8 @@
 
 #include "utils/assert.hh"
 #include "big_decimal.hh"
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include "marshal_exception.hh"
 #include <seastar/core/format.hh>
@@ -27,6 +29,46 @@ using string_view_workaround = std::string_view;
 
 #endif
 
+namespace {
+
+// Powers of ten which fit in an __int128.
+constexpr auto small_powers_of_ten = [] {
+    std::array<__int128, 39> ret{};
+    ret[0] = 1;
+    for (size_t i = 1; i < ret.size(); ++i) {
+        ret[i] = ret[i - 1] * 10;
+    }
+    return ret;
+}();
+
+// Any string of up to this many decimal digits fits in an __int128.
+constexpr size_t max_small_digits = small_powers_of_ten.size() - 1;
+
+// Returns v * 10^n.
+utils::multiprecision_int rescale(const utils::multiprecision_int& v, uint32_t n) {
+    if (n < small_powers_of_ten.size()) {
+        return v * small_powers_of_ten[n];
+    }
+    boost::multiprecision::cpp_int ten(10);
+    return boost::multiprecision::cpp_int(boost::multiprecision::cpp_int(v) * boost::multiprecision::pow(ten, n));
+}
+
+int sign(const utils::multiprecision_int& v) {
+    return (v > 0) - (v < 0);
+}
+
+// Index of the most significant bit of a positive value.
+int64_t msb(const utils::multiprecision_int& v) {
+    if (v.is_small()) {
+        const auto u = static_cast<unsigned __int128>(v.small_value());
+        const auto high = static_cast<uint64_t>(u >> 64);
+        return high ? 127 - __builtin_clzll(high) : 63 - __builtin_clzll(static_cast<uint64_t>(u));
+    }
+    return boost::multiprecision::msb(boost::multiprecision::cpp_int(v));
+}
+
+}
+
 uint64_t from_varint_to_integer(const utils::multiprecision_int& varint) {
     // The behavior CQL expects on overflow is for values to wrap
     // around. For cpp_int conversion functions, the behavior is to
@@ -34,12 +76,17 @@ uint64_t from_varint_to_integer(const utils::multiprecision_int& varint) {
     // represent. To implement one with the other, we first mask the
     // low 64 bits, convert to a uint64_t, and then let c++ convert,
     // with possible overflow, to ToType.
+    if (varint.is_small()) {
+        return static_cast<uint64_t>(varint.small_value());
+    }
     return static_cast<uint64_t>(~static_cast<uint64_t>(0) & boost::multiprecision::cpp_int(varint));
 }
 
-big_decimal::big_decimal() : big_decimal(0, 0) {}
+big_decimal::big_decimal() : big_decimal(0, utils::multiprecision_int()) {}
 big_decimal::big_decimal(int32_t scale, boost::multiprecision::cpp_int unscaled_value)
     : _scale(scale), _unscaled_value(std::move(unscaled_value)) {}
+big_decimal::big_decimal(int32_t scale, utils::multiprecision_int unscaled_value)
+    : _scale(scale), _unscaled_value(std::move(unscaled_value)) {}
 
 big_decimal::big_decimal(std::string_view text)
 {
@@ -70,13 +117,21 @@ big_decimal::big_decimal(std::string_view text)
     }
 
     integer.remove_prefix(std::min(integer.find_first_not_of("0"), integer.size() - 1));
-    try {
-        _unscaled_value = boost::multiprecision::cpp_int(string_view_workaround(integer));
-    } catch (...) {
-        throw marshal_exception(seastar::format("big_decimal - failed to parse integer value: {}", integer));
-    }
-    if (negative) {
-        _unscaled_value *= -1;
+    if (integer.size() <= max_small_digits && std::ranges::all_of(integer, ::isdigit)) {
+        __int128 v = 0;
+        for (char c : integer) {
+            v = v * 10 + (c - '0');
+        }
+        _unscaled_value = utils::multiprecision_int::from_int128(negative ? -v : v);
+    } else {
+        try {
+            _unscaled_value = boost::multiprecision::cpp_int(string_view_workaround(integer));
+        } catch (...) {
+            throw marshal_exception(seastar::format("big_decimal - failed to parse integer value: {}", integer));
+        }
+        if (negative) {
+            _unscaled_value = -_unscaled_value;
+        }
     }
     try {
         _scale = exponent.empty() ? 0 : -boost::lexical_cast<int32_t>(exponent);
@@ -88,7 +143,7 @@ big_decimal::big_decimal(std::string_view text)
 
 boost::multiprecision::cpp_rational big_decimal::as_rational() const {
     boost::multiprecision::cpp_int ten(10);
-    auto unscaled_value = static_cast<const boost::multiprecision::cpp_int&>(_unscaled_value);
+    boost::multiprecision::cpp_int unscaled_value = _unscaled_value;
     boost::multiprecision::cpp_rational r = unscaled_value;
     int32_t abs_scale = std::abs(_scale);
     auto pow = boost::multiprecision::pow(ten, abs_scale);
@@ -102,11 +157,14 @@ boost::multiprecision::cpp_rational big_decimal::as_rational() const {
 
 sstring big_decimal::to_string() const
 {
-    if (!_unscaled_value) {
+    if (_unscaled_value == 0) {
         return "0";
     }
-    boost::multiprecision::cpp_int num = boost::multiprecision::abs(_unscaled_value);
-    auto str = num.str();
+    auto str = _unscaled_value.str();
+    const bool negative = str.front() == '-';
+    if (negative) {
+        str.erase(0, 1);
+    }
     if (_scale < 0) {
         for (int i = 0; i > _scale; i--) {
             str.push_back('0');
@@ -128,7 +186,7 @@ sstring big_decimal::to_string() const
             str.pop_back();
         }
     }
-    if (_unscaled_value < 0) {
+    if (negative) {
         str.insert(0, 1, '-');
     }
     return str;
@@ -137,35 +195,33 @@ sstring big_decimal::to_string() const
 std::strong_ordering big_decimal::tri_cmp_slow(const big_decimal& other) const
 {
     auto max_scale = std::max(_scale, other._scale);
-    boost::multiprecision::cpp_int rescale(10);
-    boost::multiprecision::cpp_int x = _unscaled_value * boost::multiprecision::pow(rescale, max_scale - _scale);
-    boost::multiprecision::cpp_int y = other._unscaled_value * boost::multiprecision::pow(rescale, max_scale - other._scale);
-    return x.compare(y) <=> 0;
+    auto x = rescale(_unscaled_value, max_scale - _scale);
+    auto y = rescale(other._unscaled_value, max_scale - other._scale);
+    return x <=> y;
 }
 
 std::strong_ordering big_decimal::operator<=>(const big_decimal& other) const
 {
     if (_scale == other._scale) {
-        return _unscaled_value.compare(other._unscaled_value) <=> 0;
+        return _unscaled_value <=> other._unscaled_value;
     }
 
-    // boost::multiprecision::sign() returns -1, 0 or 1
-    const int sign = boost::multiprecision::sign(_unscaled_value);
-    const int sign_other = boost::multiprecision::sign(other._unscaled_value);
-    if (sign != sign_other) {
-        return sign <=> sign_other;
+    const int s = sign(_unscaled_value);
+    const int s_other = sign(other._unscaled_value);
+    if (s != s_other) {
+        return s <=> s_other;
     }
     // At this point we know the two signs are equal, so if sign == 0, both signs
     // and consequently both numbers are zeros.
-    if (sign == 0) {
+    if (s == 0) {
         return std::strong_ordering::equal;
     }
 
     // At this point we know that both numbers have the same sign, so if one is negative, the other is too.
     // If the number are negative, we invert the sign and compare them in reverse.
     // This creates a copy, but the copy cannot be avoided anyway, because
-    // boost::multiprecision::msb() (used below) doesn't work with negative numbers.
-    if (sign < 0) {
+    // msb() (used below) doesn't work with negative numbers.
+    if (s < 0) {
         auto a = -*this;
         auto b = -other;
         return b.tri_cmp_positive_nonzero_different_scale(a);
@@ -193,9 +249,7 @@ std::strong_ordering big_decimal::tri_cmp_positive_nonzero_different_scale(const
     //
     // To avoid using division and then calculating a log2(), we use the MSB of
     // both numbers to infer unscaled_ratio_log2 directly.
-    const int64_t msb = boost::multiprecision::msb(_unscaled_value);
-    const int64_t msb_other = boost::multiprecision::msb(other._unscaled_value);
-    const int64_t unscaled_ratio_log2 = msb - msb_other;
+    const int64_t unscaled_ratio_log2 = msb(_unscaled_value) - msb(other._unscaled_value);
 
     // Now we can rewrite the original numbers as follows:
     //
@@ -246,11 +300,8 @@ big_decimal& big_decimal::operator+=(const big_decimal& other)
     if (_scale == other._scale) {
         _unscaled_value += other._unscaled_value;
     } else {
-        boost::multiprecision::cpp_int rescale(10);
         auto max_scale = std::max(_scale, other._scale);
-        boost::multiprecision::cpp_int u = _unscaled_value * boost::multiprecision::pow(rescale,  max_scale - _scale);
-        boost::multiprecision::cpp_int v = other._unscaled_value * boost::multiprecision::pow(rescale, max_scale - other._scale);
-        _unscaled_value = u + v;
+        _unscaled_value = rescale(_unscaled_value, max_scale - _scale) + rescale(other._unscaled_value, max_scale - other._scale);
         _scale = max_scale;
     }
     return *this;
@@ -260,11 +311,8 @@ big_decimal& big_decimal::operator-=(const big_decimal& other) {
     if (_scale == other._scale) {
         _unscaled_value -= other._unscaled_value;
     } else {
-        boost::multiprecision::cpp_int rescale(10);
         auto max_scale = std::max(_scale, other._scale);
-        boost::multiprecision::cpp_int u = _unscaled_value * boost::multiprecision::pow(rescale,  max_scale - _scale);
-        boost::multiprecision::cpp_int v = other._unscaled_value * boost::multiprecision::pow(rescale, max_scale - other._scale);
-        _unscaled_value = u - v;
+        _unscaled_value = rescale(_unscaled_value, max_scale - _scale) - rescale(other._unscaled_value, max_scale - other._scale);
         _scale = max_scale;
     }
     return *this;
@@ -296,8 +344,20 @@ big_decimal big_decimal::div(const ::uint64_t y, const rounding_mode mode) const
     }
 
     // Implementation of Division with Half to Even (aka Bankers) Rounding
+    if (_unscaled_value.is_small() && y != 0) {
+        const __int128 v = _unscaled_value.small_value();
+        // Work on the magnitude as unsigned, so that the minimum value does not overflow.
+        const unsigned __int128 a = v < 0 ? -static_cast<unsigned __int128>(v) : static_cast<unsigned __int128>(v);
+        const unsigned __int128 r = a % y;
+        unsigned __int128 q = a / y;
+        if (2*r > y || (2*r == y && q % 2 == 1)) {
+            q += 1;
+        }
+        return big_decimal(_scale, utils::multiprecision_int::from_int128(static_cast<__int128>(v < 0 ? -q : q)));
+    }
+
     const boost::multiprecision::cpp_int sign = _unscaled_value >= 0 ? +1 : -1;
-    const boost::multiprecision::cpp_int a = sign * _unscaled_value;
+    const boost::multiprecision::cpp_int a = sign * boost::multiprecision::cpp_int(_unscaled_value);
     // cpp_int uses lazy evaluation and for older versions of boost and some
     //   versions of gcc, expression templates have problem to implicitly
     //   convert to cpp_int, so we force the conversion explicitly before cpp_int
@@ -20,7 +20,7 @@ uint64_t from_varint_to_integer(const utils::multiprecision_int& varint);
 class big_decimal {
 private:
     int32_t _scale;
-    boost::multiprecision::cpp_int _unscaled_value;
+    utils::multiprecision_int _unscaled_value;
 
 private:
     std::strong_ordering tri_cmp_slow(const big_decimal& other) const;
@@ -34,10 +34,11 @@ class big_decimal {
     explicit big_decimal(std::string_view text);
     big_decimal();
     big_decimal(int32_t scale, boost::multiprecision::cpp_int unscaled_value);
-    big_decimal(std::integral auto v) : big_decimal(0, v) {}
+    big_decimal(int32_t scale, utils::multiprecision_int unscaled_value);
+    big_decimal(std::integral auto v) : big_decimal(0, utils::multiprecision_int::from_int128(v)) {}
 
     int32_t scale() const { return _scale; }
-    const boost::multiprecision::cpp_int& unscaled_value() const { return _unscaled_value; }
+    const utils::multiprecision_int& unscaled_value() const { return _unscaled_value; }
     boost::multiprecision::cpp_rational as_rational() const;
 
     sstring to_string() const;
@@ -32,6 +32,7 @@
 #include "utils/preempt.hh"
 #include "utils/vle.hh"
 #include "utils/coarse_steady_clock.hh"
+#include "utils/div_ceil.hh"
 
 #include <random>
 #include <chrono>
@@ -399,20 +400,29 @@ using clock = std::chrono::steady_clock;
 class background_reclaimer {
     scheduling_group _sg;
     noncopyable_function<void (size_t target)> _reclaim;
+    // Compaction of sparse segments ahead of demand, so that allocating
+    // paths don't have to compact inline. _compact() returns false when
+    // no progress could be made.
+    noncopyable_function<bool ()> _compaction_needed;
+    noncopyable_function<bool ()> _compact;
     timer<lowres_clock> _adjust_shares_timer;
     // If engaged, main loop is not running, set_value() to wake it.
     promise<>* _main_loop_wait = nullptr;
     future<> _done;
     bool _stopping = false;
     static constexpr size_t free_memory_threshold = 60'000'000;
+    static constexpr float compaction_shares = 100;
 private:
-    bool have_work() const {
+    bool memory_pressure() const {
 #ifndef SEASTAR_DEFAULT_ALLOCATOR
         return memory::free_memory() < free_memory_threshold;
 #else
         return false;
 #endif
     }
+    bool have_work() const {
+        return memory_pressure() || _compaction_needed();
+    }
     void main_loop_wake() {
         llogger.debug("background_reclaimer::main_loop_wake: waking {}", bool(_main_loop_wait));
         if (_main_loop_wait) {
@@ -420,28 +430,43 @@ class background_reclaimer {
             _main_loop_wait = nullptr;
         }
     }
+    future<> sleep() {
+        promise<> wait;
+        _main_loop_wait = &wait;
+        llogger.trace("background_reclaimer::main_loop: sleep");
+        co_await wait.get_future();
+        llogger.trace("background_reclaimer::main_loop: awakened");
+        _main_loop_wait = nullptr;
+    }
     future<> main_loop() {
         llogger.debug("background_reclaimer::main_loop: entry");
         while (true) {
             while (!_stopping && !have_work()) {
-                promise<> wait;
-                _main_loop_wait = &wait;
-                llogger.trace("background_reclaimer::main_loop: sleep");
-                co_await wait.get_future();
-                llogger.trace("background_reclaimer::main_loop: awakened");
-                _main_loop_wait = nullptr;
+                co_await sleep();
             }
             if (_stopping) {
                 break;
             }
-            _reclaim(free_memory_threshold - memory::free_memory());
+            // Compaction goes first, so that it runs ahead of the memory
+            // pressure it would otherwise have to be done under.
+            if (!_compaction_needed() || !_compact()) {
+                if (memory_pressure()) {
+                    _reclaim(free_memory_threshold - memory::free_memory());
+                } else {
+                    // Nothing can be compacted now, retry after the next adjust_shares().
+                    co_await sleep();
+                    continue;
+                }
+            }
             co_await coroutine::maybe_yield();
         }
         llogger.debug("background_reclaimer::main_loop: exit");
     }
     void adjust_shares() {
         if (have_work()) {
-            auto shares = 1 + (1000 * (free_memory_threshold - memory::free_memory())) / free_memory_threshold;
+            auto shares = memory_pressure()
+                    ? 1 + (1000 * (free_memory_threshold - memory::free_memory())) / free_memory_threshold
+                    : compaction_shares;
             _sg.set_shares(shares);
             llogger.trace("background_reclaimer::adjust_shares: {}", shares);
             if (_main_loop_wait) {
@@ -450,9 +475,12 @@ class background_reclaimer {
         }
     }
 public:
-    explicit background_reclaimer(scheduling_group sg, noncopyable_function<void (size_t target)> reclaim)
+    explicit background_reclaimer(scheduling_group sg, noncopyable_function<void (size_t target)> reclaim,
+            noncopyable_function<bool ()> compaction_needed, noncopyable_function<bool ()> compact)
             : _sg(sg)
             , _reclaim(std::move(reclaim))
+            , _compaction_needed(std::move(compaction_needed))
+            , _compact(std::move(compact))
             , _adjust_shares_timer(default_scheduling_group(), [this] { adjust_shares(); })
             , _done(with_scheduling_group(_sg, [this] { return main_loop(); })) {
         if (sg != default_scheduling_group()) {
@@ -466,6 +494,13 @@ class background_reclaimer {
     }
 };
 
+// Size of the (transparent or hugetlbfs backed) pages which back segment memory.
+// Segments sharing a huge page share a TLB entry, so the fewer huge pages hold
+// LSA data the cheaper LSA accesses are.
+static constexpr int huge_page_shift = 21; // 2M
+static constexpr size_t huge_page_size = size_t(1) << huge_page_shift;
+static constexpr size_t segments_per_huge_page = huge_page_size / segment_size;
+
 class segment_pool;
 struct reclaim_timer;
 
@@ -478,6 +513,8 @@ class tracker::impl {
     size_t _reclamation_step = 1;
     bool _abort_on_bad_alloc = false;
     bool _sanitizer_report_backtrace = false;
+    // Set while compacting off the allocating paths, see stats::background_compaction_time.
+    bool _background_compaction = false;
     reclaim_timer* _active_timer = nullptr;
 private:
     // Prevents tracker's reclaimer from running while live. Reclaimer may be
@@ -494,7 +531,22 @@ class tracker::impl {
             _ref.enable_reclaim();
         }
     };
+    struct background_compaction_guard {
+        impl& _ref;
+        bool _prev;
+        background_compaction_guard(impl& ref) noexcept
+            : _ref(ref)
+            , _prev(std::exchange(ref._background_compaction, true))
+        { }
+        ~background_compaction_guard() {
+            _ref._background_compaction = _prev;
+        }
+    };
     friend class tracker_reclaimer_lock;
+    // Compacts one segment at a time, from the sparsest region, until stop() returns true.
+    // Returns false if it stopped because there is nothing left to compact.
+    template <typename StopFn>
+    bool compact_sparse_segments(StopFn stop);
 public:
     impl();
     ~impl();
@@ -520,6 +572,14 @@ class tracker::impl {
     // Compacts one segment at a time from sparsest segment to least sparse until work_waiting_on_reactor returns true
     // or there are no more segments to compact.
     idle_cpu_handler_result compact_on_idle(work_waiting_on_reactor check_for_work);
+    // Returns true if the segment pool is about to run out of free segments, so
+    // that the next allocations would have to compact inline, and there is
+    // sparse memory which compaction could free.
+    bool background_compaction_needed() const noexcept;
+    // Compacts sparse segments until preempted or no longer needed.
+    // Returns false if no segment could be compacted.
+    bool compact_in_background() noexcept;
+    bool in_background_compaction() const noexcept { return _background_compaction; }
     // Releases whole segments back to the segment pool.
     // After the call, if there is enough evictable memory, the amount of free segments in the pool
     // will be at least reserve_segments + div_ceil(bytes, segment::size).
@@ -531,6 +591,7 @@ class tracker::impl {
     occupancy_stats region_occupancy() const noexcept;
     occupancy_stats occupancy() const noexcept;
     size_t non_lsa_used_space() const noexcept;
+    occupancy_stats huge_page_occupancy() const noexcept;
     // Set the minimum number of segments reclaimed during single reclamation cycle.
     void set_reclamation_step(size_t step_in_segments) noexcept { _reclamation_step = step_in_segments; }
     size_t reclamation_step() const noexcept { return _reclamation_step; }
@@ -540,7 +601,12 @@ class tracker::impl {
     void setup_background_reclaim(scheduling_group sg) {
         SCYLLA_ASSERT(!_background_reclaimer);
         _background_reclaimer.emplace(sg, [this] (size_t target) {
+            background_compaction_guard bg(*this);
             reclaim(target, is_preemptible::yes);
+        }, [this] {
+            return background_compaction_needed();
+        }, [this] {
+            return compact_in_background();
         });
     }
     // const bool&, so interested parties can save a reference and see updates.
@@ -608,6 +674,10 @@ size_t tracker::non_lsa_used_space() const noexcept {
     return _impl->non_lsa_used_space();
 }
 
+occupancy_stats tracker::huge_page_occupancy() const noexcept {
+    return _impl->huge_page_occupancy();
+}
+
 void tracker::full_compaction() {
     return _impl->full_compaction();
 }
@@ -616,6 +686,10 @@ void tracker::reclaim_all_free_segments() {
     return _impl->reclaim_all_free_segments();
 }
 
+bool tracker::compact_in_background() {
+    return _impl->compact_in_background();
+}
+
 tracker& shard_tracker() noexcept {
     return tracker_instance;
 }
@@ -647,6 +721,8 @@ struct alignas(segment_size) segment {
 
 static constexpr size_t max_managed_object_size = segment_size * 0.1;
 static constexpr auto max_used_space_ratio_for_compaction = 0.85;
+// Number of free segments which background compaction keeps in the pool.
+static constexpr size_t background_compaction_free_segments_goal = 32;
 static constexpr size_t max_used_space_for_compaction = segment_size * max_used_space_ratio_for_compaction;
 static constexpr size_t min_free_space_for_compaction = segment_size - max_used_space_for_compaction;
 
@@ -883,6 +959,15 @@ class contiguous_memory_segment_store {
     size_t max_segments() const noexcept {
         return (_backend->memory_layout().end - _backend->segments_base()) / segment::size;
     }
+    // Returns the index of the huge page which backs the segment with the given index.
+    size_t huge_page_from_idx(size_t idx) const noexcept {
+        auto base = align_down(_backend->memory_layout().start, huge_page_size);
+        return (reinterpret_cast<uintptr_t>(segment_from_idx(idx)) - base) >> huge_page_shift;
+    }
+    size_t max_huge_pages() const noexcept {
+        auto base = align_down(_backend->memory_layout().start, huge_page_size);
+        return (align_up(_backend->memory_layout().end, huge_page_size) - base) >> huge_page_shift;
+    }
     bool can_allocate_more_segments() const noexcept {
         return _backend->can_allocate_more_segments(non_lsa_reserve);
     }
@@ -981,6 +1066,20 @@ class segment_store {
         }
         return _std_memory_available / segment::size;
     }
+    // Segments are allocated individually from the standard allocator, so
+    // the huge page index is nominal unless a delegate store is used.
+    size_t huge_page_from_idx(size_t idx) const noexcept {
+        if (_delegate_store) {
+            return _delegate_store->huge_page_from_idx(idx);
+        }
+        return idx / segments_per_huge_page;
+    }
+    size_t max_huge_pages() const noexcept {
+        if (_delegate_store) {
+            return _delegate_store->max_huge_pages();
+        }
+        return div_ceil(max_segments(), segments_per_huge_page);
+    }
     bool can_allocate_more_segments() const noexcept {
         if (_delegate_store) {
             return _delegate_store->can_allocate_more_segments();
@@ -1005,6 +1104,9 @@ class segment_pool {
     utils::dynamic_bitset _lsa_owned_segments_bitmap; // owned by this
     utils::dynamic_bitset _lsa_free_segments_bitmap;  // owned by this, but not in use
     size_t _free_segments = 0;
+    // Number of segments in use in each huge page of the segment store.
+    std::vector<uint8_t> _huge_page_segments_in_use;
+    size_t _huge_pages_in_use = 0;
 
     // Invariant: _free_segments > _current_emergency_reserve_goal.
     // Used to ensure that some critical allocations won't fail.
@@ -1065,14 +1167,24 @@ class segment_pool {
     size_t max_segments() const noexcept {
         return _store.max_segments();
     }
-    bool can_allocate_more_segments() const noexcept {
-        return _allocation_enabled && _store.can_allocate_more_segments();
-    }
     bool compact_segment(segment* seg);
+    void on_segment_use(const segment* seg) noexcept {
+        if (_huge_page_segments_in_use[_store.huge_page_from_idx(idx_from_segment(seg))]++ == 0) {
+            ++_huge_pages_in_use;
+        }
+    }
+    void on_segment_release(const segment* seg) noexcept {
+        if (--_huge_page_segments_in_use[_store.huge_page_from_idx(idx_from_segment(seg))] == 0) {
+            --_huge_pages_in_use;
+        }
+    }
 public:
     explicit segment_pool(logalloc::tracker::impl& tracker);
     logalloc::tracker::impl& tracker() { return _tracker; }
     void prime(size_t available_memory, size_t min_free_memory);
+    bool can_allocate_more_segments() const noexcept {
+        return _allocation_enabled && _store.can_allocate_more_segments();
+    }
     void use_standard_allocator_segment_pool_backend(size_t available_memory);
     segment* new_segment(region::impl* r);
     const segment_descriptor& descriptor(const segment* seg) const noexcept {
@@ -1089,6 +1201,8 @@ class segment_pool {
     void free_segment(segment*) noexcept;
     void free_segment(segment*, segment_descriptor&) noexcept;
     size_t segments_in_use() const noexcept;
+    // Number of huge pages which back at least one segment in use.
+    size_t huge_pages_in_use() const noexcept { return _huge_pages_in_use; }
     size_t current_emergency_reserve_goal() const noexcept { return _current_emergency_reserve_goal; }
     void set_emergency_reserve_max(size_t new_size) noexcept { _emergency_reserve_max = new_size; }
     size_t emergency_reserve_max() const noexcept { return _emergency_reserve_max; }
@@ -1129,7 +1243,7 @@ class segment_pool {
     tracker::stats _stats{};
 public:
     const tracker::stats& statistics() const noexcept { return _stats; }
-    inline void on_segment_compaction(size_t used_size) noexcept;
+    inline void on_segment_compaction(size_t used_size, std::chrono::steady_clock::duration duration) noexcept;
     inline void on_memory_allocation(size_t size) noexcept;
     inline void on_memory_deallocation(size_t size) noexcept;
     inline void on_memory_eviction(size_t size) noexcept;
@@ -1352,8 +1466,7 @@ void segment_pool::ensure_free_segments(size_t n_segments) {
         if (!seg) {
             throw std::bad_alloc();
         }
-        ++_segments_in_use;
-        free_segment(seg);
+        deallocate_segment(seg);
     }
 }
 
@@ -1395,6 +1508,7 @@ segment*
 segment_pool::new_segment(region::impl* r) {
     auto seg = allocate_or_fallback_to_reserve();
     ++_segments_in_use;
+    on_segment_use(seg);
     segment_descriptor& desc = descriptor(seg);
     desc.set_free_space(segment::size);
     desc.set_kind(segment_kind::regular);
@@ -1411,6 +1525,7 @@ void segment_pool::free_segment(segment* seg, segment_descriptor& desc) noexcept
     desc._region = nullptr;
     deallocate_segment(seg);
     --_segments_in_use;
+    on_segment_release(seg);
 }
 
 segment_pool::segment_pool(tracker::impl& tracker)
@@ -1418,6 +1533,7 @@ segment_pool::segment_pool(tracker::impl& tracker)
     , _segments(max_segments())
     , _lsa_owned_segments_bitmap(max_segments())
     , _lsa_free_segments_bitmap(max_segments())
+    , _huge_page_segments_in_use(_store.max_huge_pages())
 {
 }
 
@@ -1449,11 +1565,17 @@ void segment_pool::use_standard_allocator_segment_pool_backend(size_t available_
     _segments = std::vector<segment_descriptor>(max_segments());
     _lsa_owned_segments_bitmap = utils::dynamic_bitset(max_segments());
     _lsa_free_segments_bitmap = utils::dynamic_bitset(max_segments());
+    _huge_page_segments_in_use = std::vector<uint8_t>(_store.max_huge_pages());
 }
 
-inline void segment_pool::on_segment_compaction(size_t used_size) noexcept {
+inline void segment_pool::on_segment_compaction(size_t used_size, std::chrono::steady_clock::duration duration) noexcept {
     _stats.segments_compacted++;
     _stats.memory_compacted += used_size;
+    if (_tracker.in_background_compaction()) {
+        _stats.background_compaction_time += duration;
+    } else {
+        _stats.inline_compaction_time += duration;
+    }
 }
 
 inline void segment_pool::on_memory_allocation(size_t size) noexcept {
@@ -1908,6 +2030,7 @@ class region_impl final : public basic_region_impl {
     }
 
     void compact_segment_locked(segment* seg, segment_descriptor& desc) noexcept {
+        auto start = std::chrono::steady_clock::now();
         auto seg_occupancy = desc.occupancy();
         llogger.debug("Compacting segment {} from region {}, {}", fmt::ptr(seg), id(), seg_occupancy);
 
@@ -1939,7 +2062,7 @@ class region_impl final : public basic_region_impl {
         }
 
         free_segment(seg, desc);
-        segment_pool().on_segment_compaction(seg_occupancy.used_space());
+        segment_pool().on_segment_compaction(seg_occupancy.used_space(), std::chrono::steady_clock::now() - start);
     }
 
     void close_and_open() {
@@ -2563,6 +2686,11 @@ occupancy_stats tracker::impl::occupancy() const noexcept {
     return occ;
 }
 
+occupancy_stats tracker::impl::huge_page_occupancy() const noexcept {
+    auto total = _segment_pool->huge_pages_in_use() * huge_page_size;
+    return occupancy_stats(total - _segment_pool->segments_in_use() * segment::size, total);
+}
+
 size_t tracker::impl::non_lsa_used_space() const noexcept {
 #ifdef SEASTAR_DEFAULT_ALLOCATOR
     return 0;
@@ -2646,14 +2774,8 @@ static void reclaim_from_evictable(region::impl& r, size_t target_mem_in_use, is
     }
 }
 
-idle_cpu_handler_result tracker::impl::compact_on_idle(work_waiting_on_reactor check_for_work) {
-    if (_reclaiming_disabled_depth) {
-        return idle_cpu_handler_result::no_more_work;
-    }
-    reclaiming_lock rl(*this);
-    if (_regions.empty()) {
-        return idle_cpu_handler_result::no_more_work;
-    }
+template <typename StopFn>
+bool tracker::impl::compact_sparse_segments(StopFn stop) {
     segment_pool::reservation_goal open_emergency_pool(*_segment_pool, 0);
 
     auto cmp = [] (region::impl* c1, region::impl* c2) {
@@ -2665,19 +2787,58 @@ idle_cpu_handler_result tracker::impl::compact_on_idle(work_waiting_on_reactor c
 
     std::ranges::make_heap(_regions, cmp);
 
-    while (!check_for_work()) {
+    while (!stop()) {
         std::ranges::pop_heap(_regions, cmp);
         region::impl* r = _regions.back();
 
         if (!r->is_idle_compactible()) {
-            return idle_cpu_handler_result::no_more_work;
+            return false;
         }
 
         r->compact();
 
         std::ranges::push_heap(_regions, cmp);
     }
-    return idle_cpu_handler_result::interrupted_by_higher_priority_task;
+    return true;
+}
+
+idle_cpu_handler_result tracker::impl::compact_on_idle(work_waiting_on_reactor check_for_work) {
+    if (_reclaiming_disabled_depth) {
+        return idle_cpu_handler_result::no_more_work;
+    }
+    reclaiming_lock rl(*this);
+    if (_regions.empty()) {
+        return idle_cpu_handler_result::no_more_work;
+    }
+    background_compaction_guard bg(*this);
+    return compact_sparse_segments([&] { return check_for_work(); })
+            ? idle_cpu_handler_result::interrupted_by_higher_priority_task
+            : idle_cpu_handler_result::no_more_work;
+}
+
+// Driven by occupancy alone, so that sparse segments are compacted before
+// the memory they waste is needed.
+bool tracker::impl::background_compaction_needed() const noexcept {
+    if (_reclaiming_disabled_depth
+            || _segment_pool->unreserved_free_segments() >= background_compaction_free_segments_goal) {
+        return false;
+    }
+    auto occ = region_occupancy();
+    return occ.free_space() >= segment_size
+            && occ.used_space() < max_used_space_ratio_for_compaction * occ.total_space();
+}
+
+bool tracker::impl::compact_in_background() noexcept {
+    if (_reclaiming_disabled_depth || _regions.empty()) {
+        return false;
+    }
+    reclaiming_lock rl(*this);
+    background_compaction_guard bg(*this);
+    auto segments_compacted = _segment_pool->statistics().segments_compacted;
+    compact_sparse_segments([this] {
+        return need_preempt() || !background_compaction_needed();
+    });
+    return _segment_pool->statistics().segments_compacted != segments_compacted;
 }
 
 size_t tracker::impl::reclaim(size_t memory_to_release, is_preemptible preempt) {
@@ -2898,12 +3059,24 @@ tracker::impl::impl() : _segment_pool(std::make_unique<logalloc::segment_pool>(*
         sm::make_gauge("occupancy", [this] { return region_occupancy().used_fraction() * 100; },
                        sm::description("Holds a current portion (in percents) of the used memory.")),
 
+        sm::make_gauge("huge_pages_in_use", [this] { return _segment_pool->huge_pages_in_use(); },
+                       sm::description("Holds a current number of 2M pages holding at least one segment in use.")),
+
+        sm::make_gauge("huge_page_occupancy", [this] { return huge_page_occupancy().used_fraction() * 100; },
+                       sm::description("Holds a current portion (in percents) of the memory of 2M pages holding segments in use which is taken by those segments.")),
+
         sm::make_counter("segments_compacted", [this] { return _segment_pool->statistics().segments_compacted; },
                         sm::description("Counts a number of compacted segments.")),
 
         sm::make_counter("memory_compacted", [this] { return _segment_pool->statistics().memory_compacted; },
                         sm::description("Counts number of bytes which were copied as part of segment compaction.")),
 
+        sm::make_counter("inline_compaction_time_sec", [this] { return _segment_pool->statistics().inline_compaction_time.count(); },
+                        sm::description("Total time spent compacting segments on behalf of allocations.")),
+
+        sm::make_counter("background_compaction_time_sec", [this] { return _segment_pool->statistics().background_compaction_time.count(); },
+                        sm::description("Total time spent compacting segments in background reclaim and on idle.")),
+
         sm::make_counter("memory_allocated", [this] { return _segment_pool->statistics().memory_allocated; },
                         sm::description("Counts number of bytes which were requested from LSA.")),
 
@@ -75,6 +75,10 @@ class tracker {
         uint64_t memory_compacted;
         uint64_t memory_evicted;
         uint64_t num_allocations;
+        // Time spent compacting segments on behalf of allocating paths
+        // and by background reclaim or idle compaction, respectively.
+        std::chrono::duration<double> inline_compaction_time;
+        std::chrono::duration<double> background_compaction_time;
 
         friend stats operator+(const stats& s1, const stats& s2) {
             stats result(s1);
@@ -94,6 +98,8 @@ class tracker {
             memory_compacted += other.memory_compacted;
             memory_evicted += other.memory_evicted;
             num_allocations += other.num_allocations;
+            inline_compaction_time += other.inline_compaction_time;
+            background_compaction_time += other.background_compaction_time;
             return *this;
         }
         stats& operator-=(const stats& other) {
@@ -104,6 +110,8 @@ class tracker {
             memory_compacted -= other.memory_compacted;
             memory_evicted -= other.memory_evicted;
             num_allocations -= other.num_allocations;
+            inline_compaction_time -= other.inline_compaction_time;
+            background_compaction_time -= other.background_compaction_time;
             return *this;
         }
     };
@@ -141,6 +149,11 @@ class tracker {
 
     void reclaim_all_free_segments();
 
+    // Does what the background reclaimer does when region memory is sparse:
+    // compacts the sparsest segments until preempted or until there are
+    // enough free segments. Returns false if nothing was compacted.
+    bool compact_in_background();
+
     occupancy_stats global_occupancy() const noexcept;
 
     // Returns aggregate statistics for all pools.
@@ -152,6 +165,12 @@ class tracker {
     // Returns amount of allocated memory not managed by LSA
     size_t non_lsa_used_space() const noexcept;
 
+    // Returns statistics for the huge pages which back segments in use.
+    // Used space is the memory of segments in use, total space is the memory
+    // of huge pages holding them. Low occupancy means LSA data is spread
+    // over more TLB entries than necessary.
+    occupancy_stats huge_page_occupancy() const noexcept;
+
     impl& get_impl() noexcept { return *_impl; }
 
     // Returns the minimum number of segments reclaimed during single reclamation cycle.
@@ -9,15 +9,30 @@
 
 #include "multiprecision_int.hh"
 #include <iostream>
+#include <iterator>
 
 namespace utils {
 
 std::string multiprecision_int::str() const {
-    return _v.str();
+    if (_is_big) {
+        return _big.str();
+    }
+    // Work on the negated magnitude, so that the minimum value does not overflow.
+    char buf[41];
+    char* p = std::end(buf);
+    __int128 v = _small > 0 ? -_small : _small;
+    do {
+        *--p = '0' - char(v % 10);
+        v /= 10;
+    } while (v);
+    if (_small < 0) {
+        *--p = '-';
+    }
+    return std::string(p, std::end(buf));
 }
 
 std::ostream& operator<<(std::ostream& os, const multiprecision_int& x) {
-    return os << x._v;
+    return os << x.str();
 }
 
 }
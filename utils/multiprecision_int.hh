@@ -11,6 +11,8 @@
 #include <boost/multiprecision/cpp_int.hpp>
 #include <iosfwd>
 #include <compare>
+#include <limits>
+#include <type_traits>
 
 namespace utils {
 
@@ -21,195 +23,350 @@ namespace utils {
 //
 // Because cpp_int uses a lot of expression templates, the code below contains
 // many casts since the expression templates defeat regular C++ conversion rules.
+//
+// Nearly all values we see (varints, sums of integer columns, unscaled values
+// of decimals) fit in 128 bits. Such values are kept inline in an __int128
+// and operated on with overflow-checked native arithmetic; the value is
+// promoted to a cpp_int only when a result does not fit, and demoted back
+// when a cpp_int result fits again.
 
 class multiprecision_int final {
 public:
     using cpp_int = boost::multiprecision::cpp_int;
 private:
-    cpp_int _v;
+    __int128 _small = 0;
+    bool _is_big = false;
+    cpp_int _big;
 private:
+    struct small_tag {};
+    multiprecision_int(small_tag, __int128 x) : _small(x) {}
+
+    template <typename T>
+    static constexpr bool is_native_integer = std::is_same_v<T, __int128>
+            || (std::is_integral_v<T> && sizeof(T) <= sizeof(int64_t));
+
+    // Extracts the value of x into out if it has a native representation.
+    template <typename T>
+    static bool get_small(const T& x, __int128& out) {
+        if constexpr (std::is_same_v<T, multiprecision_int>) {
+            out = x._small;
+            return !x._is_big;
+        } else if constexpr (is_native_integer<T>) {
+            out = x;
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    cpp_int big() const {
+        return _is_big ? _big : cpp_int(_small);
+    }
+
     // maybe_unwrap() selectively unwraps multiprecision_int values (leaving
     // anything else unchanged), so avoid confusing boost::multiprecision.
-    static const cpp_int& maybe_unwrap(const multiprecision_int& x) {
-        return x._v;
+    static cpp_int maybe_unwrap(const multiprecision_int& x) {
+        return x.big();
     }
     template <typename T>
     static const T& maybe_unwrap(const T& x) {
         return x;
     }
+
+    // Evaluates a binary operation natively if both operands fit in 128 bits
+    // and native_op() reports no overflow, and with cpp_int otherwise.
+    template <typename A, typename B, typename NativeOp, typename BigOp>
+    static multiprecision_int apply(const A& a, const B& b, NativeOp native_op, BigOp big_op) {
+        __int128 x, y, r;
+        if (get_small(a, x) && get_small(b, y) && native_op(x, y, r)) {
+            return multiprecision_int(small_tag{}, r);
+        }
+        return cpp_int(big_op(maybe_unwrap(a), maybe_unwrap(b)));
+    }
+
+    static bool native_add(__int128 x, __int128 y, __int128& r) {
+        return !__builtin_add_overflow(x, y, &r);
+    }
+    static bool native_sub(__int128 x, __int128 y, __int128& r) {
+        return !__builtin_sub_overflow(x, y, &r);
+    }
+    // __builtin_mul_overflow() on __int128 needs compiler-rt with clang, so
+    // the overflow check is done by hand.
+    static bool native_mul(__int128 x, __int128 y, __int128& r) {
+        if (x == int64_t(x) && y == int64_t(y)) {
+            r = x * y;
+            return true;
+        }
+        using u128 = unsigned __int128;
+        const u128 ux = x < 0 ? -u128(x) : u128(x);
+        const u128 uy = y < 0 ? -u128(y) : u128(y);
+        const bool negative = (x < 0) != (y < 0);
+        const u128 limit = (u128(1) << 127) - !negative;
+        if (ux != 0 && uy > limit / ux) {
+            return false;
+        }
+        const u128 p = ux * uy;
+        r = negative ? __int128(-p) : __int128(p);
+        return true;
+    }
+    // Division by zero is left to cpp_int, which throws.
+    static bool native_div(__int128 x, __int128 y, __int128& r) {
+        if (y == 0 || (y == -1 && x == std::numeric_limits<__int128>::min())) {
+            return false;
+        }
+        r = x / y;
+        return true;
+    }
+    static bool native_mod(__int128 x, __int128 y, __int128& r) {
+        if (y == 0 || y == -1) {
+            return false;
+        }
+        r = x % y;
+        return true;
+    }
+    static bool native_shl(__int128 x, __int128 y, __int128& r) {
+        return y >= 0 && y < 127 && native_mul(x, __int128(1) << y, r);
+    }
+    // cpp_int shifts negative values arithmetically (rounding towards
+    // negative infinity), like the native shift does.
+    static bool native_shr(__int128 x, __int128 y, __int128& r) {
+        if (y < 0) {
+            return false;
+        }
+        r = x >> (y < 127 ? int(y) : 127);
+        return true;
+    }
+
+    template <typename T>
+    T convert_to() const {
+        if constexpr (std::is_integral_v<T>) {
+            if (!_is_big && _small >= std::numeric_limits<T>::min() && _small <= std::numeric_limits<T>::max()) {
+                return static_cast<T>(_small);
+            }
+        }
+        return static_cast<T>(big());
+    }
 public:
     multiprecision_int() = default;
-    multiprecision_int(cpp_int x) : _v(std::move(x)) {}
-    explicit multiprecision_int(int x) : _v(x) {}
-    explicit multiprecision_int(unsigned x) : _v(x) {}
-    explicit multiprecision_int(long x) : _v(x) {}
-    explicit multiprecision_int(unsigned long x) : _v(x) {}
-    explicit multiprecision_int(long long x) : _v(x) {}
-    explicit multiprecision_int(unsigned long long x) : _v(x) {}
-    explicit multiprecision_int(float x) : _v(x) {}
-    explicit multiprecision_int(double x) : _v(x) {}
-    explicit multiprecision_int(long double x) : _v(x) {}
-    explicit multiprecision_int(const std::string x) : _v(x) {}
-    explicit multiprecision_int(const char* x) : _v(x) {}
-    operator const cpp_int&() const {
-        return _v;
+    multiprecision_int(cpp_int x) {
+        static const cpp_int min_small = std::numeric_limits<__int128>::min();
+        static const cpp_int max_small = std::numeric_limits<__int128>::max();
+        if (x >= min_small && x <= max_small) {
+            _small = x.convert_to<__int128>();
+        } else {
+            _is_big = true;
+            _big = std::move(x);
+        }
+    }
+    explicit multiprecision_int(int x) : _small(x) {}
+    explicit multiprecision_int(unsigned x) : _small(x) {}
+    explicit multiprecision_int(long x) : _small(x) {}
+    explicit multiprecision_int(unsigned long x) : _small(x) {}
+    explicit multiprecision_int(long long x) : _small(x) {}
+    explicit multiprecision_int(unsigned long long x) : _small(x) {}
+    explicit multiprecision_int(float x) : multiprecision_int(cpp_int(x)) {}
+    explicit multiprecision_int(double x) : multiprecision_int(cpp_int(x)) {}
+    explicit multiprecision_int(long double x) : multiprecision_int(cpp_int(x)) {}
+    explicit multiprecision_int(const std::string x) : multiprecision_int(cpp_int(x)) {}
+    explicit multiprecision_int(const char* x) : multiprecision_int(cpp_int(x)) {}
+    static multiprecision_int from_int128(__int128 x) {
+        return multiprecision_int(small_tag{}, x);
+    }
+    // True if the value is held inline, i.e. it fits in an __int128.
+    bool is_small() const noexcept {
+        return !_is_big;
+    }
+    // The inline value; only meaningful if is_small().
+    __int128 small_value() const noexcept {
+        return _small;
+    }
+    operator cpp_int() const {
+        return big();
     }
     explicit operator signed char() const {
-        return static_cast<signed char>(_v);
+        return convert_to<signed char>();
     }
     explicit operator unsigned char() const {
-        return static_cast<unsigned char>(_v);
+        return convert_to<unsigned char>();
     }
     explicit operator short() const {
-        return static_cast<short>(_v);
+        return convert_to<short>();
     }
     explicit operator unsigned short() const {
-        return static_cast<unsigned short>(_v);
+        return convert_to<unsigned short>();
     }
     explicit operator int() const {
-        return static_cast<int>(_v);
+        return convert_to<int>();
     }
     explicit operator unsigned() const {
-        return static_cast<unsigned>(_v);
+        return convert_to<unsigned>();
     }
     explicit operator long() const {
-        return static_cast<long>(_v);
+        return convert_to<long>();
     }
     explicit operator unsigned long() const {
-        return static_cast<unsigned long>(_v);
+        return convert_to<unsigned long>();
     }
     explicit operator long long() const {
-        return static_cast<long long>(_v);
+        return convert_to<long long>();
     }
     explicit operator unsigned long long() const {
-        return static_cast<unsigned long long>(_v);
+        return convert_to<unsigned long long>();
     }
     explicit operator float() const {
-        return static_cast<float>(_v);
+        return convert_to<float>();
     }
     explicit operator double() const {
-        return static_cast<double>(_v);
+        return convert_to<double>();
     }
     explicit operator long double() const {
-        return static_cast<long double>(_v);
+        return convert_to<long double>();
     }
     template <typename T>
     multiprecision_int& operator+=(const T& x) {
-        _v += maybe_unwrap(x);
-        return *this;
+        return *this = *this + x;
     }
     template <typename T>
     multiprecision_int& operator-=(const T& x) {
-        _v -= maybe_unwrap(x);
-        return *this;
+        return *this = *this - x;
     }
     template <typename T>
     multiprecision_int& operator*=(const T& x) {
-        _v *= maybe_unwrap(x);
-        return *this;
+        return *this = *this * x;
     }
     template <typename T>
     multiprecision_int& operator/=(const T& x) {
-        _v /= maybe_unwrap(x);
-        return *this;
+        return *this = *this / x;
     }
     template <typename T>
     multiprecision_int& operator%=(const T& x) {
-        _v %= maybe_unwrap(x);
-        return *this;
+        return *this = *this % x;
     }
     template <typename T>
     multiprecision_int& operator<<=(const T& x) {
-        _v <<= maybe_unwrap(x);
-        return *this;
+        return *this = *this << x;
     }
     template <typename T>
     multiprecision_int& operator>>=(const T& x) {
-        _v >>= maybe_unwrap(x);
-        return *this;
+        return *this = *this >> x;
     }
     multiprecision_int operator-() const {
-        return cpp_int(-_v);
+        __int128 r;
+        if (!_is_big && native_sub(0, _small, r)) {
+            return multiprecision_int(small_tag{}, r);
+        }
+        return cpp_int(-big());
     }
     multiprecision_int operator+(const multiprecision_int& x) const {
-        return cpp_int(_v + x._v);
+        return apply(*this, x, native_add, [] (const auto& a, const auto& b) { return a + b; });
     }
     template <typename T>
     multiprecision_int operator+(const T& x) const {
-        return cpp_int(_v + maybe_unwrap(x));
+        return apply(*this, x, native_add, [] (const auto& a, const auto& b) { return a + b; });
+    }
+    multiprecision_int operator-(const multiprecision_int& x) const {
+        return apply(*this, x, native_sub, [] (const auto& a, const auto& b) { return a - b; });
     }
     template <typename T>
     multiprecision_int operator-(const T& x) const {
-        return cpp_int(_v - maybe_unwrap(x));
+        return apply(*this, x, native_sub, [] (const auto& a, const auto& b) { return a - b; });
+    }
+    multiprecision_int operator*(const multiprecision_int& x) const {
+        return apply(*this, x, native_mul, [] (const auto& a, const auto& b) { return a * b; });
     }
     template <typename T>
     multiprecision_int operator*(const T& x) const {
-        return cpp_int(_v * maybe_unwrap(x));
+        return apply(*this, x, native_mul, [] (const auto& a, const auto& b) { return a * b; });
     }
     template <typename T>
     multiprecision_int operator/(const T& x) const {
-        return cpp_int(_v / maybe_unwrap(x));
+        return apply(*this, x, native_div, [] (const auto& a, const auto& b) { return a / b; });
     }
     template <typename T>
     multiprecision_int operator%(const T& x) const {
-        return cpp_int(_v % maybe_unwrap(x));
+        return apply(*this, x, native_mod, [] (const auto& a, const auto& b) { return a % b; });
     }
     template <typename T>
     multiprecision_int operator<<(const T& x) const {
-        return cpp_int(_v << maybe_unwrap(x));
+        return apply(*this, x, native_shl, [] (const auto& a, const auto& b) { return a << b; });
     }
     template <typename T>
     multiprecision_int operator>>(const T& x) const {
-        return cpp_int(_v >> maybe_unwrap(x));
+        return apply(*this, x, native_shr, [] (const auto& a, const auto& b) { return a >> b; });
+    }
+    std::strong_ordering operator<=>(const multiprecision_int& x) const {
+        if (!_is_big && !x._is_big) {
+            return _small <=> x._small;
+        }
+        return big().compare(x.big()) <=> 0;
     }
-    std::strong_ordering operator<=>(const multiprecision_int& x) const = default;
     template <typename T>
     bool operator==(const T& x) const {
-        return _v == maybe_unwrap(x);
+        __int128 y;
+        if (!_is_big && get_small(x, y)) {
+            return _small == y;
+        }
+        return big() == maybe_unwrap(x);
     }
     template <typename T>
     bool operator>(const T& x) const {
-        return _v > maybe_unwrap(x);
+        __int128 y;
+        if (!_is_big && get_small(x, y)) {
+            return _small > y;
+        }
+        return big() > maybe_unwrap(x);
     }
     template <typename T>
     bool operator>=(const T& x) const {
-        return _v >= maybe_unwrap(x);
+        __int128 y;
+        if (!_is_big && get_small(x, y)) {
+            return _small >= y;
+        }
+        return big() >= maybe_unwrap(x);
     }
     template <typename T>
     bool operator<(const T& x) const {
-        return _v < maybe_unwrap(x);
+        __int128 y;
+        if (!_is_big && get_small(x, y)) {
+            return _small < y;
+        }
+        return big() < maybe_unwrap(x);
     }
     template <typename T>
     bool operator<=(const T& x) const {
-        return _v <= maybe_unwrap(x);
+        __int128 y;
+        if (!_is_big && get_small(x, y)) {
+            return _small <= y;
+        }
+        return big() <= maybe_unwrap(x);
     }
     template <typename T>
     friend multiprecision_int operator+(const T& x, const multiprecision_int& y) {
-        return cpp_int(maybe_unwrap(x) + y._v);
+        return apply(x, y, native_add, [] (const auto& a, const auto& b) { return a + b; });
     }
     template <typename T>
     friend multiprecision_int operator-(const T& x, const multiprecision_int& y) {
-        return cpp_int(maybe_unwrap(x) - y._v);
+        return apply(x, y, native_sub, [] (const auto& a, const auto& b) { return a - b; });
     }
     template <typename T>
     friend multiprecision_int operator*(const T& x, const multiprecision_int& y) {
-        return cpp_int(maybe_unwrap(x) * y._v);
+        return apply(x, y, native_mul, [] (const auto& a, const auto& b) { return a * b; });
     }
     template <typename T>
     friend multiprecision_int operator/(const T& x, const multiprecision_int& y) {
-        return cpp_int(maybe_unwrap(x) / y._v);
+        return apply(x, y, native_div, [] (const auto& a, const auto& b) { return a / b; });
     }
     template <typename T>
     friend multiprecision_int operator%(const T& x, const multiprecision_int& y) {
-        return cpp_int(maybe_unwrap(x) % y._v);
+        return apply(x, y, native_mod, [] (const auto& a, const auto& b) { return a % b; });
     }
     template <typename T>
     friend multiprecision_int operator<<(const T& x, const multiprecision_int& y) {
-        return cpp_int(maybe_unwrap(x) << y._v);
+        return apply(x, y, native_shl, [] (const auto& a, const auto& b) { return a << b; });
     }
     template <typename T>
     friend multiprecision_int operator>>(const T& x, const multiprecision_int& y) {
-        return cpp_int(maybe_unwrap(x) >> y._v);
+        return apply(x, y, native_shr, [] (const auto& a, const auto& b) { return a >> b; });
     }
     std::string str() const;
     friend std::ostream& operator<<(std::ostream& os, const multiprecision_int& x);
@@ -217,4 +374,3 @@ class multiprecision_int final {
 
 
 }
-
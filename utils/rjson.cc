@@ -279,6 +279,44 @@ future<> print(const rjson::value& value, seastar::output_stream<char>& os, size
   });
 }
 
+void chunked_content_writer::next_chunk() {
+    if (_pos) {
+        _buf.trim(_pos);
+        _content.push_back(std::move(_buf));
+        _flushed_size += _pos;
+        _pos = 0;
+    }
+    _buf = temporary_buffer<char>(chunk_size);
+}
+
+void chunked_content_writer::write(const rjson::value& value, size_t max_nested_level) {
+    using streamer = rapidjson::Writer<chunked_content_writer, encoding, encoding, allocator>;
+    guarded_yieldable_json_handler<streamer, false, chunked_content_writer> writer(*this, max_nested_level);
+    value.Accept(writer);
+}
+
+void chunked_content_writer::write_raw(std::string_view str) {
+    while (!str.empty()) {
+        if (_pos == _buf.size()) {
+            next_chunk();
+        }
+        size_t n = std::min(str.size(), _buf.size() - _pos);
+        std::copy_n(str.data(), n, _buf.get_write() + _pos);
+        _pos += n;
+        str.remove_prefix(n);
+    }
+}
+
+chunked_content chunked_content_writer::finish() && {
+    if (_pos) {
+        _buf.trim(_pos);
+        _content.push_back(std::move(_buf));
+        _flushed_size += _pos;
+        _pos = 0;
+    }
+    return std::move(_content);
+}
+
 rjson::malformed_value::malformed_value(std::string_view name, const rjson::value& value)
     : malformed_value(name, print(value))
 {}
@@ -215,6 +215,45 @@ using chunked_content = std::vector<temporary_buffer<char>>;
 rjson::value parse(chunked_content&&, size_t max_nested_level = default_max_nested_level);
 rjson::value parse_yieldable(chunked_content&&, size_t max_nested_level = default_max_nested_level);
 
+// chunked_content_writer builds JSON text in a chunked_content made of
+// fixed-size chunks, so a large JSON document can be produced piece by piece
+// without ever allocating one large contiguous buffer. It implements the
+// rapidjson output stream concept (Put() and Flush()), so it can also be
+// used directly as the output of a rapidjson::Writer.
+class chunked_content_writer {
+    static constexpr size_t chunk_size = 16 * 1024;
+    chunked_content _content;
+    temporary_buffer<char> _buf;
+    size_t _pos = 0;
+    size_t _flushed_size = 0;
+
+    void next_chunk();
+public:
+    using Ch = char; // Used by rjson internally
+
+    void Put(Ch c) {
+        if (_pos == _buf.size()) {
+            next_chunk();
+        }
+        _buf.get_write()[_pos++] = c;
+    }
+    // rapidjson::Writer flushes after every complete top-level value, but
+    // we want to keep filling the current chunk with the next value.
+    void Flush() {}
+
+    // Appends the JSON text of the given value.
+    void write(const rjson::value& value, size_t max_nested_level = default_max_nested_level);
+    // Appends the given text as-is. It is the caller's responsibility that
+    // the concatenation of everything written is valid JSON.
+    void write_raw(std::string_view str);
+
+    size_t size() const {
+        return _flushed_size + _pos;
+    }
+    // Returns the written text. The writer must not be used afterwards.
+    chunked_content finish() &&;
+};
+
 // Creates a JSON value (of JSON string type) out of internal string representations.
 // The string value is copied, so str's liveness does not need to be persisted.
 rjson::value from_string(const char* str, size_t size);